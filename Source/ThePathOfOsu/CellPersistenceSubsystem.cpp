@@ -0,0 +1,92 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "CellPersistenceSubsystem.h"
+
+#include "OsuWorldSnapshot.h"
+#include "Engine/Level.h"
+
+namespace
+{
+	uint32 GetStateCrc(const TArray<uint8>& State)
+	{
+		return FCrc::MemCrc32(State.GetData(), State.Num());
+	}
+}
+
+void UCellPersistenceSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddUObject(this, &UCellPersistenceSubsystem::OnLevelAdded);
+	// Before the actors of the cell end play, their state is still intact
+	LevelRemovedHandle = FWorldDelegates::PreLevelRemovedFromWorld.AddUObject(
+		this, &UCellPersistenceSubsystem::OnLevelRemoved);
+}
+
+void UCellPersistenceSubsystem::Deinitialize()
+{
+	FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+	FWorldDelegates::PreLevelRemovedFromWorld.Remove(LevelRemovedHandle);
+	StoredStates.Empty();
+	DefaultStateCrcs.Empty();
+	Super::Deinitialize();
+}
+
+const TMap<FString, FCellObjectState>& UCellPersistenceSubsystem::GetStoredStates() const
+{
+	return StoredStates;
+}
+
+void UCellPersistenceSubsystem::ResetStoredStates(TMap<FString, FCellObjectState>&& NewStoredStates)
+{
+	StoredStates = MoveTemp(NewStoredStates);
+}
+
+bool UCellPersistenceSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UCellPersistenceSubsystem::OnLevelAdded(ULevel* Level, UWorld* World)
+{
+	if (World != GetWorld() || !Level || Level->IsPersistentLevel())
+	{
+		return;
+	}
+
+	FOsuWorldSnapshot::ForEachSaveableInLevel(Level, [this](UObject* Object)
+	{
+		FString Key = FOsuWorldSnapshot::GetObjectKey(Object);
+		TArray<uint8> DefaultState;
+		FOsuWorldSnapshot::CaptureObject(Object, DefaultState);
+		if (const FCellObjectState* StoredState = StoredStates.Find(Key))
+		{
+			FOsuWorldSnapshot::RestoreObject(Object, StoredState->State, StoredState->Version);
+		}
+		DefaultStateCrcs.Add(MoveTemp(Key), GetStateCrc(DefaultState));
+	});
+}
+
+void UCellPersistenceSubsystem::OnLevelRemoved(ULevel* Level, UWorld* World)
+{
+	if (World != GetWorld() || !Level || Level->IsPersistentLevel())
+	{
+		return;
+	}
+
+	FOsuWorldSnapshot::ForEachSaveableInLevel(Level, [this](UObject* Object)
+	{
+		FString Key = FOsuWorldSnapshot::GetObjectKey(Object);
+		TArray<uint8> State;
+		FOsuWorldSnapshot::CaptureObject(Object, State);
+
+		uint32 DefaultStateCrc = 0;
+		const bool HasDefaultState = DefaultStateCrcs.RemoveAndCopyValue(Key, DefaultStateCrc);
+		if (HasDefaultState && DefaultStateCrc == GetStateCrc(State))
+		{
+			StoredStates.Remove(Key);
+			return;
+		}
+		StoredStates.Add(MoveTemp(Key), {MoveTemp(State), FOsuSaveVersion::LatestVersion});
+	});
+}
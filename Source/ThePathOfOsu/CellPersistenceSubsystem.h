@@ -0,0 +1,55 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CellPersistenceSubsystem.generated.h"
+
+struct FCellObjectState
+{
+	TArray<uint8> State;
+	// FOsuSaveVersion State was written with
+	int32 Version;
+
+	friend FArchive& operator<<(FArchive& Ar, FCellObjectState& ObjectState)
+	{
+		Ar << ObjectState.State;
+		Ar << ObjectState.Version;
+		return Ar;
+	}
+};
+
+/**
+ * Keeps ISaveableInterface state of World Partition cells across streaming. When a cell streams out, objects whose
+ * state differs from the one they streamed in with are stored by object path, and the stored state is applied again
+ * when the cell streams back in. Untouched objects cost a CRC while their cell is loaded and nothing once it is not.
+ */
+UCLASS()
+class THEPATHOFOSU_API UCellPersistenceSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	const TMap<FString, FCellObjectState>& GetStoredStates() const;
+	// Used by snapshots restoring a checkpoint or a save game
+	void ResetStoredStates(TMap<FString, FCellObjectState>&& NewStoredStates);
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	void OnLevelAdded(ULevel* Level, UWorld* World);
+	void OnLevelRemoved(ULevel* Level, UWorld* World);
+
+	TMap<FString, FCellObjectState> StoredStates;
+
+	// CRC of each loaded cell object's state right after it streamed in with its default state
+	TMap<FString, uint32> DefaultStateCrcs;
+
+	FDelegateHandle LevelAddedHandle;
+	FDelegateHandle LevelRemovedHandle;
+};
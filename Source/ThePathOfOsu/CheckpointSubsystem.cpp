@@ -0,0 +1,51 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "CheckpointSubsystem.h"
+
+void UCheckpointSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+	// Actors set up their starting state in BeginPlay, which runs after this
+	InWorld.GetTimerManager().SetTimerForNextTick(FTimerDelegate::CreateWeakLambda(this, [this]()
+	{
+		if (!IsCheckpointSaved)
+		{
+			SaveCheckpoint();
+		}
+	}));
+}
+
+void UCheckpointSubsystem::SaveCheckpoint()
+{
+	const double StartTime = FPlatformTime::Seconds();
+	CheckpointSnapshot.Capture(GetWorld());
+	IsCheckpointSaved = true;
+	UE_LOG(LogTemp, Log, TEXT("Checkpoint saved, %d objects in %.2f ms"), CheckpointSnapshot.ObjectStates.Num(),
+	       (FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
+
+bool UCheckpointSubsystem::RestoreCheckpoint()
+{
+	if (!IsCheckpointSaved)
+	{
+		UE_LOG(LogTemp, Error, TEXT("RestoreCheckpoint: no checkpoint saved"));
+		return false;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	CheckpointSnapshot.Restore(GetWorld());
+	OnCheckpointRestored.Broadcast();
+	UE_LOG(LogTemp, Log, TEXT("Checkpoint restored in %.2f ms"), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+	return true;
+}
+
+bool UCheckpointSubsystem::HasCheckpoint() const
+{
+	return IsCheckpointSaved;
+}
+
+bool UCheckpointSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
@@ -0,0 +1,42 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OsuWorldSnapshot.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CheckpointSubsystem.generated.h"
+
+DECLARE_MULTICAST_DELEGATE(FOnCheckpointRestored);
+
+/**
+ * Keeps the last checkpoint of the level as an in-memory world snapshot, so a retry puts every saveable actor
+ * back in place instead of reloading the map. The level start counts as the first checkpoint.
+ */
+UCLASS()
+class THEPATHOFOSU_API UCheckpointSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	UFUNCTION(BlueprintCallable, Category = "Checkpoint")
+	void SaveCheckpoint();
+
+	UFUNCTION(BlueprintCallable, Category = "Checkpoint")
+	bool RestoreCheckpoint();
+
+	UFUNCTION(BlueprintPure, Category = "Checkpoint")
+	bool HasCheckpoint() const;
+
+	// For listeners that cache level state outside the snapshot, like the enemy marker layer
+	FOnCheckpointRestored OnCheckpointRestored;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	FOsuWorldSnapshot CheckpointSnapshot;
+	bool IsCheckpointSaved = false;
+};
@@ -0,0 +1,45 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "CheckpointVolume.h"
+
+#include "CheckpointSubsystem.h"
+#include "PlayerCharacter.h"
+
+
+ACheckpointVolume::ACheckpointVolume()
+{
+	PrimaryActorTick.bCanEverTick = false;
+
+	TriggerBox = CreateDefaultSubobject<UBoxComponent>(TEXT("TriggerBox"));
+	SetRootComponent(TriggerBox);
+	TriggerBox->SetCollisionProfileName(FName("OverlapAllDynamic"));
+	TriggerBox->SetBoxExtent(FVector(200.0f, 200.0f, 150.0f));
+}
+
+void ACheckpointVolume::BeginPlay()
+{
+	Super::BeginPlay();
+	TriggerBox->OnComponentBeginOverlap.AddDynamic(this, &ACheckpointVolume::OnOverlapBegin);
+}
+
+void ACheckpointVolume::OnOverlapBegin(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor,
+                                       UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep,
+                                       const FHitResult& SweepResult)
+{
+	APlayerCharacter* PlayerCharacter = Cast<APlayerCharacter>(OtherActor);
+	if (IsReached || !PlayerCharacter || PlayerCharacter->IsDead())
+	{
+		return;
+	}
+
+	UCheckpointSubsystem* CheckpointSubsystem = GetWorld()->GetSubsystem<UCheckpointSubsystem>();
+	if (!CheckpointSubsystem)
+	{
+		UE_LOG(LogTemp, Error, TEXT("CheckpointSubsystem is null! %s"), *GetName());
+		return;
+	}
+	IsReached = true;
+	CheckpointSubsystem->SaveCheckpoint();
+	OnReached.Broadcast();
+}
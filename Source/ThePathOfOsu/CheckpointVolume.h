@@ -0,0 +1,37 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/BoxComponent.h"
+#include "GameFramework/Actor.h"
+#include "CheckpointVolume.generated.h"
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnCheckpointReached);
+
+// Saves a checkpoint the first time the player walks in
+UCLASS()
+class THEPATHOFOSU_API ACheckpointVolume : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	ACheckpointVolume();
+
+protected:
+	virtual void BeginPlay() override;
+
+	UFUNCTION()
+	void OnOverlapBegin(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp,
+	                    int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
+
+public:
+	UPROPERTY(BlueprintReadWrite, VisibleAnywhere)
+	UBoxComponent* TriggerBox;
+
+	UPROPERTY(BlueprintReadOnly, VisibleAnywhere)
+	bool IsReached = false;
+
+	UPROPERTY(BlueprintAssignable)
+	FOnCheckpointReached OnReached;
+};
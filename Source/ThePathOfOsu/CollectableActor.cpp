@@ -1,10 +1,14 @@
 ﻿#include "CollectableActor.h"
+#include "CollectableFieldSubsystem.h"
+#include "OsuEventBusSubsystem.h"
 #include "PlayerCharacter.h"
+#include "Kismet/GameplayStatics.h"
 
 
 ACollectableActor::ACollectableActor()
 {
 	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = false;
 
 	RootComp = CreateDefaultSubobject<USceneComponent>(TEXT("RootComp"));
 	SetRootComponent(RootComp);
@@ -28,6 +32,31 @@ ACollectableActor::ACollectableActor()
 void ACollectableActor::BeginPlay()
 {
 	Super::BeginPlay();
+	Capsule->OnComponentBeginOverlap.AddDynamic(this, &ACollectableActor::OnCapsuleBeginOverlap);
+
+	UCollectableFieldSubsystem* CollectableField = GetWorld()->GetSubsystem<UCollectableFieldSubsystem>();
+	IsInstanced = UsesInstancedMesh && CollectableField && CollectableField->AddCollectable(this);
+	if (IsInstanced)
+	{
+		Mesh->SetVisibility(false);
+		Mesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	}
+	else
+	{
+		SetActorTickEnabled(!IsCollected);
+	}
+}
+
+void ACollectableActor::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (IsInstanced)
+	{
+		if (UCollectableFieldSubsystem* CollectableField = GetWorld()->GetSubsystem<UCollectableFieldSubsystem>())
+		{
+			CollectableField->RemoveCollectable(this);
+		}
+	}
+	Super::EndPlay(EndPlayReason);
 }
 
 void ACollectableActor::Tick(float DeltaTime)
@@ -35,14 +64,15 @@ void ACollectableActor::Tick(float DeltaTime)
 	Super::Tick(DeltaTime);
 
 	Mesh->AddRelativeRotation(FRotator(0.0f, RotationSpeed * DeltaTime, 0.0f));
-	TArray<AActor*> OverlappingActors;
-	Capsule->GetOverlappingActors(OverlappingActors, APlayerCharacter::StaticClass());
-	if (!OverlappingActors.IsEmpty())
+}
+
+void ACollectableActor::OnCapsuleBeginOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor,
+                                              UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep,
+                                              const FHitResult& SweepResult)
+{
+	if (!IsCollected && Cast<APlayerCharacter>(OtherActor))
 	{
-		if (!IsCollected)
-		{
-			Collect();
-		}
+		Collect();
 	}
 }
 
@@ -50,6 +80,32 @@ void ACollectableActor::Collect()
 {
 	IsCollected = true;
 	OnCollected.Broadcast();
+	UOsuEventBusSubsystem::Publish(this, FObjectiveProgressEvent{this, EObjectiveEvent::CollectableCollected});
 	CollectAudio->Play();
-	Mesh->SetVisibility(false);
+	SetMeshVisible(false);
+}
+
+void ACollectableActor::SetMeshVisible(bool IsVisible)
+{
+	if (IsInstanced)
+	{
+		GetWorld()->GetSubsystem<UCollectableFieldSubsystem>()->SetCollectableVisible(this, IsVisible);
+		return;
+	}
+	Mesh->SetVisibility(IsVisible);
+	SetActorTickEnabled(IsVisible);
+}
+
+void ACollectableActor::SerializeState(FArchive& Ar)
+{
+	Ar << IsCollected;
+	if (Ar.IsLoading())
+	{
+		SetMeshVisible(!IsCollected);
+		// Collected again if the player stands on it, the overlap already began and would not fire
+		if (!IsCollected && Capsule->IsOverlappingActor(UGameplayStatics::GetPlayerCharacter(GetWorld(), 0)))
+		{
+			Collect();
+		}
+	}
 }
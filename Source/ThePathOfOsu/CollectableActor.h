@@ -7,12 +7,13 @@
 #include "Components/AudioComponent.h"
 #include "Components/CapsuleComponent.h"
 #include "GameFramework/Actor.h"
+#include "Interface/SaveableInterface.h"
 #include "CollectableActor.generated.h"
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnCollectableActorCollected);
 
 UCLASS()
-class THEPATHOFOSU_API ACollectableActor : public AActor
+class THEPATHOFOSU_API ACollectableActor : public AActor, public ISaveableInterface
 {
 	GENERATED_BODY()
 
@@ -21,8 +22,10 @@ public:
 
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 public:
+	// Only runs the spin of a collectable that draws its own mesh
 	virtual void Tick(float DeltaTime) override;
 
 	UPROPERTY(BlueprintReadWrite, VisibleAnywhere)
@@ -42,6 +45,10 @@ public:
 	UPROPERTY(BlueprintReadWrite, EditAnywhere)
 	float RotationSpeed;
 
+	// Drawn by UCollectableFieldSubsystem, only turn on with a material that applies the spin from instance custom data
+	UPROPERTY(EditAnywhere)
+	bool UsesInstancedMesh = false;
+
 
 	UPROPERTY(BlueprintReadWrite, VisibleAnywhere)
 	UAudioComponent* CollectAudio;
@@ -51,4 +58,16 @@ public:
 
 	UFUNCTION(BlueprintCallable)
 	void Collect();
+
+	virtual void SerializeState(FArchive& Ar) override;
+
+private:
+	UFUNCTION()
+	void OnCapsuleBeginOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor,
+	                           UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep,
+	                           const FHitResult& SweepResult);
+
+	bool IsInstanced = false;
+
+	void SetMeshVisible(bool IsVisible);
 };
@@ -0,0 +1,107 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "CollectableFieldSubsystem.h"
+
+#include "CollectableActor.h"
+#include "Components/InstancedStaticMeshComponent.h"
+
+bool UCollectableFieldSubsystem::AddCollectable(ACollectableActor* Collectable)
+{
+	if (!Collectable->Mesh->GetStaticMesh())
+	{
+		return false;
+	}
+	UInstancedStaticMeshComponent* Component = FindOrAddComponent(Collectable->Mesh);
+
+	FFieldInstance FieldInstance;
+	FieldInstance.Component = Component;
+	FieldInstance.Transform = Collectable->Mesh->GetComponentTransform();
+	TArray<int32>& FreeSlots = FreeInstances.FindOrAdd(Component);
+	if (FreeSlots.IsEmpty())
+	{
+		FieldInstance.InstanceIndex = Component->AddInstance(FieldInstance.Transform, true);
+	}
+	else
+	{
+		FieldInstance.InstanceIndex = FreeSlots.Pop();
+		Component->UpdateInstanceTransform(FieldInstance.InstanceIndex, FieldInstance.Transform, true, true, true);
+	}
+	Component->SetCustomDataValue(FieldInstance.InstanceIndex, 0, Collectable->RotationSpeed, true);
+	Instances.Add(Collectable, FieldInstance);
+
+	SetCollectableVisible(Collectable, !Collectable->IsCollected);
+	return true;
+}
+
+void UCollectableFieldSubsystem::RemoveCollectable(const ACollectableActor* Collectable)
+{
+	SetCollectableVisible(Collectable, false);
+	FFieldInstance FieldInstance;
+	if (Instances.RemoveAndCopyValue(Collectable, FieldInstance))
+	{
+		FreeInstances.FindOrAdd(FieldInstance.Component).Add(FieldInstance.InstanceIndex);
+	}
+}
+
+void UCollectableFieldSubsystem::SetCollectableVisible(const ACollectableActor* Collectable, bool IsVisible)
+{
+	const FFieldInstance* FieldInstance = Instances.Find(Collectable);
+	if (!FieldInstance)
+	{
+		return;
+	}
+	FTransform InstanceTransform = FieldInstance->Transform;
+	if (!IsVisible)
+	{
+		// Zero scale culls the instance without moving the others around in the buffer
+		InstanceTransform.SetScale3D(FVector::ZeroVector);
+	}
+	FieldInstance->Component->UpdateInstanceTransform(FieldInstance->InstanceIndex, InstanceTransform, true, true,
+	                                                  true);
+}
+
+bool UCollectableFieldSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+UInstancedStaticMeshComponent* UCollectableFieldSubsystem::FindOrAddComponent(const UStaticMeshComponent* Source)
+{
+	FComponentKey Key;
+	Key.StaticMesh = Source->GetStaticMesh();
+	for (int32 MaterialIndex = 0; MaterialIndex < Source->GetNumMaterials(); MaterialIndex++)
+	{
+		Key.Materials.Add(Source->GetMaterial(MaterialIndex));
+	}
+	if (UInstancedStaticMeshComponent** Component = ComponentLookup.Find(Key))
+	{
+		return *Component;
+	}
+
+	if (!FieldActor)
+	{
+		FActorSpawnParameters SpawnParameters;
+		SpawnParameters.ObjectFlags |= RF_Transient;
+		FieldActor = GetWorld()->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParameters);
+		USceneComponent* FieldRoot = NewObject<USceneComponent>(FieldActor, TEXT("FieldRoot"));
+		FieldActor->SetRootComponent(FieldRoot);
+		FieldRoot->RegisterComponent();
+	}
+
+	UInstancedStaticMeshComponent* Component = NewObject<UInstancedStaticMeshComponent>(FieldActor);
+	Component->SetStaticMesh(Source->GetStaticMesh());
+	for (int32 MaterialIndex = 0; MaterialIndex < Key.Materials.Num(); MaterialIndex++)
+	{
+		Component->SetMaterial(MaterialIndex, const_cast<UMaterialInterface*>(Key.Materials[MaterialIndex]));
+	}
+	Component->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	Component->SetCastShadow(Source->CastShadow);
+	Component->NumCustomDataFloats = 1;
+	Component->SetupAttachment(FieldActor->GetRootComponent());
+	Component->RegisterComponent();
+
+	Components.Add(Component);
+	ComponentLookup.Add(Key, Component);
+	return Component;
+}
@@ -0,0 +1,79 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CollectableFieldSubsystem.generated.h"
+
+class ACollectableActor;
+class UInstancedStaticMeshComponent;
+class UMaterialInterface;
+class UStaticMesh;
+class UStaticMeshComponent;
+
+/**
+ * Draws every uncollected collectable as an instance of one instanced mesh per mesh and materials, so a level full
+ * of them costs a draw call per kind. Instance custom data 0 carries the spin speed in degrees per second,
+ * the material turns the instance around its pivot with it.
+ */
+UCLASS()
+class THEPATHOFOSU_API UCollectableFieldSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// Returns false when the collectable has no mesh to draw, it then keeps drawing its own
+	bool AddCollectable(ACollectableActor* Collectable);
+	void RemoveCollectable(const ACollectableActor* Collectable);
+
+	// A hidden instance keeps its slot, a collectable restored by a load shows up again in place
+	void SetCollectableVisible(const ACollectableActor* Collectable, bool IsVisible);
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FFieldInstance
+	{
+		UInstancedStaticMeshComponent* Component;
+		int32 InstanceIndex;
+		FTransform Transform;
+	};
+
+	// Every material slot of the collectable's mesh, overrides included
+	struct FComponentKey
+	{
+		const UStaticMesh* StaticMesh;
+		TArray<const UMaterialInterface*, TInlineAllocator<4>> Materials;
+
+		bool operator==(const FComponentKey& Other) const
+		{
+			return StaticMesh == Other.StaticMesh && Materials == Other.Materials;
+		}
+
+		friend uint32 GetTypeHash(const FComponentKey& Key)
+		{
+			uint32 Hash = GetTypeHash(Key.StaticMesh);
+			for (const UMaterialInterface* Material : Key.Materials)
+			{
+				Hash = HashCombine(Hash, GetTypeHash(Material));
+			}
+			return Hash;
+		}
+	};
+
+	UInstancedStaticMeshComponent* FindOrAddComponent(const UStaticMeshComponent* Source);
+
+	// Holds the instanced meshes, spawned with the first collectable
+	UPROPERTY()
+	AActor* FieldActor;
+
+	UPROPERTY()
+	TArray<UInstancedStaticMeshComponent*> Components;
+
+	TMap<FComponentKey, UInstancedStaticMeshComponent*> ComponentLookup;
+	TMap<TObjectKey<ACollectableActor>, FFieldInstance> Instances;
+	// Slots of removed collectables, reused before new instances are added
+	TMap<const UInstancedStaticMeshComponent*, TArray<int32>> FreeInstances;
+};
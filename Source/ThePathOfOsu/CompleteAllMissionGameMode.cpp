@@ -3,6 +3,10 @@
 
 #include "CompleteAllMissionGameMode.h"
 
+#include "CheckpointSubsystem.h"
+#include "OsuGameInstance.h"
+#include "OsuEventBusSubsystem.h"
+#include "OsuUIScreenManager.h"
 #include "PlayerCharacter.h"
 #include "Blueprint/UserWidget.h"
 #include "Kismet/GameplayStatics.h"
@@ -17,42 +21,104 @@ void ACompleteAllMissionGameMode::BeginPlay()
 	{
 		PlayerCharacter->OnPlayerDeath.AddDynamic(this, &ACompleteAllMissionGameMode::OnPlayerDeath);
 	}
+
+	UOsuUIScreenManager* ScreenManager = GetGameInstance()->GetSubsystem<UOsuUIScreenManager>();
+	ScreenManager->PreloadScreen(WinScreenWidgetClass, EOsuUILayer::Modal);
+	ScreenManager->PreloadScreen(LoseScreenWidgetClass, EOsuUILayer::Modal);
+	if (UOsuGameInstance* OsuGameInstance = Cast<UOsuGameInstance>(GetGameInstance()))
+	{
+		ScreenManager->PreloadScreen(OsuGameInstance->PauseMenuWidgetClass, EOsuUILayer::Menu);
+	}
+
+	TArray<UOsuMission*> Missions;
+	CurrentMission.GenerateKeyArray(Missions);
+	ObjectiveGraph.Compile(Missions);
+	for (TPair<UOsuMission*, bool>& Mission : CurrentMission)
+	{
+		Mission.Value = false;
+	}
+	GetWorld()->GetSubsystem<UOsuEventBusSubsystem>()->Subscribe(
+		this, &ACompleteAllMissionGameMode::OnObjectiveProgress);
 }
 
 void ACompleteAllMissionGameMode::CompleteMission(UOsuMission* Mission)
 {
-	if (CurrentMission.IsEmpty())
+	int32 Objective = INDEX_NONE;
+	if (ValidateMission(Mission, Objective))
 	{
-		UE_LOG(LogTemp, Error, TEXT("CurrentMission is empty, Function name: %s"), *FString(__FUNCTION__));
-		GEngine->AddOnScreenDebugMessage(-1, 15.0f, FColor::Red,
-		                                 FString::Printf(
-			                                 TEXT("CurrentMission is empty, Function name: %s"),
-			                                 *FString(__FUNCTION__)));
-		return;
+		TOsuFrameArray<int32> CompletedObjectives;
+		ObjectiveGraph.CompleteObjective(Objective, CompletedObjectives);
+		OnObjectivesCompleted(CompletedObjectives);
+	}
+}
+
+void ACompleteAllMissionGameMode::AddMissionProgress(UOsuMission* Mission, int32 Amount)
+{
+	int32 Objective = INDEX_NONE;
+	if (ValidateMission(Mission, Objective))
+	{
+		TOsuFrameArray<int32> CompletedObjectives;
+		ObjectiveGraph.AddProgress(Objective, Amount, CompletedObjectives);
+		OnObjectivesCompleted(CompletedObjectives);
 	}
+}
+
+int32 ACompleteAllMissionGameMode::GetMissionProgress(UOsuMission* Mission) const
+{
+	const int32 Objective = ObjectiveGraph.FindObjective(Mission);
+	return Objective != INDEX_NONE ? ObjectiveGraph.GetProgress(Objective) : 0;
+}
+
+bool ACompleteAllMissionGameMode::IsMissionUnlocked(UOsuMission* Mission) const
+{
+	const int32 Objective = ObjectiveGraph.FindObjective(Mission);
+	return Objective != INDEX_NONE && ObjectiveGraph.IsUnlocked(Objective);
+}
+
+void ACompleteAllMissionGameMode::OnObjectiveProgress(const FObjectiveProgressEvent& Event)
+{
+	// Delivered in the frame it was published, a pickup destroyed by then still has its tags
+	TOsuFrameArray<int32> CompletedObjectives;
+	ObjectiveGraph.AddEventProgress(Event.Event, Event.Source.Get(true), CompletedObjectives);
+	OnObjectivesCompleted(CompletedObjectives);
+}
+
+bool ACompleteAllMissionGameMode::ValidateMission(const UOsuMission* Mission, int32& OutObjective) const
+{
 	if (!Mission)
 	{
 		UE_LOG(LogTemp, Error, TEXT("Mission is null, Function name: %s"), *FString(__FUNCTION__));
 		GEngine->AddOnScreenDebugMessage(-1, 15.0f, FColor::Red,
 		                                 FString::Printf(
 			                                 TEXT("Mission is null, Function name: %s"), *FString(__FUNCTION__)));
-		return;
+		return false;
 	}
-	if (!CurrentMission.Contains(Mission))
+	OutObjective = ObjectiveGraph.FindObjective(Mission);
+	if (OutObjective == INDEX_NONE)
 	{
 		UE_LOG(LogTemp, Error, TEXT("Mission is not in the map, Function name: %s"), *FString(__FUNCTION__));
 		GEngine->AddOnScreenDebugMessage(-1, 15.0f, FColor::Red,
 		                                 FString::Printf(
 			                                 TEXT("Mission is not in the map, Function name: %s"),
 			                                 *FString(__FUNCTION__)));
-		return;
+		return false;
 	}
+	return true;
+}
 
-	CurrentMission[Mission] = true;
-
+void ACompleteAllMissionGameMode::OnObjectivesCompleted(const TOsuFrameArray<int32>& CompletedObjectives)
+{
+	if (CompletedObjectives.IsEmpty())
+	{
+		return;
+	}
+	for (const int32 Objective : CompletedObjectives)
+	{
+		CurrentMission[ObjectiveGraph.GetMission(Objective)] = true;
+	}
 
 	UGameplayStatics::SpawnSound2D(GetWorld(), CompleteMissionSound);
-	if (IsAllMissionCompleted())
+	if (ObjectiveGraph.IsAllRequiredCompleted())
 	{
 		WinGame();
 	}
@@ -65,8 +131,14 @@ void ACompleteAllMissionGameMode::OnPlayerDeath()
 
 void ACompleteAllMissionGameMode::LoseGame()
 {
-	GetWorldTimerManager().SetTimer(
-		LoseGameTimer, this, &ACompleteAllMissionGameMode::ShowLoseScreen, 2.0f, false);
+	LoseGameTask.Cancel();
+	LoseGameTask = LoseGameSequence();
+}
+
+FOsuLatentTask ACompleteAllMissionGameMode::LoseGameSequence()
+{
+	co_await FOsuLatentDelay{2.0f};
+	ShowLoseScreen();
 }
 
 void ACompleteAllMissionGameMode::ShowLoseScreen()
@@ -77,32 +149,87 @@ void ACompleteAllMissionGameMode::ShowLoseScreen()
 		                                 FString::Printf(TEXT("LoseScreenWidgetClass is null")));
 		return;
 	}
-	CreateWidget<UUserWidget>(GetWorld(), LoseScreenWidgetClass)->AddToViewport();
+	LoseScreenWidget = GetGameInstance()->GetSubsystem<UOsuUIScreenManager>()->PushScreen(
+		LoseScreenWidgetClass, EOsuUILayer::Modal, EOsuUIInputMode::UIOnly);
 
-	PlayerController->SetInputMode(FInputModeUIOnly());
-	PlayerController->SetShowMouseCursor(true);
 	PlayerController->GameHasEnded(PlayerController->GetPawn(), false);
 	UGameplayStatics::SetGlobalTimeDilation(GetWorld(), 0.0f);
 }
 
-bool ACompleteAllMissionGameMode::IsAllMissionCompleted()
+void ACompleteAllMissionGameMode::SerializeState(FArchive& Ar)
 {
-	for (auto& Mission : CurrentMission)
+	int32 MissionCount = ObjectiveGraph.Num();
+	Ar << MissionCount;
+	if (!Ar.IsLoading())
 	{
-		if (!Mission.Value)
+		for (int32 Objective = 0; Objective < MissionCount; Objective++)
 		{
-			return false;
+			FSoftObjectPath MissionPath(ObjectiveGraph.GetMission(Objective));
+			int32 Progress = ObjectiveGraph.GetProgress(Objective);
+			Ar << MissionPath << Progress;
 		}
+		return;
 	}
-	return true;
+
+	const bool HasProgressCounts = Ar.CustomVer(FOsuSaveVersion::GUID) >= FOsuSaveVersion::MissionProgress;
+	for (int32 Index = 0; Index < MissionCount && !Ar.IsError(); ++Index)
+	{
+		FSoftObjectPath MissionPath;
+		int32 Progress = 0;
+		Ar << MissionPath;
+		if (HasProgressCounts)
+		{
+			Ar << Progress;
+		}
+		else
+		{
+			bool IsCompleted = false;
+			Ar << IsCompleted;
+			Progress = IsCompleted ? MAX_int32 : 0;
+		}
+		const int32 Objective = ObjectiveGraph.FindObjective(Cast<UOsuMission>(MissionPath.ResolveObject()));
+		if (Objective != INDEX_NONE)
+		{
+			ObjectiveGraph.SetProgress(Objective, Progress);
+		}
+	}
+	ObjectiveGraph.RebuildCounters();
+	for (int32 Objective = 0; Objective < ObjectiveGraph.Num(); Objective++)
+	{
+		CurrentMission[ObjectiveGraph.GetMission(Objective)] = ObjectiveGraph.IsCompleted(Objective);
+	}
+}
+
+void ACompleteAllMissionGameMode::RetryFromCheckpoint()
+{
+	UCheckpointSubsystem* CheckpointSubsystem = GetWorld()->GetSubsystem<UCheckpointSubsystem>();
+	if (!CheckpointSubsystem || !CheckpointSubsystem->HasCheckpoint())
+	{
+		GEngine->AddOnScreenDebugMessage(-1, 15.0f, FColor::Red, FString::Printf(TEXT("No checkpoint to retry from")));
+		return;
+	}
+
+	LoseGameTask.Cancel();
+	UGameplayStatics::SetGlobalTimeDilation(GetWorld(), 1.0f);
+	if (LoseScreenWidget)
+	{
+		GetGameInstance()->GetSubsystem<UOsuUIScreenManager>()->PopScreen(LoseScreenWidget);
+	}
+	CheckpointSubsystem->RestoreCheckpoint();
+	PlayerController->SetViewTarget(PlayerController->GetPawn());
 }
 
 void ACompleteAllMissionGameMode::WinGame()
 {
-	PlayerController->SetIgnoreMoveInput(true);
-	GetWorldTimerManager().SetTimer(
-		WinGameTimer, this, &ACompleteAllMissionGameMode::ShowWinScreen, 2.0f, false);
+	WinGameTask.Cancel();
+	WinGameTask = WinGameSequence();
+}
 
+FOsuLatentTask ACompleteAllMissionGameMode::WinGameSequence()
+{
+	PlayerController->SetIgnoreMoveInput(true);
+	co_await FOsuLatentDelay{2.0f};
+	ShowWinScreen();
 }
 
 void ACompleteAllMissionGameMode::ShowWinScreen()
@@ -112,10 +239,9 @@ void ACompleteAllMissionGameMode::ShowWinScreen()
 		GEngine->AddOnScreenDebugMessage(-1, 15.0f, FColor::Red, FString::Printf(TEXT("WinScreenWidgetClass is null")));
 		return;
 	}
-	CreateWidget<UUserWidget>(GetWorld(), WinScreenWidgetClass)->AddToViewport();
+	GetGameInstance()->GetSubsystem<UOsuUIScreenManager>()->PushScreen(
+		WinScreenWidgetClass, EOsuUILayer::Modal, EOsuUIInputMode::UIOnly);
 
-	PlayerController->SetInputMode(FInputModeUIOnly());
-	PlayerController->SetShowMouseCursor(true);
 	PlayerController->GameHasEnded(PlayerController->GetPawn(), true);
 	
 }
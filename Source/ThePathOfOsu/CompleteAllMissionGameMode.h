@@ -3,36 +3,65 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "OsuGameplayEvents.h"
+#include "OsuLatentTask.h"
 #include "OsuMission.h"
+#include "OsuObjectiveGraph.h"
 #include "ThePathOfOsuGameMode.h"
 #include "Blueprint/UserWidget.h"
+#include "Interface/SaveableInterface.h"
 #include "CompleteAllMissionGameMode.generated.h"
 
 UCLASS()
-class THEPATHOFOSU_API ACompleteAllMissionGameMode : public AThePathOfOsuGameMode
+class THEPATHOFOSU_API ACompleteAllMissionGameMode : public AThePathOfOsuGameMode, public ISaveableInterface
 {
 	GENERATED_BODY()
 
 public:
 	virtual void BeginPlay() override;
 
+	// The level's missions, compiled into an objective graph at BeginPlay. Values mirror completion for Blueprints
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Mission")
 	TMap<UOsuMission*, bool> CurrentMission;
 
 	UFUNCTION(BlueprintCallable, Category = "Mission")
 	void CompleteMission(UOsuMission* Mission);
 
+	UFUNCTION(BlueprintCallable, Category = "Mission")
+	void AddMissionProgress(UOsuMission* Mission, int32 Amount = 1);
+
+	UFUNCTION(BlueprintPure, Category = "Mission")
+	int32 GetMissionProgress(UOsuMission* Mission) const;
+
+	UFUNCTION(BlueprintPure, Category = "Mission")
+	bool IsMissionUnlocked(UOsuMission* Mission) const;
+
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Mission")
 	USoundBase* CompleteMissionSound;
 
 	UFUNCTION(BlueprintCallable)
 	void OnPlayerDeath();
+
+	// Closes the lose screen and puts the level back to the last checkpoint without reloading the map
+	UFUNCTION(BlueprintCallable)
+	void RetryFromCheckpoint();
+
+	// Only updates missions that are still in CurrentMission, missions removed from the level are skipped
+	virtual void SerializeState(FArchive& Ar) override;
+	virtual FName GetSaveId() const override { return TEXT("GameMode"); }
 	
 
 private:
 	void WinGame();
 	void LoseGame();
-	bool IsAllMissionCompleted();
+
+	bool ValidateMission(const UOsuMission* Mission, int32& OutObjective) const;
+	void OnObjectivesCompleted(const TOsuFrameArray<int32>& CompletedObjectives);
+
+	// Advances every unlocked mission listening to the event, published by actors on UOsuEventBusSubsystem
+	void OnObjectiveProgress(const FObjectiveProgressEvent& Event);
+
+	FOsuObjectiveGraph ObjectiveGraph;
 
 	UPROPERTY(EditDefaultsOnly)
 	TSubclassOf<UUserWidget> WinScreenWidgetClass;
@@ -40,8 +69,14 @@ private:
 	UPROPERTY(EditDefaultsOnly)
 	TSubclassOf<UUserWidget> LoseScreenWidgetClass;
 
-	FTimerHandle LoseGameTimer;;
-	FTimerHandle WinGameTimer;
+	UPROPERTY()
+	UUserWidget* LoseScreenWidget;
+
+	// Wait out the death or the last mission before the screen shows
+	FOsuLatentTask LoseGameTask;
+	FOsuLatentTask WinGameTask;
+	FOsuLatentTask LoseGameSequence();
+	FOsuLatentTask WinGameSequence();
 	APlayerController* PlayerController;
 	void ShowWinScreen();
 	void ShowLoseScreen();
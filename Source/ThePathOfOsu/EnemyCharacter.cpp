@@ -2,64 +2,53 @@
 
 
 #include "EnemyCharacter.h"
-#include "Components/WidgetComponent.h"
+#include "OsuEventBusSubsystem.h"
 #include "Kismet/KismetArrayLibrary.h"
 
 AEnemyCharacter::AEnemyCharacter()
 {
-	TargetWidget = CreateDefaultSubobject<UWidgetComponent>(TEXT("TargetWidget"));
-	TargetWidget->SetupAttachment(GetRootComponent());
-	TargetWidget->SetWidgetSpace(EWidgetSpace::World);
-	TargetWidget->SetDrawSize(FVector2D(50, 50));
-	TargetWidget->SetGenerateOverlapEvents(false);
-	TargetWidget->SetHiddenInGame(true);
-
-	ExecutableTargetWidget = CreateDefaultSubobject<UWidgetComponent>(TEXT("ExecutableTargetWidget"));
-	ExecutableTargetWidget->SetupAttachment(GetRootComponent());
-	ExecutableTargetWidget->SetWidgetSpace(EWidgetSpace::World);
-	ExecutableTargetWidget->SetDrawSize(FVector2D(50, 50));
-	ExecutableTargetWidget->SetGenerateOverlapEvents(false);
-	ExecutableTargetWidget->SetHiddenInGame(true);
-
-	HealthBarWidget = CreateDefaultSubobject<UWidgetComponent>(TEXT("HealthBarWidget"));
-	HealthBarWidget->SetupAttachment(GetRootComponent());
-	HealthBarWidget->SetWidgetSpace(EWidgetSpace::World);
 }
 
-void AEnemyCharacter::ShowTargetWidget()
+void AEnemyCharacter::SetTargetLocked(bool bValue)
 {
-	TargetWidget->SetHiddenInGame(false);
-}
-
-void AEnemyCharacter::HideTargetWidget()
-{
-	TargetWidget->SetHiddenInGame(true);
-}
-
-void AEnemyCharacter::ShowExecutableTargetWidget()
-{
-	ExecutableTargetWidget->SetHiddenInGame(false);
+	if (IsTargetLocked == bValue)
+	{
+		return;
+	}
+	IsTargetLocked = bValue;
+	OnMarkerChanged.Broadcast(this);
 }
 
-void AEnemyCharacter::HideExecutableTargetWidget()
+bool AEnemyCharacter::GetIsTargetLocked() const
 {
-	ExecutableTargetWidget->SetHiddenInGame(true);
+	return IsTargetLocked;
 }
 
-void AEnemyCharacter::HideHealthBar()
+void AEnemyCharacter::BeginPlay()
 {
-	HealthBarWidget->SetHiddenInGame(true);
+	Super::BeginPlay();
+	OnAttributeChanged.AddDynamic(this, &AEnemyCharacter::OnAttributeChangedForMarker);
 }
 
-void AEnemyCharacter::BeginPlay()
+void AEnemyCharacter::OnAttributeChangedForMarker(EOxAttribute Attribute, float CurrentValue, float MaxValue)
 {
-	Super::BeginPlay();
+	if (Attribute == EOxAttribute::Hp)
+	{
+		OnMarkerChanged.Broadcast(this);
+	}
 }
 
 float AEnemyCharacter::TakeDamage(float DamageAmount, FDamageEvent const& DamageEvent, AController* EventInstigator,
                                   AActor* DamageCauser)
 {
-	return Super::TakeDamage(DamageAmount, DamageEvent, EventInstigator, DamageCauser);
+	const bool WasAlive = IsAlive();
+	const float DamageTaken = Super::TakeDamage(DamageAmount, DamageEvent, EventInstigator, DamageCauser);
+	// Reported here rather than in Die, which also runs when a save restores a dead enemy
+	if (WasAlive && IsDead())
+	{
+		UOsuEventBusSubsystem::Publish(this, FObjectiveProgressEvent{this, EObjectiveEvent::EnemyKilled});
+	}
+	return DamageTaken;
 }
 
 void AEnemyCharacter::TryFistAttack()
@@ -72,27 +61,41 @@ void AEnemyCharacter::TryFistAttack()
 
 
 	int32 RandomIndex = FMath::RandRange(0, FistAttackMontages.Num() - 1);
-	UAnimMontage* RandomFistAttackMontage = FistAttackMontages[RandomIndex];
+	UAnimMontage* RandomFistAttackMontage = GetMontage(FistAttackMontages[RandomIndex]);
 	AnimInstance->Montage_Play(RandomFistAttackMontage, 1.0f);
 }
 
 void AEnemyCharacter::BreakPosture()
 {
 	Super::BreakPosture();
-	ShowExecutableTargetWidget();
+	OnMarkerChanged.Broadcast(this);
 }
 
 void AEnemyCharacter::RestorePostureFromBreak()
 {
 	Super::RestorePostureFromBreak();
-	HideExecutableTargetWidget();
+	OnMarkerChanged.Broadcast(this);
 }
 
 void AEnemyCharacter::Die()
 {
 	Super::Die();
-	HideHealthBar();
-	HideExecutableTargetWidget();
+	OnMarkerChanged.Broadcast(this);
 	OnEnemyEndBattle.Broadcast();
 	OnEnemyDeath.Broadcast();
 }
+
+void AEnemyCharacter::Revive()
+{
+	Super::Revive();
+	OnEnemyRevived.Broadcast();
+}
+
+void AEnemyCharacter::SerializeState(FArchive& Ar)
+{
+	Super::SerializeState(Ar);
+	if (Ar.IsLoading())
+	{
+		OnMarkerChanged.Broadcast(this);
+	}
+}
@@ -4,12 +4,13 @@
 
 #include "CoreMinimal.h"
 #include "OxCharacter.h"
-#include "Components/WidgetComponent.h"
 #include "EnemyCharacter.generated.h"
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnEnemyDeath);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnEnemyRevived);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnEnemyStartBattle);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnEnemyEndBattle);
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnEnemyMarkerChanged, AEnemyCharacter*);
 
 UCLASS()
 class THEPATHOFOSU_API AEnemyCharacter : public AOxCharacter
@@ -18,28 +19,23 @@ class THEPATHOFOSU_API AEnemyCharacter : public AOxCharacter
 
 public:
 	AEnemyCharacter();
-	
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "UI")
-	UWidgetComponent* TargetWidget;
-	
-	void ShowTargetWidget();
-	void HideTargetWidget();
-	
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "UI")
-	UWidgetComponent* ExecutableTargetWidget;
-	
-	void ShowExecutableTargetWidget();
-	void HideExecutableTargetWidget();
 
-	
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "UI")
-	UWidgetComponent* HealthBarWidget;
-	
-	void HideHealthBar();
+	// Lock-on marker is drawn by the HUD's enemy marker layer while set
+	void SetTargetLocked(bool bValue);
+	bool GetIsTargetLocked() const;
+
+	// Broadcast whenever hp, lock-on, executable or death state changes, the marker layer only redraws then
+	FOnEnemyMarkerChanged OnMarkerChanged;
 
 	UPROPERTY(BlueprintAssignable)
 	FOnEnemyDeath OnEnemyDeath;
 
+	// A checkpoint or save brought the enemy back, Blueprints restart their AI here
+	UPROPERTY(BlueprintAssignable)
+	FOnEnemyRevived OnEnemyRevived;
+
+	virtual void SerializeState(FArchive& Ar) override;
+
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI")
 	float AcquisitionRange = 500.0f;
 
@@ -60,7 +56,13 @@ protected:
 	virtual void BreakPosture() override;
 	virtual void RestorePostureFromBreak() override;
 	virtual void Die() override;
+	virtual void Revive() override;
 
 	
 private:
+	bool IsTargetLocked = false;
+
+	// Hp changes from damage and regen both arrive here
+	UFUNCTION()
+	void OnAttributeChangedForMarker(EOxAttribute Attribute, float CurrentValue, float MaxValue);
 };
@@ -0,0 +1,175 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "EnemyMarkerLayerWidget.h"
+
+#include "EnemyCharacter.h"
+#include "Blueprint/WidgetLayoutLibrary.h"
+#include "Blueprint/WidgetTree.h"
+#include "Components/CanvasPanel.h"
+#include "Components/CanvasPanelSlot.h"
+
+void UEnemyMarkerLayerWidget::RegisterEnemy(AEnemyCharacter* Enemy)
+{
+	if (!Enemy || Enemy->IsDead())
+	{
+		return;
+	}
+	if (TrackedEnemies.ContainsByPredicate([Enemy](const FTrackedEnemy& TrackedEnemy)
+	{
+		return TrackedEnemy.Enemy == Enemy;
+	}))
+	{
+		return;
+	}
+
+	FTrackedEnemy& TrackedEnemy = TrackedEnemies.AddDefaulted_GetRef();
+	TrackedEnemy.Enemy = Enemy;
+	Enemy->OnMarkerChanged.AddUObject(this, &UEnemyMarkerLayerWidget::OnEnemyMarkerChanged);
+}
+
+void UEnemyMarkerLayerWidget::NativeOnInitialized()
+{
+	Super::NativeOnInitialized();
+	// The native class has no designer tree, it draws on a bare canvas
+	if (WidgetTree && !WidgetTree->RootWidget)
+	{
+		MarkerCanvas = WidgetTree->ConstructWidget<UCanvasPanel>(UCanvasPanel::StaticClass(), TEXT("MarkerCanvas"));
+		WidgetTree->RootWidget = MarkerCanvas;
+	}
+}
+
+void UEnemyMarkerLayerWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
+{
+	Super::NativeTick(MyGeometry, InDeltaTime);
+
+	APlayerController* OwningPlayer = GetOwningPlayer();
+	if (!OwningPlayer || !OwningPlayer->PlayerCameraManager)
+	{
+		return;
+	}
+
+	const FVector CameraLocation = OwningPlayer->PlayerCameraManager->GetCameraLocation();
+	const float MaxMarkerDistanceSquared = FMath::Square(MaxMarkerDistance);
+	const FVector2D LayerSize = MyGeometry.GetLocalSize();
+
+	for (int32 Index = TrackedEnemies.Num() - 1; Index >= 0; --Index)
+	{
+		FTrackedEnemy& TrackedEnemy = TrackedEnemies[Index];
+		AEnemyCharacter* Enemy = TrackedEnemy.Enemy.Get();
+		if (!Enemy || Enemy->IsDead())
+		{
+			ReleaseMarker(TrackedEnemy);
+			if (Enemy)
+			{
+				Enemy->OnMarkerChanged.RemoveAll(this);
+			}
+			TrackedEnemies.RemoveAtSwap(Index);
+			continue;
+		}
+
+		const FVector MarkerLocation = Enemy->GetActorLocation() + FVector(0.0f, 0.0f, MarkerHeightOffset);
+		FVector2D MarkerPosition;
+		const bool IsOnScreen = FVector::DistSquared(CameraLocation, MarkerLocation) <= MaxMarkerDistanceSquared
+			&& UWidgetLayoutLibrary::ProjectWorldLocationToWidgetPosition(
+				OwningPlayer, MarkerLocation, MarkerPosition, false)
+			&& MarkerPosition.X >= 0.0f && MarkerPosition.X <= LayerSize.X
+			&& MarkerPosition.Y >= 0.0f && MarkerPosition.Y <= LayerSize.Y;
+		if (!IsOnScreen)
+		{
+			ReleaseMarker(TrackedEnemy);
+			continue;
+		}
+
+		if (TrackedEnemy.MarkerIndex == INDEX_NONE)
+		{
+			TrackedEnemy.MarkerIndex = AcquireMarker();
+			if (TrackedEnemy.MarkerIndex == INDEX_NONE)
+			{
+				continue;
+			}
+			// A reused marker still shows the state of the enemy it was last assigned to
+			TrackedEnemy.IsStateDirty = true;
+		}
+
+		UEnemyMarkerWidget* Marker = MarkerPool[TrackedEnemy.MarkerIndex];
+		if (TrackedEnemy.IsStateDirty)
+		{
+			Marker->SetMarkerState(ReadMarkerState(Enemy));
+			TrackedEnemy.IsStateDirty = false;
+		}
+		if (UCanvasPanelSlot* CanvasSlot = Cast<UCanvasPanelSlot>(Marker->Slot))
+		{
+			CanvasSlot->SetPosition(MarkerPosition);
+		}
+	}
+}
+
+void UEnemyMarkerLayerWidget::NativeDestruct()
+{
+	for (const FTrackedEnemy& TrackedEnemy : TrackedEnemies)
+	{
+		if (AEnemyCharacter* Enemy = TrackedEnemy.Enemy.Get())
+		{
+			Enemy->OnMarkerChanged.RemoveAll(this);
+		}
+	}
+	TrackedEnemies.Reset();
+	Super::NativeDestruct();
+}
+
+void UEnemyMarkerLayerWidget::OnEnemyMarkerChanged(AEnemyCharacter* Enemy)
+{
+	for (FTrackedEnemy& TrackedEnemy : TrackedEnemies)
+	{
+		if (TrackedEnemy.Enemy == Enemy)
+		{
+			TrackedEnemy.IsStateDirty = true;
+			return;
+		}
+	}
+}
+
+int32 UEnemyMarkerLayerWidget::AcquireMarker()
+{
+	int32 MarkerIndex;
+	if (!FreeMarkerIndices.IsEmpty())
+	{
+		MarkerIndex = FreeMarkerIndices.Pop(false);
+	}
+	else
+	{
+		if (!MarkerWidgetClass || !MarkerCanvas)
+		{
+			UE_LOG(LogTemp, Error, TEXT("MarkerWidgetClass or MarkerCanvas is null! %s"), *GetName());
+			return INDEX_NONE;
+		}
+		UEnemyMarkerWidget* Marker = CreateWidget<UEnemyMarkerWidget>(this, MarkerWidgetClass);
+		UCanvasPanelSlot* CanvasSlot = MarkerCanvas->AddChildToCanvas(Marker);
+		CanvasSlot->SetAutoSize(true);
+		CanvasSlot->SetAlignment(FVector2D(0.5f, 1.0f));
+		MarkerIndex = MarkerPool.Add(Marker);
+	}
+	MarkerPool[MarkerIndex]->SetVisibility(ESlateVisibility::HitTestInvisible);
+	return MarkerIndex;
+}
+
+void UEnemyMarkerLayerWidget::ReleaseMarker(FTrackedEnemy& TrackedEnemy)
+{
+	if (TrackedEnemy.MarkerIndex == INDEX_NONE)
+	{
+		return;
+	}
+	MarkerPool[TrackedEnemy.MarkerIndex]->SetVisibility(ESlateVisibility::Collapsed);
+	FreeMarkerIndices.Add(TrackedEnemy.MarkerIndex);
+	TrackedEnemy.MarkerIndex = INDEX_NONE;
+}
+
+FEnemyMarkerState UEnemyMarkerLayerWidget::ReadMarkerState(const AEnemyCharacter* Enemy)
+{
+	FEnemyMarkerState State;
+	State.HpPercentage = Enemy->GetHpPercentage();
+	State.ShowExecutable = Enemy->IsExecutable;
+	State.ShowLockOn = Enemy->GetIsTargetLocked() && !Enemy->IsExecutable;
+	return State;
+}
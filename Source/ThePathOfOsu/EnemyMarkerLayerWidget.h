@@ -0,0 +1,64 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Blueprint/UserWidget.h"
+#include "EnemyMarkerWidget.h"
+#include "EnemyMarkerLayerWidget.generated.h"
+
+class AEnemyCharacter;
+class UCanvasPanel;
+
+/**
+ * Screen space layer drawing health bar, lock-on and executable markers for every enemy in view.
+ * Markers come from a pool sized by the number of enemies on screen, and an enemy's marker is only
+ * rebuilt after it broadcasts OnMarkerChanged.
+ */
+UCLASS()
+class THEPATHOFOSU_API UEnemyMarkerLayerWidget : public UUserWidget
+{
+	GENERATED_BODY()
+
+public:
+	void RegisterEnemy(AEnemyCharacter* Enemy);
+
+protected:
+	virtual void NativeOnInitialized() override;
+	virtual void NativeTick(const FGeometry& MyGeometry, float InDeltaTime) override;
+	virtual void NativeDestruct() override;
+
+	UPROPERTY(meta = (BindWidget))
+	UCanvasPanel* MarkerCanvas;
+
+	UPROPERTY(EditDefaultsOnly)
+	TSubclassOf<UEnemyMarkerWidget> MarkerWidgetClass = UEnemyMarkerWidget::StaticClass();
+
+	// Enemies further than this from the camera get no marker
+	UPROPERTY(EditDefaultsOnly)
+	float MaxMarkerDistance = 2500.0f;
+
+	// Height above the enemy's actor location the marker is anchored at
+	UPROPERTY(EditDefaultsOnly)
+	float MarkerHeightOffset = 110.0f;
+
+private:
+	struct FTrackedEnemy
+	{
+		TWeakObjectPtr<AEnemyCharacter> Enemy;
+		int32 MarkerIndex = INDEX_NONE;
+		bool IsStateDirty = true;
+	};
+
+	TArray<FTrackedEnemy> TrackedEnemies;
+
+	UPROPERTY()
+	TArray<UEnemyMarkerWidget*> MarkerPool;
+
+	TArray<int32> FreeMarkerIndices;
+
+	void OnEnemyMarkerChanged(AEnemyCharacter* Enemy);
+	int32 AcquireMarker();
+	void ReleaseMarker(FTrackedEnemy& TrackedEnemy);
+	static FEnemyMarkerState ReadMarkerState(const AEnemyCharacter* Enemy);
+};
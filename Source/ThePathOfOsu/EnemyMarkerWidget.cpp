@@ -0,0 +1,63 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "EnemyMarkerWidget.h"
+
+#include "Blueprint/WidgetTree.h"
+#include "Components/Image.h"
+#include "Components/ProgressBar.h"
+#include "Components/SizeBox.h"
+#include "Components/VerticalBox.h"
+#include "Components/VerticalBoxSlot.h"
+
+void UEnemyMarkerWidget::NativeOnInitialized()
+{
+	Super::NativeOnInitialized();
+	if (WidgetTree && !WidgetTree->RootWidget)
+	{
+		BuildDefaultWidgetTree();
+	}
+}
+
+void UEnemyMarkerWidget::BuildDefaultWidgetTree()
+{
+	UVerticalBox* Root = WidgetTree->ConstructWidget<UVerticalBox>();
+	WidgetTree->RootWidget = Root;
+
+	UImage* LockOnImage = WidgetTree->ConstructWidget<UImage>(UImage::StaticClass(), TEXT("LockOnMarker"));
+	LockOnImage->SetDesiredSizeOverride(FVector2D(12.0f, 12.0f));
+	LockOnMarker = LockOnImage;
+	Root->AddChildToVerticalBox(LockOnMarker)->SetHorizontalAlignment(HAlign_Center);
+
+	USizeBox* HealthBarBox = WidgetTree->ConstructWidget<USizeBox>();
+	HealthBarBox->SetWidthOverride(80.0f);
+	HealthBarBox->SetHeightOverride(8.0f);
+	HealthBar = WidgetTree->ConstructWidget<UProgressBar>(UProgressBar::StaticClass(), TEXT("HealthBar"));
+	HealthBar->SetFillColorAndOpacity(FLinearColor::Red);
+	HealthBarBox->AddChild(HealthBar);
+	Root->AddChildToVerticalBox(HealthBarBox)->SetPadding(FMargin(0.0f, 2.0f));
+
+	UImage* ExecutableImage = WidgetTree->ConstructWidget<UImage>(UImage::StaticClass(), TEXT("ExecutableMarker"));
+	ExecutableImage->SetDesiredSizeOverride(FVector2D(12.0f, 12.0f));
+	ExecutableImage->SetColorAndOpacity(FLinearColor::Red);
+	ExecutableMarker = ExecutableImage;
+	Root->AddChildToVerticalBox(ExecutableMarker)->SetHorizontalAlignment(HAlign_Center);
+}
+
+void UEnemyMarkerWidget::SetMarkerState(const FEnemyMarkerState& State)
+{
+	if (HealthBar)
+	{
+		HealthBar->SetPercent(State.HpPercentage);
+	}
+	if (LockOnMarker)
+	{
+		LockOnMarker->SetVisibility(State.ShowLockOn ? ESlateVisibility::HitTestInvisible : ESlateVisibility::Collapsed);
+	}
+	if (ExecutableMarker)
+	{
+		ExecutableMarker->SetVisibility(State.ShowExecutable
+			                                ? ESlateVisibility::HitTestInvisible
+			                                : ESlateVisibility::Collapsed);
+	}
+}
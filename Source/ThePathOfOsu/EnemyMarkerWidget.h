@@ -0,0 +1,43 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Blueprint/UserWidget.h"
+#include "EnemyMarkerWidget.generated.h"
+
+class UProgressBar;
+
+struct FEnemyMarkerState
+{
+	float HpPercentage = 1.0f;
+	bool ShowLockOn = false;
+	bool ShowExecutable = false;
+};
+
+/**
+ * One pooled slot of the enemy marker layer, reassigned to whichever enemy needs it
+ */
+UCLASS()
+class THEPATHOFOSU_API UEnemyMarkerWidget : public UUserWidget
+{
+	GENERATED_BODY()
+
+public:
+	void SetMarkerState(const FEnemyMarkerState& State);
+
+protected:
+	virtual void NativeOnInitialized() override;
+
+	UPROPERTY(BlueprintReadOnly, meta = (BindWidgetOptional))
+	UProgressBar* HealthBar;
+
+	UPROPERTY(BlueprintReadOnly, meta = (BindWidgetOptional))
+	UWidget* LockOnMarker;
+
+	UPROPERTY(BlueprintReadOnly, meta = (BindWidgetOptional))
+	UWidget* ExecutableMarker;
+
+private:
+	void BuildDefaultWidgetTree();
+};
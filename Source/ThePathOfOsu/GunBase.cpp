@@ -3,6 +3,9 @@
 #include "Engine/DamageEvents.h"
 #include "Kismet/KismetSystemLibrary.h"
 #include "NiagaraFunctionLibrary.h"
+#include "OsuAssetLoader.h"
+#include "OsuTraceServiceSubsystem.h"
+#include "OsuWarmupSubsystem.h"
 
 
 AGunBase::AGunBase()
@@ -35,24 +38,34 @@ void AGunBase::Tick(float DeltaTime)
 	Super::Tick(DeltaTime);
 }
 
+void AGunBase::AddAssetBundlePaths(TArray<FSoftObjectPath>& OutPaths) const
+{
+	FOsuAssetLoader::AddPath(OutPaths, MuzzleSound);
+	FOsuAssetLoader::AddPath(OutPaths, ImpactSound);
+	FOsuAssetLoader::AddPath(OutPaths, MuzzleFlash);
+	FOsuAssetLoader::AddPath(OutPaths, ImpactEffect);
+	FOsuAssetLoader::AddPath(OutPaths, FireMontage);
+}
+
 void AGunBase::Shoot()
 {
-	if (MuzzleFlash)
+	FOsuFirstUseScope FirstUseScope(this, TEXT("GunShot"));
+	if (UNiagaraSystem* MuzzleFlashSystem = FOsuAssetLoader::Get(MuzzleFlash, this))
 	{
-		UNiagaraFunctionLibrary::SpawnSystemAttached(MuzzleFlash, WeaponMesh, MuzzleSocketName,
+		UNiagaraFunctionLibrary::SpawnSystemAttached(MuzzleFlashSystem, WeaponMesh, MuzzleSocketName,
 		                                             FVector::ZeroVector,
 		                                             FRotator::ZeroRotator, EAttachLocation::KeepRelativeOffset, true);
 	}
 
-	if (MuzzleSound)
+	if (USoundBase* MuzzleSoundAsset = FOsuAssetLoader::Get(MuzzleSound, this))
 	{
 		// UGameplayStatics::SpawnSoundAttached(MuzzleSound, WeaponMesh, TEXT("MuzzleFlashSocket"));
-		UGameplayStatics::SpawnSoundAtLocation(GetWorld(), MuzzleSound, GetActorLocation(), FRotator::ZeroRotator, 1.0f,
+		UGameplayStatics::SpawnSoundAtLocation(GetWorld(), MuzzleSoundAsset, GetActorLocation(), FRotator::ZeroRotator, 1.0f,
 		                                       1.0f, 0.0f, AttenuationSettings, SoundConcurrencySettings, true);
 	}
-	if (FireMontage)
+	if (UAnimMontage* FireMontageAsset = FOsuAssetLoader::Get(FireMontage, this))
 	{
-		WeaponMesh->PlayAnimation(FireMontage, false);
+		WeaponMesh->PlayAnimation(FireMontageAsset, false);
 	}
 
 
@@ -62,14 +75,14 @@ void AGunBase::Shoot()
 	{
 		// DrawDebugPoint(GetWorld(), Hit.Location, 20, FColor::Red, true);
 		// UGameplayStatics::SpawnEmitterAtLocation(GetWorld(), ImpactEffect, Hit.Location, ShotDirection.Rotation());
-		if (ImpactEffect)
+		if (UNiagaraSystem* ImpactEffectSystem = FOsuAssetLoader::Get(ImpactEffect, this))
 		{
-			UNiagaraFunctionLibrary::SpawnSystemAtLocation(GetWorld(), ImpactEffect, Hit.ImpactPoint,
+			UNiagaraFunctionLibrary::SpawnSystemAtLocation(GetWorld(), ImpactEffectSystem, Hit.ImpactPoint,
 			                                               ShotDirection.Rotation());
 		}
-		if (ImpactSound)
+		if (USoundBase* ImpactSoundAsset = FOsuAssetLoader::Get(ImpactSound, this))
 		{
-			UGameplayStatics::PlaySoundAtLocation(GetWorld(), ImpactSound, Hit.Location);
+			UGameplayStatics::PlaySoundAtLocation(GetWorld(), ImpactSoundAsset, Hit.Location);
 		}
 		AActor* HitActor = Hit.GetActor();
 		if (HitActor != nullptr)
@@ -107,11 +120,11 @@ bool AGunBase::TryGunTrace(FHitResult& Hit, FVector& ShotDirection)
 	const FVector EndLocation = PlayerViewPointLocation + PlayerViewPointRotation.Vector() * MaxRange;
 
 	ShotDirection = -PlayerViewPointRotation.Vector();
-	FCollisionQueryParams Params;
+	FCollisionQueryParams Params(SCENE_QUERY_STAT(GunTrace));
 	Params.AddIgnoredActor(this);
 	Params.AddIgnoredActor(GetOwner());
 
-	bool IsHit = GetWorld()->LineTraceSingleByChannel(Hit, PlayerViewPointLocation, EndLocation, ECC_Pawn,
-	                                                  Params);
+	bool IsHit = GetWorld()->GetSubsystem<UOsuTraceServiceSubsystem>()->LineTraceSingleByChannel(
+		Hit, PlayerViewPointLocation, EndLocation, ECC_Pawn, Params);
 	return IsHit;
 }
@@ -20,6 +20,9 @@ public:
 	virtual void Tick(float DeltaTime) override;
 
 	void Shoot();
+
+	// Effects spawned by Shoot, loaded with the weapon's EOsuAssetBundle
+	void AddAssetBundlePaths(TArray<FSoftObjectPath>& OutPaths) const;
 	
 private:
 	
@@ -34,10 +37,10 @@ private:
 	AController* OwnerController;
 	
 	UPROPERTY(EditAnywhere)
-	USoundBase* MuzzleSound;
+	TSoftObjectPtr<USoundBase> MuzzleSound;
 	
 	UPROPERTY(EditAnywhere)
-	USoundBase* ImpactSound;
+	TSoftObjectPtr<USoundBase> ImpactSound;
 	
 	UPROPERTY(EditAnywhere)
 	USoundAttenuation* AttenuationSettings;
@@ -46,13 +49,13 @@ private:
 	USoundConcurrency* SoundConcurrencySettings;
 	
 	UPROPERTY(EditAnywhere)
-	UNiagaraSystem* MuzzleFlash;
+	TSoftObjectPtr<UNiagaraSystem> MuzzleFlash;
 
 	UPROPERTY(EditAnywhere)
-	UNiagaraSystem* ImpactEffect;
+	TSoftObjectPtr<UNiagaraSystem> ImpactEffect;
 	
 	UPROPERTY(EditDefaultsOnly, Category = "Animation")
-	UAnimMontage* FireMontage;
+	TSoftObjectPtr<UAnimMontage> FireMontage;
 	
 	UPROPERTY(EditDefaultsOnly)
 	TSubclassOf<AActor> BulletTraceActorClass;
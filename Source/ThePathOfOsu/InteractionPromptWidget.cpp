@@ -0,0 +1,22 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "InteractionPromptWidget.h"
+
+#include "Components/Image.h"
+#include "Components/TextBlock.h"
+
+void UInteractionPromptWidget::SetPrompt(const FInteractionPrompt& Prompt)
+{
+	if (IconImage)
+	{
+		IconImage->SetBrushFromTexture(Prompt.Icon);
+		IconImage->SetVisibility(Prompt.Icon ? ESlateVisibility::HitTestInvisible : ESlateVisibility::Collapsed);
+	}
+	if (NameText)
+	{
+		NameText->SetText(Prompt.Name);
+		NameText->SetVisibility(Prompt.Name.IsEmpty() ? ESlateVisibility::Collapsed : ESlateVisibility::HitTestInvisible);
+	}
+	OnPromptChanged(Prompt);
+}
@@ -0,0 +1,33 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Blueprint/UserWidget.h"
+#include "OsuType.h"
+#include "InteractionPromptWidget.generated.h"
+
+class UImage;
+class UTextBlock;
+
+/**
+ * Icon and name of the interactable the player currently highlights
+ */
+UCLASS()
+class THEPATHOFOSU_API UInteractionPromptWidget : public UUserWidget
+{
+	GENERATED_BODY()
+
+public:
+	void SetPrompt(const FInteractionPrompt& Prompt);
+
+protected:
+	UPROPERTY(BlueprintReadOnly, meta = (BindWidgetOptional))
+	UImage* IconImage;
+
+	UPROPERTY(BlueprintReadOnly, meta = (BindWidgetOptional))
+	UTextBlock* NameText;
+
+	UFUNCTION(BlueprintImplementableEvent)
+	void OnPromptChanged(const FInteractionPrompt& Prompt);
+};
@@ -1,3 +1,205 @@
 ﻿#include "InteractableInterface.h"
 
+#include "EngineUtils.h"
+#include "HAL/IConsoleManager.h"
+#include "UObject/UObjectGlobals.h"
+#include "UObject/ObjectKey.h"
 
+bool FInteractableDispatch::IsInteractable(const UObject* Object)
+{
+	return Object && GetClassInfo(Object).IsInteractable;
+}
+
+void FInteractableDispatch::Interact(UObject* Object, APlayerCharacter* InteractPlayerCharacter)
+{
+	if (IInteractableInterface* NativeImplementer = GetNativeImplementer(Object, EFunction::Interact))
+	{
+		NativeImplementer->Interact_Implementation(InteractPlayerCharacter);
+		return;
+	}
+	IInteractableInterface::Execute_Interact(Object, InteractPlayerCharacter);
+}
+
+bool FInteractableDispatch::IsEnable(UObject* Object)
+{
+	if (IInteractableInterface* NativeImplementer = GetNativeImplementer(Object, EFunction::IsEnable))
+	{
+		return NativeImplementer->IsEnable_Implementation();
+	}
+	return IInteractableInterface::Execute_IsEnable(Object);
+}
+
+void FInteractableDispatch::ToggleOutline(UObject* Object, bool bValue)
+{
+	if (IInteractableInterface* NativeImplementer = GetNativeImplementer(Object, EFunction::ToggleOutline))
+	{
+		NativeImplementer->ToggleOutline_Implementation(bValue);
+		return;
+	}
+	IInteractableInterface::Execute_ToggleOutline(Object, bValue);
+}
+
+bool FInteractableDispatch::IsInteractiveHUDVisible(UObject* Object)
+{
+	if (IInteractableInterface* NativeImplementer = GetNativeImplementer(Object, EFunction::IsInteractiveHUDVisible))
+	{
+		return NativeImplementer->IsInteractiveHUDVisible_Implementation();
+	}
+	return IInteractableInterface::Execute_IsInteractiveHUDVisible(Object);
+}
+
+void FInteractableDispatch::StartCheckAndUpdateWidgetVisibleTimer(UObject* Object)
+{
+	if (IInteractableInterface* NativeImplementer = GetNativeImplementer(
+		Object, EFunction::StartCheckAndUpdateWidgetVisibleTimer))
+	{
+		NativeImplementer->StartCheckAndUpdateWidgetVisibleTimer_Implementation();
+		return;
+	}
+	IInteractableInterface::Execute_StartCheckAndUpdateWidgetVisibleTimer(Object);
+}
+
+void FInteractableDispatch::CheckAndUpdateWidgetVisible(UObject* Object)
+{
+	if (IInteractableInterface* NativeImplementer = GetNativeImplementer(Object, EFunction::CheckAndUpdateWidgetVisible))
+	{
+		NativeImplementer->CheckAndUpdateWidgetVisible_Implementation();
+		return;
+	}
+	IInteractableInterface::Execute_CheckAndUpdateWidgetVisible(Object);
+}
+
+void FInteractableDispatch::SetupOutline(UObject* Object)
+{
+	if (IInteractableInterface* NativeImplementer = GetNativeImplementer(Object, EFunction::SetupOutline))
+	{
+		NativeImplementer->SetupOutline_Implementation();
+		return;
+	}
+	IInteractableInterface::Execute_SetupOutline(Object);
+}
+
+FInteractionPrompt FInteractableDispatch::GetInteractionPrompt(UObject* Object)
+{
+	if (IInteractableInterface* NativeImplementer = GetNativeImplementer(Object, EFunction::GetInteractionPrompt))
+	{
+		return NativeImplementer->GetInteractionPrompt_Implementation();
+	}
+	return IInteractableInterface::Execute_GetInteractionPrompt(Object);
+}
+
+const FInteractableDispatch::FClassInfo& FInteractableDispatch::GetClassInfo(const UObject* Object)
+{
+	static TMap<FObjectKey, FClassInfo> ClassInfoCache;
+#if WITH_EDITOR
+	// A recompiled Blueprint keeps its class object and only its instances are replaced, so a reinstance is the
+	// one sign its overrides may have changed
+	static const FDelegateHandle ObjectsReplacedHandle = FCoreUObjectDelegates::OnObjectsReplaced.AddLambda(
+		[](const TMap<UObject*, UObject*>&)
+		{
+			ClassInfoCache.Reset();
+		});
+#endif
+
+	const UClass* Class = Object->GetClass();
+	if (const FClassInfo* CachedClassInfo = ClassInfoCache.Find(Class))
+	{
+		return *CachedClassInfo;
+	}
+
+	FClassInfo ClassInfo;
+	ClassInfo.IsInteractable = Class->ImplementsInterface(UInteractableInterface::StaticClass());
+	if (ClassInfo.IsInteractable)
+	{
+		if (const void* NativeInterface = Object->GetNativeInterfaceAddress(UInteractableInterface::StaticClass()))
+		{
+			ClassInfo.NativeInterfaceOffset = static_cast<int32>(
+				static_cast<const uint8*>(NativeInterface) - reinterpret_cast<const uint8*>(Object));
+		}
+
+		const FName FunctionNames[] = {
+			GET_FUNCTION_NAME_CHECKED(IInteractableInterface, Interact),
+			GET_FUNCTION_NAME_CHECKED(IInteractableInterface, IsEnable),
+			GET_FUNCTION_NAME_CHECKED(IInteractableInterface, ToggleOutline),
+			GET_FUNCTION_NAME_CHECKED(IInteractableInterface, IsInteractiveHUDVisible),
+			GET_FUNCTION_NAME_CHECKED(IInteractableInterface, StartCheckAndUpdateWidgetVisibleTimer),
+			GET_FUNCTION_NAME_CHECKED(IInteractableInterface, CheckAndUpdateWidgetVisible),
+			GET_FUNCTION_NAME_CHECKED(IInteractableInterface, SetupOutline),
+			GET_FUNCTION_NAME_CHECKED(IInteractableInterface, GetInteractionPrompt),
+		};
+		for (int32 FunctionIndex = 0; FunctionIndex < UE_ARRAY_COUNT(FunctionNames); FunctionIndex++)
+		{
+			// The interface's own UFunction is native, a Blueprint override is a script function
+			const UFunction* Function = Class->FindFunctionByName(FunctionNames[FunctionIndex]);
+			if (Function && !Function->HasAnyFunctionFlags(FUNC_Native))
+			{
+				ClassInfo.BlueprintOverrideMask |= static_cast<uint8>(1 << FunctionIndex);
+			}
+		}
+	}
+	return ClassInfoCache.Add(Class, ClassInfo);
+}
+
+IInteractableInterface* FInteractableDispatch::GetNativeImplementer(UObject* Object, EFunction Function)
+{
+	const FClassInfo& ClassInfo = GetClassInfo(Object);
+	if (ClassInfo.NativeInterfaceOffset == INDEX_NONE
+		|| ClassInfo.BlueprintOverrideMask & (1 << static_cast<uint8>(Function)))
+	{
+		return nullptr;
+	}
+	return reinterpret_cast<IInteractableInterface*>(reinterpret_cast<uint8*>(Object) + ClassInfo.NativeInterfaceOffset);
+}
+
+static FAutoConsoleCommandWithWorldAndArgs BenchmarkInteractableDispatchCommand(
+	TEXT("Osu.Interactable.BenchmarkDispatch"),
+	TEXT("Compares Execute_ thunks with FInteractableDispatch on every interactable in the world. Args: [Iterations]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		const int32 Iterations = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 10000;
+
+		TArray<AActor*> Interactables;
+		for (TActorIterator<AActor> It(World); It; ++It)
+		{
+			if (FInteractableDispatch::IsInteractable(*It))
+			{
+				Interactables.Add(*It);
+			}
+		}
+		if (Interactables.IsEmpty())
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Osu.Interactable.BenchmarkDispatch: no interactable in the world"));
+			return;
+		}
+
+		// Only the side effect free queries the highlight timer runs, so the benchmark does not change game state
+		int32 EnabledCount = 0;
+		double StartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < Iterations; Iteration++)
+		{
+			for (AActor* Interactable : Interactables)
+			{
+				EnabledCount += IInteractableInterface::Execute_IsEnable(Interactable);
+				EnabledCount += IInteractableInterface::Execute_IsInteractiveHUDVisible(Interactable);
+			}
+		}
+		const double ExecuteTime = FPlatformTime::Seconds() - StartTime;
+
+		StartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < Iterations; Iteration++)
+		{
+			for (AActor* Interactable : Interactables)
+			{
+				EnabledCount += FInteractableDispatch::IsEnable(Interactable);
+				EnabledCount += FInteractableDispatch::IsInteractiveHUDVisible(Interactable);
+			}
+		}
+		const double DispatchTime = FPlatformTime::Seconds() - StartTime;
+
+		const double CallCount = 2.0 * Iterations * Interactables.Num();
+		UE_LOG(LogTemp, Display,
+		       TEXT("Osu.Interactable.BenchmarkDispatch: %d interactables, %d iterations (checksum %d)"),
+		       Interactables.Num(), Iterations, EnabledCount);
+		UE_LOG(LogTemp, Display, TEXT("  Execute_ thunks:        %8.2f ns/call"), ExecuteTime * 1e9 / CallCount);
+		UE_LOG(LogTemp, Display, TEXT("  FInteractableDispatch: %8.2f ns/call"), DispatchTime * 1e9 / CallCount);
+	}));
@@ -1,6 +1,7 @@
 ﻿#pragma once
 
 #include "CoreMinimal.h"
+#include "ThePathOfOsu/OsuType.h"
 #include "ThePathOfOsu/PlayerCharacter.h"
 #include "UObject/Interface.h"
 #include "InteractableInterface.generated.h"
@@ -36,4 +37,52 @@ public:
 	
 	UFUNCTION(BlueprintCallable, BlueprintNativeEvent, Category = "Interactable")
 	void SetupOutline();
+
+	UFUNCTION(BlueprintCallable, BlueprintNativeEvent, Category = "Interactable")
+	FInteractionPrompt GetInteractionPrompt();
+};
+
+/**
+ * Calls IInteractableInterface without going through the Execute_ thunks when possible.
+ * Native implementers are called through their _Implementation virtuals, Blueprint-only implementers
+ * and Blueprint overrides of native implementers fall back to Execute_.
+ */
+class THEPATHOFOSU_API FInteractableDispatch
+{
+public:
+	static bool IsInteractable(const UObject* Object);
+
+	static void Interact(UObject* Object, APlayerCharacter* InteractPlayerCharacter);
+	static bool IsEnable(UObject* Object);
+	static void ToggleOutline(UObject* Object, bool bValue);
+	static bool IsInteractiveHUDVisible(UObject* Object);
+	static void StartCheckAndUpdateWidgetVisibleTimer(UObject* Object);
+	static void CheckAndUpdateWidgetVisible(UObject* Object);
+	static void SetupOutline(UObject* Object);
+	static FInteractionPrompt GetInteractionPrompt(UObject* Object);
+
+private:
+	enum class EFunction : uint8
+	{
+		Interact,
+		IsEnable,
+		ToggleOutline,
+		IsInteractiveHUDVisible,
+		StartCheckAndUpdateWidgetVisibleTimer,
+		CheckAndUpdateWidgetVisible,
+		SetupOutline,
+		GetInteractionPrompt,
+	};
+
+	struct FClassInfo
+	{
+		bool IsInteractable = false;
+		// Byte offset of the native IInteractableInterface inside the object, INDEX_NONE for Blueprint-only implementers
+		int32 NativeInterfaceOffset = INDEX_NONE;
+		// One bit per EFunction, set when a Blueprint class overrides the native implementation
+		uint8 BlueprintOverrideMask = 0;
+	};
+
+	static const FClassInfo& GetClassInfo(const UObject* Object);
+	static IInteractableInterface* GetNativeImplementer(UObject* Object, EFunction Function);
 };
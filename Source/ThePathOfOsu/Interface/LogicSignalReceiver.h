@@ -0,0 +1,23 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Interface.h"
+#include "LogicSignalReceiver.generated.h"
+
+UINTERFACE(MinimalAPI, meta = (CannotImplementInterfaceInBlueprint))
+class ULogicSignalReceiver : public UInterface
+{
+	GENERATED_BODY()
+};
+
+/**
+ * Actors and actor components an ALevelLogicGraph sink can drive, such as doors and transporters
+ */
+class THEPATHOFOSU_API ILogicSignalReceiver
+{
+	GENERATED_BODY()
+
+public:
+	// Only called when the sink's value changes, not when a save is restored
+	virtual void ReceiveLogicSignal(bool Value) = 0;
+};
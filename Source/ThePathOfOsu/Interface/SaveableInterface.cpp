@@ -0,0 +1,8 @@
+﻿#include "SaveableInterface.h"
+
+#include "Serialization/CustomVersion.h"
+
+const FGuid FOsuSaveVersion::GUID(0x6A3D2F1B, 0x4C8E47A5, 0x9B0E5D71, 0xE28C4F36);
+
+static FCustomVersionRegistration GRegisterOsuSaveVersion(FOsuSaveVersion::GUID, FOsuSaveVersion::LatestVersion,
+                                                          TEXT("OsuSave"));
@@ -0,0 +1,46 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Interface.h"
+#include "SaveableInterface.generated.h"
+
+// Bump LatestVersion when a SerializeState implementation changes its layout and branch on Ar.CustomVer(GUID)
+struct THEPATHOFOSU_API FOsuSaveVersion
+{
+	enum Type
+	{
+		Initial = 1,
+		// Missions save their progress count instead of a completed flag
+		MissionProgress = 2,
+		// Snapshots store the version of every object state, cell store entries keep the one they were written with
+		PerObjectVersion = 3,
+
+		VersionPlusOne,
+		LatestVersion = VersionPlusOne - 1
+	};
+
+	static const FGuid GUID;
+};
+
+UINTERFACE(MinimalAPI, meta = (CannotImplementInterfaceInBlueprint))
+class USaveableInterface : public UInterface
+{
+	GENERATED_BODY()
+};
+
+/**
+ * Actors and actor components that carry state worth keeping across a save or a retry.
+ * Level placed objects and their default subobjects are matched by path. Actors spawned at runtime get a new
+ * name every run, so they return a save id instead, which also keys their components.
+ */
+class THEPATHOFOSU_API ISaveableInterface
+{
+	GENERATED_BODY()
+
+public:
+	// Reads when Ar.IsLoading(), writes otherwise. Loading must not replay effects like sounds or pickups
+	virtual void SerializeState(FArchive& Ar) = 0;
+
+	// Unique within a world, NAME_None for level placed actors
+	virtual FName GetSaveId() const { return NAME_None; }
+};
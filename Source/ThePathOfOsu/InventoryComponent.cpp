@@ -0,0 +1,287 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "InventoryComponent.h"
+
+#include "Item.h"
+#include "OxCharacter.h"
+
+namespace
+{
+	using FItemEffectFunction = bool (*)(AActor* Owner, const UItem& Item);
+
+	struct FItemEffectEntry
+	{
+		FItemEffectFunction OnAcquire;
+		FItemEffectFunction OnUse;
+		bool IsConsumedOnUse;
+	};
+
+	bool HealOwner(AActor* Owner, const UItem& Item)
+	{
+		AOxCharacter* Character = Cast<AOxCharacter>(Owner);
+		if (!Character)
+		{
+			return false;
+		}
+		Character->Heal(Character->MaxHp * Item.EffectMagnitude);
+		return true;
+	}
+
+	bool EquipOwnerPistol(AActor* Owner, const UItem& Item)
+	{
+		AOxCharacter* Character = Cast<AOxCharacter>(Owner);
+		if (!Character)
+		{
+			return false;
+		}
+		Character->GetWeaponSystemComponent()->AcquirePistol();
+		return true;
+	}
+
+	bool EquipOwnerRifle(AActor* Owner, const UItem& Item)
+	{
+		AOxCharacter* Character = Cast<AOxCharacter>(Owner);
+		if (!Character)
+		{
+			return false;
+		}
+		Character->GetWeaponSystemComponent()->AcquireRifle();
+		return true;
+	}
+
+	// Indexed by EItemEffect
+	constexpr FItemEffectEntry ItemEffectTable[] = {
+		{nullptr, nullptr, false},
+		{nullptr, &HealOwner, true},
+		{&EquipOwnerPistol, &EquipOwnerPistol, false},
+		{&EquipOwnerRifle, &EquipOwnerRifle, false},
+	};
+	constexpr int32 ItemEffectCount = UE_ARRAY_COUNT(ItemEffectTable);
+	static_assert(ItemEffectCount == static_cast<int32>(EItemEffect::Count),
+		"ItemEffectTable must have one entry per EItemEffect");
+
+	const FItemEffectEntry& GetItemEffect(const UItem& Item)
+	{
+		const int32 EffectIndex = static_cast<int32>(Item.Effect);
+		return ItemEffectTable[EffectIndex < ItemEffectCount ? EffectIndex : 0];
+	}
+}
+
+UInventoryComponent::UInventoryComponent()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+}
+
+int32 UInventoryComponent::FindHandle(const UItem* Item) const
+{
+	return Item ? FindHandle(GetItemId(Item)) : INDEX_NONE;
+}
+
+int32 UInventoryComponent::FindHandle(const FPrimaryAssetId& ItemId) const
+{
+	const int32* Handle = HandleByItemId.Find(ItemId);
+	return Handle ? *Handle : INDEX_NONE;
+}
+
+int32 UInventoryComponent::GetItemCountByHandle(int32 Handle) const
+{
+	return Slots.IsValidIndex(Handle) ? Slots[Handle].Count : 0;
+}
+
+int32 UInventoryComponent::GetItemCount(const UItem* Item) const
+{
+	return GetItemCountByHandle(FindHandle(Item));
+}
+
+bool UInventoryComponent::HasItem(const UItem* Item) const
+{
+	return GetItemCount(Item) > 0;
+}
+
+bool UInventoryComponent::AddItem(UItem* NewItem, int32 ItemCount)
+{
+	if (!NewItem)
+	{
+		GEngine->AddOnScreenDebugMessage(-1, 15.0f, FColor::Red,
+		                                 FString::Printf(TEXT("AddItem: Failed trying to add null item!")));
+		return false;
+	}
+	if (ItemCount <= 0)
+	{
+		GEngine->AddOnScreenDebugMessage(-1, 15.0f, FColor::Red,
+		                                 FString::Printf(TEXT("AddItem: ItemCount must be greater than 0!")));
+		return false;
+	}
+
+	const FPrimaryAssetId ItemId = GetItemId(NewItem);
+	int32 Handle = FindHandle(ItemId);
+	if (Handle == INDEX_NONE)
+	{
+		Handle = Slots.Add({ItemId, NewItem, 0});
+		HandleByItemId.Add(ItemId, Handle);
+	}
+
+	const int32 MaxCount = NewItem->MaxCount > 0 ? NewItem->MaxCount : MAX_int32;
+	const int32 OldCount = Slots[Handle].Count;
+	SetSlotCount(Handle, FMath::Clamp(OldCount + ItemCount, 1, MaxCount));
+
+	const FItemEffectEntry& Effect = GetItemEffect(*NewItem);
+	if (OldCount == 0 && Effect.OnAcquire)
+	{
+		Effect.OnAcquire(GetOwner(), *NewItem);
+	}
+	return true;
+}
+
+bool UInventoryComponent::RemoveItem(UItem* RemovedItem, int32 RemoveCount)
+{
+	if (!RemovedItem)
+	{
+		GEngine->AddOnScreenDebugMessage(-1, 15.0f, FColor::Red,
+		                                 FString::Printf(TEXT("RemoveItem: Failed trying to remove null item!")));
+		return false;
+	}
+
+	const int32 Handle = FindHandle(RemovedItem);
+	const int32 ItemCount = GetItemCountByHandle(Handle);
+	if (ItemCount <= 0)
+	{
+		GEngine->AddOnScreenDebugMessage(-1, 15.0f, FColor::Red,
+		                                 FString::Printf(TEXT("RemoveItem: Failed trying to remove item with 0 count!")));
+		return false;
+	}
+
+	SetSlotCount(Handle, RemoveCount <= 0 ? 0 : FMath::Max(0, ItemCount - RemoveCount));
+	return true;
+}
+
+bool UInventoryComponent::UseItem(UItem* Item)
+{
+	if (GetItemCount(Item) <= 0)
+	{
+		GEngine->AddOnScreenDebugMessage(-1, 15.0f, FColor::Red, FString::Printf(TEXT("No Item in Inventory")));
+		return false;
+	}
+
+	const FItemEffectEntry& Effect = GetItemEffect(*Item);
+	if (!Effect.OnUse)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Item %s has no use effect"), *Item->GetName());
+		return false;
+	}
+	if (!Effect.OnUse(GetOwner(), *Item))
+	{
+		return false;
+	}
+	return !Effect.IsConsumedOnUse || RemoveItem(Item, 1);
+}
+
+const TArray<FInventorySlot>& UInventoryComponent::GetSlots() const
+{
+	return Slots;
+}
+
+void UInventoryComponent::SerializeState(FArchive& Ar)
+{
+	int32 SlotCount = Slots.Num();
+	Ar << SlotCount;
+	if (!Ar.IsLoading())
+	{
+		for (FInventorySlot& Slot : Slots)
+		{
+			FSoftObjectPath ItemPath(Slot.Item);
+			Ar << ItemPath << Slot.Count;
+		}
+		return;
+	}
+
+	// Slots are never removed so existing handles stay valid, items missing from the save drop to zero
+	TArray<int32> NewCounts;
+	NewCounts.Init(0, Slots.Num());
+	for (int32 Index = 0; Index < SlotCount && !Ar.IsError(); ++Index)
+	{
+		FSoftObjectPath ItemPath;
+		int32 Count = 0;
+		Ar << ItemPath << Count;
+
+		UItem* Item = Cast<UItem>(ItemPath.ResolveObject());
+		if (!Item)
+		{
+			// Items are usually already loaded by the pickups that reference them
+			Item = Cast<UItem>(ItemPath.TryLoad());
+		}
+		if (!Item)
+		{
+			UE_LOG(LogTemp, Error, TEXT("Saved item %s could not be loaded"), *ItemPath.ToString());
+			continue;
+		}
+
+		const FPrimaryAssetId ItemId = GetItemId(Item);
+		int32 Handle = FindHandle(ItemId);
+		if (Handle == INDEX_NONE)
+		{
+			Handle = Slots.Add({ItemId, Item, 0});
+			HandleByItemId.Add(ItemId, Handle);
+			NewCounts.Add(0);
+		}
+		NewCounts[Handle] = FMath::Max(0, Count);
+	}
+	for (int32 Handle = 0; Handle < Slots.Num(); ++Handle)
+	{
+		SetSlotCount(Handle, NewCounts[Handle]);
+	}
+}
+
+FPrimaryAssetId UInventoryComponent::GetItemId(const UItem* Item)
+{
+	const FPrimaryAssetId ItemId = Item->GetPrimaryAssetId();
+	// Items created at runtime have no asset id, fall back to their object name
+	return ItemId.IsValid() ? ItemId : FPrimaryAssetId(Item->GetClass()->GetFName(), Item->GetFName());
+}
+
+void UInventoryComponent::SetSlotCount(int32 Handle, int32 NewCount)
+{
+	FInventorySlot& Slot = Slots[Handle];
+	if (Slot.Count == NewCount)
+	{
+		return;
+	}
+
+	if (!PendingChanges.ContainsByPredicate([Handle](const FPendingChange& Change) { return Change.Handle == Handle; }))
+	{
+		PendingChanges.Add({Handle, Slot.Count});
+	}
+	Slot.Count = NewCount;
+
+	if (!IsFlushScheduled)
+	{
+		IsFlushScheduled = true;
+		GetWorld()->GetTimerManager().SetTimerForNextTick(this, &UInventoryComponent::FlushPendingChanges);
+	}
+}
+
+void UInventoryComponent::FlushPendingChanges()
+{
+	IsFlushScheduled = false;
+	TArray<FPendingChange> Changes = MoveTemp(PendingChanges);
+	PendingChanges.Reset();
+
+	for (const FPendingChange& Change : Changes)
+	{
+		const FInventorySlot& Slot = Slots[Change.Handle];
+		if (Slot.Count == Change.OldCount)
+		{
+			continue;
+		}
+		if (Change.OldCount == 0)
+		{
+			OnItemAdded.Broadcast(Slot.Item, Slot.Count);
+		}
+		else if (Slot.Count == 0)
+		{
+			OnItemRemoved.Broadcast(Slot.Item, Slot.Count);
+		}
+		OnItemCountChanged.Broadcast(Slot.Item, Slot.Count);
+	}
+}
@@ -0,0 +1,95 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "Interface/SaveableInterface.h"
+#include "InventoryComponent.generated.h"
+
+class UItem;
+
+USTRUCT(BlueprintType)
+struct THEPATHOFOSU_API FInventorySlot
+{
+	GENERATED_BODY()
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	FPrimaryAssetId ItemId;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	UItem* Item = nullptr;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	int32 Count = 0;
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnInventoryItemEvent, UItem*, Item, int32, NewCount);
+
+/**
+ * Item counts keyed by primary asset id. Each item type gets one slot the first time it is added and keeps it,
+ * so the slot index doubles as a stable integer handle. Change events are collected and broadcast once
+ * per item on the next tick, however many times its count changed in between.
+ */
+UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
+class THEPATHOFOSU_API UInventoryComponent : public UActorComponent, public ISaveableInterface
+{
+	GENERATED_BODY()
+
+public:
+	UInventoryComponent();
+
+	// INDEX_NONE when the item type has never been added
+	int32 FindHandle(const UItem* Item) const;
+	int32 FindHandle(const FPrimaryAssetId& ItemId) const;
+	int32 GetItemCountByHandle(int32 Handle) const;
+
+	UFUNCTION(BlueprintPure, Category = "Inventory")
+	int32 GetItemCount(const UItem* Item) const;
+
+	UFUNCTION(BlueprintPure, Category = "Inventory")
+	bool HasItem(const UItem* Item) const;
+
+	UFUNCTION(BlueprintCallable, Category = "Inventory")
+	bool AddItem(UItem* NewItem, int32 ItemCount = 1);
+
+	// RemoveCount <= 0 removes every item of the type
+	UFUNCTION(BlueprintCallable, Category = "Inventory")
+	bool RemoveItem(UItem* RemovedItem, int32 RemoveCount = 1);
+
+	UFUNCTION(BlueprintCallable, Category = "Inventory")
+	bool UseItem(UItem* Item);
+
+	const TArray<FInventorySlot>& GetSlots() const;
+
+	// Items are written as soft object paths, loading sets counts without replaying acquire effects
+	virtual void SerializeState(FArchive& Ar) override;
+
+	UPROPERTY(BlueprintAssignable)
+	FOnInventoryItemEvent OnItemAdded;
+
+	UPROPERTY(BlueprintAssignable)
+	FOnInventoryItemEvent OnItemRemoved;
+
+	UPROPERTY(BlueprintAssignable)
+	FOnInventoryItemEvent OnItemCountChanged;
+
+private:
+	UPROPERTY(VisibleAnywhere, Category = "Inventory")
+	TArray<FInventorySlot> Slots;
+
+	TMap<FPrimaryAssetId, int32> HandleByItemId;
+
+	struct FPendingChange
+	{
+		int32 Handle;
+		int32 OldCount;
+	};
+
+	TArray<FPendingChange> PendingChanges;
+	bool IsFlushScheduled = false;
+
+	static FPrimaryAssetId GetItemId(const UItem* Item);
+	void SetSlotCount(int32 Handle, int32 NewCount);
+	void FlushPendingChanges();
+};
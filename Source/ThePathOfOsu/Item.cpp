@@ -18,3 +18,41 @@ FPrimaryAssetId UItem::GetPrimaryAssetId() const
 	return Super::GetPrimaryAssetId();
 }
 
+namespace
+{
+	struct FLegacyItemEffect
+	{
+		const TCHAR* AssetName;
+		EItemEffect Effect;
+	};
+
+	// Items saved before Effect existed got their behavior from the player: the vinegar heal on use and the
+	// weapons equipped by name
+	constexpr FLegacyItemEffect LegacyItemEffects[] = {
+		{TEXT("DA_Vinegar"), EItemEffect::Heal},
+		{TEXT("DA_Pistol"), EItemEffect::EquipPistol},
+		{TEXT("DA_Rifle"), EItemEffect::EquipRifle},
+	};
+}
+
+void UItem::PostLoad()
+{
+	Super::PostLoad();
+	if (Effect != EItemEffect::None)
+	{
+		return;
+	}
+
+	const FName AssetName = GetFName();
+	for (const FLegacyItemEffect& LegacyItemEffect : LegacyItemEffects)
+	{
+		if (AssetName == LegacyItemEffect.AssetName)
+		{
+			Effect = LegacyItemEffect.Effect;
+			UE_LOG(LogTemp, Warning, TEXT("%s has no Effect set, using %s until the asset is re-saved"),
+			       *GetName(), *UEnum::GetValueAsString(Effect));
+			return;
+		}
+	}
+}
+
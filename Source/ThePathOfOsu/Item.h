@@ -4,8 +4,11 @@
 
 #include "CoreMinimal.h"
 #include "Engine/DataAsset.h"
+#include "OsuType.h"
 #include "Item.generated.h"
 
+class UTexture2D;
+
 UCLASS()
 class THEPATHOFOSU_API UItem : public UPrimaryDataAsset
 {
@@ -14,6 +17,9 @@ class THEPATHOFOSU_API UItem : public UPrimaryDataAsset
 public:
 	UItem()
 		: MaxCount(1)
+		, Icon(nullptr)
+		, Effect(EItemEffect::None)
+		, EffectMagnitude(0.5f)
 	{
 	}
 
@@ -26,6 +32,18 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Item")
 	int32 MaxCount;
 
+	// Shown by the player's interaction prompt when a pickup of this item is focused
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Item")
+	UTexture2D* Icon;
+
+	// What acquiring or using the item does, dispatched by UInventoryComponent
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Item")
+	EItemEffect Effect;
+
+	// Heal: fraction of max hp restored
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Item")
+	float EffectMagnitude;
+
 	UFUNCTION(BlueprintCallable, BlueprintPure)
 	bool IsConsumable() const;
 
@@ -34,4 +52,7 @@ public:
 	FString GetIdentifierString() const;
 
 	virtual FPrimaryAssetId GetPrimaryAssetId() const override;
+
+protected:
+	virtual void PostLoad() override;
 };
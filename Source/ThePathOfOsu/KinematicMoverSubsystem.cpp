@@ -0,0 +1,141 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "KinematicMoverSubsystem.h"
+
+#include "OsuFrameArena.h"
+
+void FKinematicMoverTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread,
+                                              const FGraphEventRef& MyCompletionGraphEvent)
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_KinematicMoverTick);
+	if (Subsystem)
+	{
+		Subsystem->Tick(DeltaTime);
+	}
+}
+
+FString FKinematicMoverTickFunction::DiagnosticMessage()
+{
+	return TEXT("UKinematicMoverSubsystem::Tick");
+}
+
+FName FKinematicMoverTickFunction::DiagnosticContext(bool bDetailed)
+{
+	return TEXT("KinematicMoverSubsystem");
+}
+
+void UKinematicMoverSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+	TickFunction.Subsystem = this;
+	TickFunction.TickGroup = TG_PrePhysics;
+	TickFunction.bCanEverTick = true;
+	TickFunction.bHighPriority = true;
+	TickFunction.SetTickFunctionEnable(!Moves.IsEmpty());
+	TickFunction.RegisterTickFunction(InWorld.PersistentLevel);
+}
+
+void UKinematicMoverSubsystem::Deinitialize()
+{
+	if (TickFunction.IsTickFunctionRegistered())
+	{
+		TickFunction.UnRegisterTickFunction();
+	}
+	TickFunction.Subsystem = nullptr;
+	Super::Deinitialize();
+}
+
+void UKinematicMoverSubsystem::AddTickPrerequisiteTo(FTickFunction& Dependent)
+{
+	Dependent.AddPrerequisite(this, TickFunction);
+}
+
+void UKinematicMoverSubsystem::StartMove(USceneComponent* Component, const FVector& TargetRelativeLocation,
+                                         const FRotator& TargetRelativeRotation, float Duration,
+                                         EEasingFunc::Type Easing, FSimpleDelegate OnFinished)
+{
+	if (!Component)
+	{
+		UE_LOG(LogTemp, Error, TEXT("StartMove: Component is null"));
+		return;
+	}
+
+	StopMove(Component);
+	if (Duration <= 0.0f)
+	{
+		Component->SetRelativeLocationAndRotation(TargetRelativeLocation, TargetRelativeRotation);
+		OnFinished.ExecuteIfBound();
+		return;
+	}
+
+	FKinematicMove& Move = Moves.AddDefaulted_GetRef();
+	Move.Component = Component;
+	Move.StartLocation = Component->GetRelativeLocation();
+	Move.TargetLocation = TargetRelativeLocation;
+	Move.StartRotation = Component->GetRelativeRotation().Quaternion();
+	Move.TargetRotation = TargetRelativeRotation.Quaternion();
+	Move.StartTime = GetWorld()->GetTimeSeconds();
+	Move.Duration = Duration;
+	Move.Easing = Easing;
+	Move.OnFinished = MoveTemp(OnFinished);
+	TickFunction.SetTickFunctionEnable(true);
+}
+
+void UKinematicMoverSubsystem::StopMove(const USceneComponent* Component)
+{
+	const int32 Index = FindMove(Component);
+	if (Index != INDEX_NONE)
+	{
+		Moves.RemoveAtSwap(Index);
+	}
+}
+
+bool UKinematicMoverSubsystem::IsMoving(const USceneComponent* Component) const
+{
+	return FindMove(Component) != INDEX_NONE;
+}
+
+void UKinematicMoverSubsystem::Tick(float DeltaTime)
+{
+	const double Now = GetWorld()->GetTimeSeconds();
+	// Called after the pass, a callback may start the next move
+	TOsuFrameArray<FSimpleDelegate> FinishedCallbacks;
+	for (int32 Index = Moves.Num() - 1; Index >= 0; --Index)
+	{
+		FKinematicMove& Move = Moves[Index];
+		USceneComponent* Component = Move.Component.Get();
+		if (!Component)
+		{
+			Moves.RemoveAtSwap(Index);
+			continue;
+		}
+
+		const float Alpha = FMath::Clamp(static_cast<float>((Now - Move.StartTime) / Move.Duration), 0.0f, 1.0f);
+		const float EasedAlpha = UKismetMathLibrary::Ease(0.0f, 1.0f, Alpha, Move.Easing);
+		Component->SetRelativeLocationAndRotation(FMath::Lerp(Move.StartLocation, Move.TargetLocation, EasedAlpha),
+		                                          FQuat::Slerp(Move.StartRotation, Move.TargetRotation, EasedAlpha));
+		if (Alpha >= 1.0f)
+		{
+			FinishedCallbacks.Add(MoveTemp(Move.OnFinished));
+			Moves.RemoveAtSwap(Index);
+		}
+	}
+
+	for (const FSimpleDelegate& OnFinished : FinishedCallbacks)
+	{
+		OnFinished.ExecuteIfBound();
+	}
+	if (Moves.IsEmpty())
+	{
+		TickFunction.SetTickFunctionEnable(false);
+	}
+}
+
+int32 UKinematicMoverSubsystem::FindMove(const USceneComponent* Component) const
+{
+	return Moves.IndexOfByPredicate([Component](const FKinematicMove& Move)
+	{
+		return Move.Component.Get() == Component;
+	});
+}
@@ -0,0 +1,70 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/KismetMathLibrary.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "KinematicMoverSubsystem.generated.h"
+
+class UKinematicMoverSubsystem;
+
+struct FKinematicMoverTickFunction : public FTickFunction
+{
+	UKinematicMoverSubsystem* Subsystem = nullptr;
+
+	virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread,
+	                         const FGraphEventRef& MyCompletionGraphEvent) override;
+	virtual FString DiagnosticMessage() override;
+	virtual FName DiagnosticContext(bool bDetailed) override;
+};
+
+/**
+ * Moves scene components between two relative transforms over a fixed duration. Each frame the pose is evaluated
+ * from the start time and easing, not accumulated, and written with one transform update per component.
+ * The batch runs from its own TG_PrePhysics tick function, which character movement waits for, so a character
+ * standing on a lift moves with the lift's pose of the same frame. It is only enabled while a move is running.
+ */
+UCLASS()
+class THEPATHOFOSU_API UKinematicMoverSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+
+	// Replaces any move already running on Component. OnFinished is not called for a move that was stopped
+	void StartMove(USceneComponent* Component, const FVector& TargetRelativeLocation,
+	               const FRotator& TargetRelativeRotation, float Duration,
+	               EEasingFunc::Type Easing = EEasingFunc::Linear, FSimpleDelegate OnFinished = FSimpleDelegate());
+
+	// Leaves Component where the move got to
+	void StopMove(const USceneComponent* Component);
+
+	bool IsMoving(const USceneComponent* Component) const;
+
+	// Makes Dependent, such as a movement component's tick, run after the moves of the frame
+	void AddTickPrerequisiteTo(FTickFunction& Dependent);
+
+	void Tick(float DeltaTime);
+
+private:
+	struct FKinematicMove
+	{
+		TWeakObjectPtr<USceneComponent> Component;
+		FVector StartLocation;
+		FVector TargetLocation;
+		FQuat StartRotation;
+		FQuat TargetRotation;
+		double StartTime;
+		float Duration;
+		EEasingFunc::Type Easing;
+		FSimpleDelegate OnFinished;
+	};
+
+	int32 FindMove(const USceneComponent* Component) const;
+
+	TArray<FKinematicMove> Moves;
+	FKinematicMoverTickFunction TickFunction;
+};
@@ -0,0 +1,385 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "LevelLogicGraph.h"
+
+#include "EngineUtils.h"
+#include "OsuEventBusSubsystem.h"
+#include "OsuSchedulerSubsystem.h"
+#include "Interface/LogicSignalReceiver.h"
+
+ALevelLogicGraph::ALevelLogicGraph()
+{
+	PrimaryActorTick.bCanEverTick = false;
+}
+
+void ALevelLogicGraph::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (Compile() && !SourceNodes.IsEmpty())
+	{
+		LogicSignalHandle = GetWorld()->GetSubsystem<UOsuEventBusSubsystem>()->Subscribe(
+			this, &ALevelLogicGraph::OnLogicSignal);
+	}
+}
+
+void ALevelLogicGraph::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UOsuEventBusSubsystem* EventBus = GetWorld()->GetSubsystem<UOsuEventBusSubsystem>())
+	{
+		EventBus->Unsubscribe<FLogicSignalEvent>(LogicSignalHandle);
+	}
+	CancelTimers();
+	Super::EndPlay(EndPlayReason);
+}
+
+bool ALevelLogicGraph::Compile()
+{
+	const int32 NodeCount = Nodes.Num();
+	TMap<FName, int32> AuthoredIndices;
+	for (int32 Node = 0; Node < NodeCount; Node++)
+	{
+		if (Nodes[Node].Name.IsNone() || AuthoredIndices.Contains(Nodes[Node].Name))
+		{
+			return ReportError(FString::Printf(TEXT("Node %d has no name or a duplicate one"), Node));
+		}
+		AuthoredIndices.Add(Nodes[Node].Name, Node);
+	}
+
+	// Dependents as CSR arrays over the authored indices, then Kahn's algorithm for the evaluation order
+	TArray<int32> PendingInputs;
+	PendingInputs.SetNumZeroed(NodeCount);
+	TArray<int32> DependentStarts;
+	DependentStarts.SetNumZeroed(NodeCount + 1);
+	for (int32 Node = 0; Node < NodeCount; Node++)
+	{
+		const FLevelLogicNode& Desc = Nodes[Node];
+		const int32 InputCount = Desc.Inputs.Num();
+		const bool ValidInputCount =
+			Desc.Type == ELevelLogicNodeType::Source ? InputCount == 0
+			: Desc.Type == ELevelLogicNodeType::Latch ? InputCount == 1 || InputCount == 2
+			: Desc.Type == ELevelLogicNodeType::Timer || Desc.Type == ELevelLogicNodeType::Sink ? InputCount == 1
+			: InputCount > 0;
+		if (!ValidInputCount)
+		{
+			return ReportError(FString::Printf(TEXT("Node %s has %d inputs"), *Desc.Name.ToString(), InputCount));
+		}
+		for (const FName& Input : Desc.Inputs)
+		{
+			const int32* InputIndex = AuthoredIndices.Find(Input);
+			if (!InputIndex)
+			{
+				return ReportError(FString::Printf(TEXT("Node %s reads unknown node %s"), *Desc.Name.ToString(),
+				                                   *Input.ToString()));
+			}
+			DependentStarts[*InputIndex + 1]++;
+			PendingInputs[Node]++;
+		}
+	}
+	for (int32 Node = 0; Node < NodeCount; Node++)
+	{
+		DependentStarts[Node + 1] += DependentStarts[Node];
+	}
+	TArray<int32> Dependents;
+	Dependents.SetNumUninitialized(DependentStarts.Last());
+	TArray<int32> DependentCursors(DependentStarts.GetData(), NodeCount);
+	for (int32 Node = 0; Node < NodeCount; Node++)
+	{
+		for (const FName& Input : Nodes[Node].Inputs)
+		{
+			Dependents[DependentCursors[AuthoredIndices[Input]]++] = Node;
+		}
+	}
+
+	TArray<int32> Order;
+	Order.Reserve(NodeCount);
+	for (int32 Node = 0; Node < NodeCount; Node++)
+	{
+		if (PendingInputs[Node] == 0)
+		{
+			Order.Add(Node);
+		}
+	}
+	for (int32 Cursor = 0; Cursor < Order.Num(); Cursor++)
+	{
+		const int32 Node = Order[Cursor];
+		for (int32 Index = DependentStarts[Node]; Index < DependentStarts[Node + 1]; Index++)
+		{
+			if (--PendingInputs[Dependents[Index]] == 0)
+			{
+				Order.Add(Dependents[Index]);
+			}
+		}
+	}
+	if (Order.Num() != NodeCount)
+	{
+		return ReportError(FString::Printf(TEXT("%d nodes form a cycle"), NodeCount - Order.Num()));
+	}
+
+	for (int32 Node = 0; Node < NodeCount; Node++)
+	{
+		NodeIndices.Add(Nodes[Order[Node]].Name, Node);
+	}
+	CompiledNodes.Reserve(NodeCount);
+	for (const int32 Authored : Order)
+	{
+		const FLevelLogicNode& Desc = Nodes[Authored];
+		const int32 Node = CompiledNodes.Num();
+		FCompiledNode& Compiled = CompiledNodes.AddDefaulted_GetRef();
+		Compiled.Name = Desc.Name;
+		Compiled.Type = Desc.Type;
+		Compiled.FirstInput = InputNodes.Num();
+		Compiled.InputCount = Desc.Inputs.Num();
+		Compiled.FirstReceiver = Receivers.Num();
+		Compiled.Duration = Desc.Duration;
+		for (const FName& Input : Desc.Inputs)
+		{
+			InputNodes.Add(NodeIndices[Input]);
+		}
+
+		if (Desc.Type == ELevelLogicNodeType::Source && Desc.Actor)
+		{
+			SourceNodes.Add(FObjectKey(Desc.Actor), Node);
+		}
+		else if (Desc.Type == ELevelLogicNodeType::Sink && Desc.Actor)
+		{
+			if (Desc.Actor->Implements<ULogicSignalReceiver>())
+			{
+				Receivers.Add(Desc.Actor);
+			}
+			for (UActorComponent* Component : Desc.Actor->GetComponents())
+			{
+				if (Component && Component->Implements<ULogicSignalReceiver>())
+				{
+					Receivers.Add(Component);
+				}
+			}
+			if (Receivers.Num() == Compiled.FirstReceiver)
+			{
+				ReportError(FString::Printf(TEXT("Sink %s drives %s, which has nothing to receive logic signals"),
+				                            *Desc.Name.ToString(), *Desc.Actor->GetName()));
+			}
+		}
+		Compiled.ReceiverCount = Receivers.Num() - Compiled.FirstReceiver;
+	}
+
+	// Every input starts off, which is what an off And, Or, Latch, Timer or Sink already shows
+	Values.SetNumZeroed(NodeCount);
+	TimerInputs.SetNumZeroed(NodeCount);
+	Timers.SetNum(NodeCount);
+	ChangedScratch.SetNumZeroed(NodeCount);
+	return true;
+}
+
+bool ALevelLogicGraph::ReportError(const FString& Message)
+{
+	UE_LOG(LogTemp, Error, TEXT("Level logic graph %s: %s"), *GetName(), *Message);
+	GEngine->AddOnScreenDebugMessage(-1, 15.0f, FColor::Red,
+	                                 FString::Printf(TEXT("Level logic graph %s: %s"), *GetName(), *Message));
+	return false;
+}
+
+bool ALevelLogicGraph::GetNodeValue(FName NodeName) const
+{
+	const int32* Node = NodeIndices.Find(NodeName);
+	return Node && Values[*Node];
+}
+
+void ALevelLogicGraph::SetSourceValue(FName NodeName, bool Value)
+{
+	const int32* Node = NodeIndices.Find(NodeName);
+	if (!Node || CompiledNodes[*Node].Type != ELevelLogicNodeType::Source)
+	{
+		ReportError(FString::Printf(TEXT("%s is not a source"), *NodeName.ToString()));
+		return;
+	}
+	SetValue(*Node, Value);
+}
+
+void ALevelLogicGraph::OnLogicSignal(const FLogicSignalEvent& Event)
+{
+	if (const int32* Node = SourceNodes.Find(FObjectKey(Event.Source.Get())))
+	{
+		SetValue(*Node, Event.Value);
+	}
+}
+
+void ALevelLogicGraph::StartTimer(int32 Node)
+{
+	GetWorld()->GetSubsystem<UOsuSchedulerSubsystem>()->ScheduleOnce(
+		Timers[Node], TEXT("LevelLogicTimer"), CompiledNodes[Node].Duration,
+		FSimpleDelegate::CreateUObject(this, &ALevelLogicGraph::OnTimerExpired, Node));
+}
+
+void ALevelLogicGraph::CancelTimers()
+{
+	if (UOsuSchedulerSubsystem* Scheduler = GetWorld()->GetSubsystem<UOsuSchedulerSubsystem>())
+	{
+		for (FOsuJobHandle& Timer : Timers)
+		{
+			Scheduler->Cancel(Timer);
+		}
+	}
+}
+
+void ALevelLogicGraph::OnTimerExpired(int32 Node)
+{
+	SetValue(Node, false);
+}
+
+void ALevelLogicGraph::SetValue(int32 Node, bool Value)
+{
+	if (Values[Node] != Value)
+	{
+		Values[Node] = Value;
+		Propagate(Node);
+	}
+}
+
+void ALevelLogicGraph::Propagate(int32 ChangedNode)
+{
+	// Nodes before ChangedNode cannot read it, the ones after are only evaluated if one of their inputs changed
+	FMemory::Memzero(ChangedScratch.GetData() + ChangedNode, ChangedScratch.Num() - ChangedNode);
+	ChangedScratch[ChangedNode] = true;
+	for (int32 Node = ChangedNode + 1; Node < CompiledNodes.Num(); Node++)
+	{
+		const FCompiledNode& Compiled = CompiledNodes[Node];
+		bool InputChanged = false;
+		for (int32 Input = 0; Input < Compiled.InputCount && !InputChanged; Input++)
+		{
+			InputChanged = ChangedScratch[InputNodes[Compiled.FirstInput + Input]];
+		}
+		if (!InputChanged || !EvaluateNode(Node))
+		{
+			continue;
+		}
+		ChangedScratch[Node] = true;
+		for (int32 Receiver = 0; Receiver < Compiled.ReceiverCount; Receiver++)
+		{
+			if (ILogicSignalReceiver* LogicReceiver = Cast<ILogicSignalReceiver>(
+				Receivers[Compiled.FirstReceiver + Receiver].Get()))
+			{
+				LogicReceiver->ReceiveLogicSignal(Values[Node]);
+			}
+		}
+	}
+}
+
+bool ALevelLogicGraph::GetInput(const FCompiledNode& Node, int32 Input) const
+{
+	return Values[InputNodes[Node.FirstInput + Input]];
+}
+
+bool ALevelLogicGraph::EvaluateNode(int32 Node)
+{
+	const FCompiledNode& Compiled = CompiledNodes[Node];
+	bool Value = Values[Node];
+	switch (Compiled.Type)
+	{
+	case ELevelLogicNodeType::And:
+		Value = true;
+		for (int32 Input = 0; Input < Compiled.InputCount; Input++)
+		{
+			Value &= GetInput(Compiled, Input);
+		}
+		break;
+	case ELevelLogicNodeType::Or:
+		Value = false;
+		for (int32 Input = 0; Input < Compiled.InputCount; Input++)
+		{
+			Value |= GetInput(Compiled, Input);
+		}
+		break;
+	case ELevelLogicNodeType::Latch:
+		if (Compiled.InputCount > 1 && GetInput(Compiled, 1))
+		{
+			Value = false;
+		}
+		else if (GetInput(Compiled, 0))
+		{
+			Value = true;
+		}
+		break;
+	case ELevelLogicNodeType::Timer:
+		{
+			// Switches on with its input and off once Duration ran out, whatever the input did meanwhile
+			const bool Input = GetInput(Compiled, 0);
+			if (Input && !TimerInputs[Node])
+			{
+				Value = true;
+				StartTimer(Node);
+			}
+			TimerInputs[Node] = Input;
+			break;
+		}
+	case ELevelLogicNodeType::Sink:
+		Value = GetInput(Compiled, 0);
+		break;
+	default:
+		break;
+	}
+	if (Value == Values[Node])
+	{
+		return false;
+	}
+	Values[Node] = Value;
+	return true;
+}
+
+void ALevelLogicGraph::SerializeState(FArchive& Ar)
+{
+	TArray<bool> SavedValues = Values;
+	TArray<bool> SavedTimerInputs = TimerInputs;
+	Ar << SavedValues;
+	Ar << SavedTimerInputs;
+	if (!Ar.IsLoading())
+	{
+		return;
+	}
+	// A graph edited since the save starts over instead of mixing up nodes
+	if (SavedValues.Num() != Values.Num() || SavedTimerInputs.Num() != TimerInputs.Num())
+	{
+		return;
+	}
+	CancelTimers();
+	Values = MoveTemp(SavedValues);
+	TimerInputs = MoveTemp(SavedTimerInputs);
+	for (int32 Node = 0; Node < CompiledNodes.Num(); Node++)
+	{
+		// Remaining timer time is not saved, a running timer starts over
+		if (CompiledNodes[Node].Type == ELevelLogicNodeType::Timer && Values[Node])
+		{
+			StartTimer(Node);
+		}
+	}
+}
+
+void ALevelLogicGraph::DumpGraph() const
+{
+	UE_LOG(LogTemp, Display, TEXT("%s: %d nodes"), *GetName(), CompiledNodes.Num());
+	for (int32 Node = 0; Node < CompiledNodes.Num(); Node++)
+	{
+		const FCompiledNode& Compiled = CompiledNodes[Node];
+		FString Inputs;
+		for (int32 Input = 0; Input < Compiled.InputCount; Input++)
+		{
+			Inputs += (Input > 0 ? TEXT(", ") : TEXT("")) + CompiledNodes[InputNodes[Compiled.FirstInput + Input]].
+				Name.ToString();
+		}
+		UE_LOG(LogTemp, Display, TEXT("  [%2d] %-8s %-16s = %d <- %s"), Node,
+		       *UEnum::GetDisplayValueAsText(Compiled.Type).ToString(), *Compiled.Name.ToString(), Values[Node],
+		       *Inputs);
+	}
+}
+
+static FAutoConsoleCommandWithWorld DumpLevelLogicCommand(
+	TEXT("Osu.LevelLogic.Dump"),
+	TEXT("Prints every level logic graph in evaluation order with the current value of each node"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		for (TActorIterator<ALevelLogicGraph> It(World); It; ++It)
+		{
+			It->DumpGraph();
+		}
+	}));
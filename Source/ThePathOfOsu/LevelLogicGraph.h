@@ -0,0 +1,113 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OsuGameplayEvents.h"
+#include "OsuSchedulerSubsystem.h"
+#include "OsuType.h"
+#include "GameFramework/Actor.h"
+#include "Interface/SaveableInterface.h"
+#include "UObject/ObjectKey.h"
+#include "LevelLogicGraph.generated.h"
+
+USTRUCT(BlueprintType)
+struct FLevelLogicNode
+{
+	GENERATED_BODY()
+
+	// What other nodes list in their Inputs, unique within the graph
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	FName Name;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	ELevelLogicNodeType Type = ELevelLogicNodeType::Source;
+
+	// Source: the actor whose logic signals switch the node, none when set from Blueprint through SetSourceValue.
+	// Sink: the actor, or its components, driven through ILogicSignalReceiver
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	AActor* Actor = nullptr;
+
+	// And and Or take any number, Latch takes set then an optional reset, Timer and Sink take exactly one
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	TArray<FName> Inputs;
+
+	// Seconds a Timer stays on once its input switched on
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (EditCondition = "Type == ELevelLogicNodeType::Timer"))
+	float Duration = 1.0f;
+};
+
+/**
+ * The wiring of a puzzle room: buttons, triggers and doors feed sources, sinks drive doors and transporters.
+ * Nodes are compiled at BeginPlay into arrays in evaluation order, so a changed input is propagated in one pass
+ * over the nodes after it and the graph costs nothing while no input changes.
+ * Osu.LevelLogic.Dump prints every graph with its current values.
+ */
+UCLASS()
+class THEPATHOFOSU_API ALevelLogicGraph : public AActor, public ISaveableInterface
+{
+	GENERATED_BODY()
+
+public:
+	ALevelLogicGraph();
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+public:
+	UPROPERTY(EditAnywhere, Category = "Logic")
+	TArray<FLevelLogicNode> Nodes;
+
+	UFUNCTION(BlueprintPure, Category = "Logic")
+	bool GetNodeValue(FName NodeName) const;
+
+	// For sources switched by Blueprint actors that do not publish logic signals
+	UFUNCTION(BlueprintCallable, Category = "Logic")
+	void SetSourceValue(FName NodeName, bool Value);
+
+	// Sinks are not driven again on load, the doors and transporters restore their own state
+	virtual void SerializeState(FArchive& Ar) override;
+
+	void DumpGraph() const;
+
+private:
+	struct FCompiledNode
+	{
+		FName Name;
+		ELevelLogicNodeType Type;
+		int32 FirstInput;
+		int32 InputCount;
+		int32 FirstReceiver;
+		int32 ReceiverCount;
+		float Duration;
+	};
+
+	// Reports the first problem found and leaves the graph empty
+	bool Compile();
+	bool ReportError(const FString& Message);
+
+	void SetValue(int32 Node, bool Value);
+	void Propagate(int32 ChangedNode);
+	bool EvaluateNode(int32 Node);
+	bool GetInput(const FCompiledNode& Node, int32 Input) const;
+
+	void OnLogicSignal(const FLogicSignalEvent& Event);
+	void StartTimer(int32 Node);
+	void CancelTimers();
+	void OnTimerExpired(int32 Node);
+
+	// Everything below is indexed in evaluation order, where every node comes after its inputs
+	TArray<FCompiledNode> CompiledNodes;
+	TArray<int32> InputNodes;
+	TArray<TWeakObjectPtr<UObject>> Receivers;
+	TArray<bool> Values;
+	// Last seen input of each Timer, which only restarts on a rising edge
+	TArray<bool> TimerInputs;
+	TArray<FOsuJobHandle> Timers;
+	TArray<bool> ChangedScratch;
+
+	TMap<FName, int32> NodeIndices;
+	TMap<FObjectKey, int32> SourceNodes;
+	FDelegateHandle LogicSignalHandle;
+};
@@ -3,8 +3,8 @@
 
 #include "LiveTrigger.h"
 
+#include "OsuEventBusSubsystem.h"
 #include "PlayerCharacter.h"
-#include "Components/BillboardComponent.h"
 #include "Kismet/GameplayStatics.h"
 
 
@@ -17,19 +17,12 @@ ALiveTrigger::ALiveTrigger()
 	SetRootComponent(RootComp);
 	Mesh = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("Mesh"));
 	Mesh->SetupAttachment(RootComp);
-
-	InteractionHUD = CreateDefaultSubobject<UBillboardComponent>(TEXT("InteractionHUD"));
-	InteractionHUD->SetupAttachment(RootComp);
-	InteractionHUD->SetRelativeLocation(FVector(0.0f, -48.0f, 31.0f));
-	InteractionHUD->SetRelativeScale3D(FVector(0.5f, 0.5f, 0.5f));
-	InteractionHUD->SetHiddenInGame(false);
 }
 
 void ALiveTrigger::BeginPlay()
 {
 	Super::BeginPlay();
 
-	InteractionHUD->SetVisibility(false);
 	if (!SubtitleActor)
 	{
 		GEngine->AddOnScreenDebugMessage(-1, 15.0f, FColor::Red,
@@ -59,6 +52,8 @@ void ALiveTrigger::Interact_Implementation(APlayerCharacter* InteractCharacter)
 		PlayerCharacter->RemoveInventoryItem(RequireItemType);
 		OnInteract.Broadcast();
 		IsActivated = true;
+		UOsuEventBusSubsystem::Publish(this, FObjectiveProgressEvent{this, EObjectiveEvent::TriggerActivated});
+		UOsuEventBusSubsystem::Publish(this, FLogicSignalEvent{this, true});
 	}
 	else
 	{
@@ -69,7 +64,7 @@ void ALiveTrigger::Interact_Implementation(APlayerCharacter* InteractCharacter)
 void ALiveTrigger::ToggleOutline_Implementation(bool bValue)
 {
 	IInteractableInterface::ToggleOutline_Implementation(bValue);
-	InteractionHUD->SetVisibility(bValue);
+	IsHighlighted = bValue;
 }
 
 bool ALiveTrigger::IsEnable_Implementation()
@@ -81,8 +76,9 @@ void ALiveTrigger::StartCheckAndUpdateWidgetVisibleTimer_Implementation()
 {
 	IInteractableInterface::StartCheckAndUpdateWidgetVisibleTimer_Implementation();
 
-	GetWorldTimerManager().SetTimer(
-		CheckAndUpdateWidgetVisibleTimer, this, &ALiveTrigger::CheckAndUpdateWidgetVisible_Implementation, 0.1f, true);
+	GetWorld()->GetSubsystem<UOsuSchedulerSubsystem>()->SchedulePeriodic(
+		CheckAndUpdateWidgetVisibleJob, TEXT("InteractableWidgetCheck"), 0.1f,
+		FSimpleDelegate::CreateUObject(this, &ALiveTrigger::CheckAndUpdateWidgetVisible_Implementation));
 }
 
 void ALiveTrigger::CheckAndUpdateWidgetVisible_Implementation()
@@ -99,11 +95,21 @@ void ALiveTrigger::CheckAndUpdateWidgetVisible_Implementation()
 	{
 		ToggleOutline_Implementation(false);
 		PlayerCharacter->FocusActor = nullptr;
-		GetWorldTimerManager().ClearTimer(CheckAndUpdateWidgetVisibleTimer);
+		GetWorld()->GetSubsystem<UOsuSchedulerSubsystem>()->Cancel(CheckAndUpdateWidgetVisibleJob);
 	}
 }
 
 bool ALiveTrigger::IsInteractiveHUDVisible_Implementation()
 {
-	return InteractionHUD->IsVisible();
+	return IsHighlighted;
+}
+
+FInteractionPrompt ALiveTrigger::GetInteractionPrompt_Implementation()
+{
+	return InteractionPrompt;
+}
+
+void ALiveTrigger::SerializeState(FArchive& Ar)
+{
+	Ar << IsActivated;
 }
@@ -3,16 +3,17 @@
 
 #include "CoreMinimal.h"
 #include "Item.h"
+#include "OsuSchedulerSubsystem.h"
 #include "OsuType.h"
 #include "PlayerCharacter.h"
 #include "Subtitle.h"
 #include "GameFramework/Actor.h"
 #include "Interface/InteractableInterface.h"
-#include "Components/BillboardComponent.h"
+#include "Interface/SaveableInterface.h"
 #include "LiveTrigger.generated.h"
 
 UCLASS()
-class THEPATHOFOSU_API ALiveTrigger : public AActor, public IInteractableInterface
+class THEPATHOFOSU_API ALiveTrigger : public AActor, public IInteractableInterface, public ISaveableInterface
 {
 	GENERATED_BODY()
 
@@ -30,6 +31,8 @@ public:
 	virtual void StartCheckAndUpdateWidgetVisibleTimer_Implementation() override;
 	virtual void CheckAndUpdateWidgetVisible_Implementation() override;
 	virtual bool IsInteractiveHUDVisible_Implementation() override;
+	virtual FInteractionPrompt GetInteractionPrompt_Implementation() override;
+	virtual void SerializeState(FArchive& Ar) override;
 
 	
 	UPROPERTY(BlueprintReadWrite, VisibleAnywhere)
@@ -41,8 +44,11 @@ public:
 	UPROPERTY(BlueprintReadWrite, VisibleAnywhere)
 	bool IsActivated;
 
-	UPROPERTY(BlueprintReadWrite, VisibleAnywhere)
-	UBillboardComponent* InteractionHUD;
+	UPROPERTY(EditAnywhere, Category = "Interaction")
+	FInteractionPrompt InteractionPrompt;
+
+	UPROPERTY(BlueprintReadOnly, VisibleAnywhere)
+	bool IsHighlighted = false;
 
 	UPROPERTY(BlueprintAssignable, BlueprintCallable)
 	FOnInteract OnInteract;
@@ -60,6 +66,6 @@ public:
 	float SubtitleDuration = 4.0f;
 	
 private:
-	FTimerHandle CheckAndUpdateWidgetVisibleTimer;
+	FOsuJobHandle CheckAndUpdateWidgetVisibleJob;
 	
 };
@@ -2,7 +2,10 @@
 
 
 #include "MainMenuPawn.h"
+#include "OsuLevelTransitionSubsystem.h"
+#include "OsuWarmupSubsystem.h"
 #include "Blueprint/UserWidget.h"
+#include "Components/Button.h"
 #include "Kismet/GameplayStatics.h"
 
 
@@ -28,9 +31,44 @@ void AMainMenuPawn::BeginPlay()
 	}
 	MainMenuWidget = CreateWidget<UUserWidget>(GetWorld(), MainMenuWidgetClass);
 	MainMenuWidget->AddToViewport();
+	BindStartButton();
 
 	PlayerController->SetInputMode(FInputModeUIOnly());
 	PlayerController->SetShowMouseCursor(true);
+
+	// Wait until the menu has drawn its first frame before competing with it for IO
+	GetWorldTimerManager().SetTimerForNextTick(this, &AMainMenuPawn::StartIdlePreload);
+}
+
+void AMainMenuPawn::StartGame()
+{
+	GetGameInstance()->GetSubsystem<UOsuLevelTransitionSubsystem>()->TravelToLevel(FirstLevelName);
+}
+
+void AMainMenuPawn::BindStartButton()
+{
+	UButton* StartButton = Cast<UButton>(MainMenuWidget->GetWidgetFromName(StartButtonName));
+	if (!StartButton)
+	{
+		UE_LOG(LogTemp, Error, TEXT("MainMenuWidget has no button named %s, Function name: %s"),
+		       *StartButtonName.ToString(), *FString(__FUNCTION__));
+		return;
+	}
+	// The widget Blueprint opens the level directly, which skips the preload handoff and the loading screen
+	StartButton->OnClicked.Clear();
+	StartButton->OnClicked.AddDynamic(this, &AMainMenuPawn::StartGame);
+}
+
+void AMainMenuPawn::StartIdlePreload()
+{
+	GetGameInstance()->GetSubsystem<UOsuLevelTransitionSubsystem>()->PreloadLevel(FirstLevelName);
+	if (!WarmupManifest)
+	{
+		// Nothing is primed until a UWarmupManifest data asset is created and assigned on the menu pawn Blueprint
+		UE_LOG(LogTemp, Warning, TEXT("WarmupManifest is not set on %s, the gameplay warm-up is skipped"), *GetName());
+		return;
+	}
+	GetGameInstance()->GetSubsystem<UOsuWarmupSubsystem>()->StartWarmup(WarmupManifest);
 }
 
 void AMainMenuPawn::Tick(float DeltaTime)
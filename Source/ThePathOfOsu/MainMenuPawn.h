@@ -6,6 +6,8 @@
 #include "GameFramework/Pawn.h"
 #include "MainMenuPawn.generated.h"
 
+class UWarmupManifest;
+
 UCLASS()
 class THEPATHOFOSU_API AMainMenuPawn : public APawn
 {
@@ -28,8 +30,27 @@ public:
 	UPROPERTY(BlueprintReadOnly, Category = "UI")
 	UUserWidget* MainMenuWidget;
 
+	// Preloaded while the main menu is idle, the menu's start button travels here through
+	// UOsuLevelTransitionSubsystem::TravelToLevel
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Level")
+	FName FirstLevelName = TEXT("Osu_Level1");
+
+	// Button of MainMenuWidgetClass whose click handlers are replaced by StartGame
+	UPROPERTY(EditDefaultsOnly, Category = "UI")
+	FName StartButtonName = TEXT("StartButton");
+
+	UFUNCTION(BlueprintCallable, Category = "Level")
+	void StartGame();
+
+	// Primed by UOsuWarmupSubsystem while the menu is shown, the warm-up is skipped while unset
+	UPROPERTY(EditDefaultsOnly, Category = "Warmup")
+	UWarmupManifest* WarmupManifest;
+
 	// TODO gamepad UI controls
 	
 private:
 	APlayerController* PlayerController;
+
+	void StartIdlePreload();
+	void BindStartButton();
 };
@@ -2,7 +2,7 @@
 
 AMovableActor::AMovableActor()
 {
-	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bCanEverTick = false;
 	
 	RootComp = CreateDefaultSubobject<USceneComponent>(TEXT("RootComp"));
 	SetRootComponent(RootComp);
@@ -27,8 +27,3 @@ void AMovableActor::BeginPlay()
 	FVector EndPoint = GetActorLocation() + Point2->GetRelativeLocation();
 	Transporter->SetPoints(StartPoint, EndPoint);
 }
-
-void AMovableActor::Tick(float DeltaTime)
-{
-	Super::Tick(DeltaTime);
-}
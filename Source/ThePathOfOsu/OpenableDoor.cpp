@@ -3,14 +3,16 @@
 
 #include "OpenableDoor.h"
 
+#include "KinematicMoverSubsystem.h"
+#include "OsuEventBusSubsystem.h"
 #include "PlayerCharacter.h"
-#include "Components/BillboardComponent.h"
+#include "StreamingPreloadSubsystem.h"
 #include "Kismet/GameplayStatics.h"
 
 
 AOpenableDoor::AOpenableDoor()
 {
-	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bCanEverTick = false;
 
 	IsActivated = false;
 	RootComp = CreateDefaultSubobject<USceneComponent>(TEXT("RootComponent"));
@@ -20,29 +22,48 @@ AOpenableDoor::AOpenableDoor()
 	OpenAngle = 90.0f;
 	DoorFrameMesh = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("DoorFrameMesh"));
 	DoorFrameMesh->SetupAttachment(RootComp);
-	InteractionHUD = CreateDefaultSubobject<UBillboardComponent>(TEXT("InteractionHUD"));
-	InteractionHUD->SetupAttachment(RootComp);
-	InteractionHUD->SetRelativeLocation(FVector(0.0f, -48.0f, 31.0f));
-	InteractionHUD->SetRelativeScale3D(FVector(0.5f, 0.5f, 0.5f));
-	InteractionHUD->SetHiddenInGame(false);
 }
 
 void AOpenableDoor::BeginPlay()
 {
 	Super::BeginPlay();
-	InteractionHUD->SetVisibility(false);
-}
-
-void AOpenableDoor::Tick(float DeltaTime)
-{
-	Super::Tick(DeltaTime);
+	ClosedRotation = Mesh->GetRelativeRotation();
 }
 
 void AOpenableDoor::Interact_Implementation(APlayerCharacter* InteractCharacter)
 {
 	IInteractableInterface::Interact_Implementation(InteractCharacter);
-	IsActivated = true;
 	OnInteracted.Broadcast();
+	UOsuEventBusSubsystem::Publish(this, FLogicSignalEvent{this, true});
+	SetOpen(true);
+}
+
+void AOpenableDoor::ReceiveLogicSignal(bool Value)
+{
+	SetOpen(Value);
+}
+
+void AOpenableDoor::SetOpen(bool IsOpen)
+{
+	IsActivated = IsOpen;
+	if (OpenDuration <= 0.0f)
+	{
+		return;
+	}
+	// Closing takes as long as opening and does not broadcast OnOpen
+	GetWorld()->GetSubsystem<UKinematicMoverSubsystem>()->StartMove(
+		Mesh, Mesh->GetRelativeLocation(), IsOpen ? GetOpenedRotation() : ClosedRotation, OpenDuration, OpenEasing,
+		IsOpen ? FSimpleDelegate::CreateUObject(this, &AOpenableDoor::OnOpenFinished) : FSimpleDelegate());
+}
+
+FRotator AOpenableDoor::GetOpenedRotation() const
+{
+	return ClosedRotation + FRotator(0.0f, OpenAngle, 0.0f);
+}
+
+void AOpenableDoor::OnOpenFinished()
+{
+	OnOpen.Broadcast();
 }
 
 bool AOpenableDoor::IsEnable_Implementation()
@@ -53,14 +74,22 @@ bool AOpenableDoor::IsEnable_Implementation()
 void AOpenableDoor::ToggleOutline_Implementation(bool bValue)
 {
 	IInteractableInterface::ToggleOutline_Implementation(bValue);
-	InteractionHUD->SetVisibility(bValue);
+	IsHighlighted = bValue;
+	if (bValue && PreloadsBehindDoor && !IsActivated)
+	{
+		if (UStreamingPreloadSubsystem* StreamingPreload = GetWorld()->GetSubsystem<UStreamingPreloadSubsystem>())
+		{
+			StreamingPreload->RequestPreload(GetActorTransform().TransformPosition(PreloadOffset), PreloadDuration);
+		}
+	}
 }
 
 void AOpenableDoor::StartCheckAndUpdateWidgetVisibleTimer_Implementation()
 {
 	IInteractableInterface::StartCheckAndUpdateWidgetVisibleTimer_Implementation();
-	GetWorldTimerManager().SetTimer(
-		CheckAndUpdateWidgetVisibleTimer, this, &AOpenableDoor::CheckAndUpdateWidgetVisible_Implementation, 0.1f, true);
+	GetWorld()->GetSubsystem<UOsuSchedulerSubsystem>()->SchedulePeriodic(
+		CheckAndUpdateWidgetVisibleJob, TEXT("InteractableWidgetCheck"), 0.1f,
+		FSimpleDelegate::CreateUObject(this, &AOpenableDoor::CheckAndUpdateWidgetVisible_Implementation));
 }
 
 void AOpenableDoor::CheckAndUpdateWidgetVisible_Implementation()
@@ -74,11 +103,32 @@ void AOpenableDoor::CheckAndUpdateWidgetVisible_Implementation()
 	if (IsActivated || PlayerCharacter->FocusActor != this || !PlayerCharacter->CloseActors.Contains(this))
 	{
 		ToggleOutline_Implementation(false);
-		GetWorldTimerManager().ClearTimer(CheckAndUpdateWidgetVisibleTimer);
+		GetWorld()->GetSubsystem<UOsuSchedulerSubsystem>()->Cancel(CheckAndUpdateWidgetVisibleJob);
 	}
 }
 
 bool AOpenableDoor::IsInteractiveHUDVisible_Implementation()
 {
-	return InteractionHUD->IsVisible();
+	return IsHighlighted;
+}
+
+FInteractionPrompt AOpenableDoor::GetInteractionPrompt_Implementation()
+{
+	return InteractionPrompt;
+}
+
+void AOpenableDoor::SerializeState(FArchive& Ar)
+{
+	Ar << IsActivated;
+	// A door swung open by its Blueprint keeps wherever it got to, a natively opened one ends fully open
+	FRotator DoorRotation = Mesh->GetRelativeRotation();
+	Ar << DoorRotation;
+	if (Ar.IsLoading())
+	{
+		if (UKinematicMoverSubsystem* KinematicMover = GetWorld()->GetSubsystem<UKinematicMoverSubsystem>())
+		{
+			KinematicMover->StopMove(Mesh);
+		}
+		Mesh->SetRelativeRotation(IsActivated && OpenDuration > 0.0f ? GetOpenedRotation() : DoorRotation);
+	}
 }
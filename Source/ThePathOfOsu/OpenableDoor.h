@@ -1,9 +1,13 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "OsuSchedulerSubsystem.h"
 #include "PlayerCharacter.h"
 #include "GameFramework/Actor.h"
 #include "Interface/InteractableInterface.h"
+#include "Interface/LogicSignalReceiver.h"
+#include "Interface/SaveableInterface.h"
+#include "Kismet/KismetMathLibrary.h"
 #include "OpenableDoor.generated.h"
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnDoorOpened);
@@ -11,7 +15,8 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnDoorOpened);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnDoorInteracted);
 
 UCLASS()
-class THEPATHOFOSU_API AOpenableDoor : public AActor, public IInteractableInterface
+class THEPATHOFOSU_API AOpenableDoor : public AActor, public IInteractableInterface, public ISaveableInterface,
+                                       public ILogicSignalReceiver
 {
 	GENERATED_BODY()
 
@@ -22,14 +27,17 @@ protected:
 	virtual void BeginPlay() override;
 
 public:
-	virtual void Tick(float DeltaTime) override;
-
 	virtual void Interact_Implementation(APlayerCharacter* InteractCharacter) override;
 	virtual bool IsEnable_Implementation() override;
 	virtual void ToggleOutline_Implementation(bool bValue) override;
 	virtual void StartCheckAndUpdateWidgetVisibleTimer_Implementation() override;
 	virtual void CheckAndUpdateWidgetVisible_Implementation() override;
 	virtual bool IsInteractiveHUDVisible_Implementation() override;
+	virtual FInteractionPrompt GetInteractionPrompt_Implementation() override;
+	virtual void SerializeState(FArchive& Ar) override;
+
+	// Opened and closed by an ALevelLogicGraph sink, a door left to its Blueprint only tracks the state
+	virtual void ReceiveLogicSignal(bool Value) override;
 
 
 	UPROPERTY(BlueprintReadWrite, VisibleAnywhere)
@@ -41,8 +49,11 @@ public:
 	UStaticMeshComponent* DoorFrameMesh;
 
 
-	UPROPERTY(BlueprintReadWrite, VisibleAnywhere)
-	UBillboardComponent* InteractionHUD;
+	UPROPERTY(EditAnywhere, Category = "Interaction")
+	FInteractionPrompt InteractionPrompt;
+
+	UPROPERTY(BlueprintReadOnly, VisibleAnywhere)
+	bool IsHighlighted = false;
 
 	UPROPERTY(BlueprintAssignable, BlueprintCallable)
 	FOnDoorOpened OnOpen;
@@ -53,7 +64,29 @@ public:
 	UPROPERTY(BlueprintReadWrite, EditAnywhere)
 	float OpenAngle;
 
+	// Seconds the door takes to swing open by OpenAngle on its own, 0 leaves the opening to the Blueprint
+	UPROPERTY(EditAnywhere, Category = "Movement")
+	float OpenDuration = 0.0f;
+
+	UPROPERTY(EditAnywhere, Category = "Movement", meta = (EditCondition = "OpenDuration > 0"))
+	TEnumAsByte<EEasingFunc::Type> OpenEasing = EEasingFunc::EaseOut;
+
+	// Streams in what is behind the door once the player is close enough to open it
+	UPROPERTY(EditAnywhere, Category = "Streaming")
+	bool PreloadsBehindDoor = false;
+
+	UPROPERTY(EditAnywhere, Category = "Streaming", meta = (EditCondition = "PreloadsBehindDoor"))
+	FVector PreloadOffset = FVector(1000.0f, 0.0f, 0.0f);
+
+	UPROPERTY(EditAnywhere, Category = "Streaming", meta = (EditCondition = "PreloadsBehindDoor"))
+	float PreloadDuration = 20.0f;
+
 private:
-	FTimerHandle CheckAndUpdateWidgetVisibleTimer;
+	FOsuJobHandle CheckAndUpdateWidgetVisibleJob;
 	bool IsActivated;
+
+	FRotator ClosedRotation;
+	FRotator GetOpenedRotation() const;
+	void SetOpen(bool IsOpen);
+	void OnOpenFinished();
 };
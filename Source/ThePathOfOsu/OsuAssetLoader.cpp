@@ -0,0 +1,24 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "OsuAssetLoader.h"
+
+#include "Engine/AssetManager.h"
+
+TSharedPtr<FStreamableHandle> FOsuAssetLoader::RequestAsyncLoad(TArray<FSoftObjectPath>&& Paths,
+                                                               const UObject* Requester)
+{
+	if (Paths.IsEmpty())
+	{
+		return nullptr;
+	}
+	return UAssetManager::GetStreamableManager().RequestAsyncLoad(
+		MoveTemp(Paths), FStreamableDelegate(), FStreamableManager::DefaultAsyncLoadPriority, false, false,
+		Requester ? Requester->GetName() : TEXT("FOsuAssetLoader"));
+}
+
+void FOsuAssetLoader::WarnSynchronousLoad(const FSoftObjectPath& Path, const UObject* Requester)
+{
+	UE_LOG(LogTemp, Warning, TEXT("%s loaded synchronously by %s, its asset bundle was not requested in time"),
+	       *Path.ToString(), Requester ? *Requester->GetName() : TEXT("unknown"));
+}
@@ -0,0 +1,68 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FStreamableHandle;
+
+/**
+ * Soft reference helpers shared by the actors that split their assets into EOsuAssetBundle groups
+ */
+struct THEPATHOFOSU_API FOsuAssetLoader
+{
+	// Loads Paths through the asset manager's streamable manager, the handle keeps them resident until released
+	static TSharedPtr<FStreamableHandle> RequestAsyncLoad(TArray<FSoftObjectPath>&& Paths, const UObject* Requester);
+
+	template <typename AssetType>
+	static void AddPath(TArray<FSoftObjectPath>& OutPaths, const TSoftObjectPtr<AssetType>& Asset)
+	{
+		if (!Asset.IsNull())
+		{
+			OutPaths.Add(Asset.ToSoftObjectPath());
+		}
+	}
+
+	template <typename ClassType>
+	static void AddPath(TArray<FSoftObjectPath>& OutPaths, const TSoftClassPtr<ClassType>& Class)
+	{
+		if (!Class.IsNull())
+		{
+			OutPaths.Add(Class.ToSoftObjectPath());
+		}
+	}
+
+	// Null when unset. Falls back to a synchronous load, with a warning, when its bundle was not requested in time
+	template <typename AssetType>
+	static AssetType* Get(const TSoftObjectPtr<AssetType>& Asset, const UObject* Requester)
+	{
+		if (Asset.IsNull())
+		{
+			return nullptr;
+		}
+		if (AssetType* LoadedAsset = Asset.Get())
+		{
+			return LoadedAsset;
+		}
+		WarnSynchronousLoad(Asset.ToSoftObjectPath(), Requester);
+		return Asset.LoadSynchronous();
+	}
+
+	template <typename ClassType>
+	static UClass* Get(const TSoftClassPtr<ClassType>& Class, const UObject* Requester)
+	{
+		if (Class.IsNull())
+		{
+			return nullptr;
+		}
+		if (UClass* LoadedClass = Class.Get())
+		{
+			return LoadedClass;
+		}
+		WarnSynchronousLoad(Class.ToSoftObjectPath(), Requester);
+		return Class.LoadSynchronous();
+	}
+
+private:
+	static void WarnSynchronousLoad(const FSoftObjectPath& Path, const UObject* Requester);
+};
@@ -0,0 +1,59 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "OsuEventBusBenchmark.h"
+
+#include "OsuEventBusSubsystem.h"
+
+static FAutoConsoleCommandWithWorldAndArgs BenchmarkEventBusCommand(
+	TEXT("Osu.EventBus.Benchmark"),
+	TEXT("Compares a dynamic multicast delegate broadcast with a batched event bus channel. Args: [Events] [Listeners]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		const int32 EventCount = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 10000;
+		const int32 ListenerCount = Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 4;
+
+		FOsuBenchmarkDynamicEvent DynamicEvent;
+		TOsuEventChannel<FOsuBenchmarkEvent> Channel;
+		TArray<UOsuEventBusBenchmarkListener*> Listeners;
+		for (int32 Index = 0; Index < ListenerCount; Index++)
+		{
+			UOsuEventBusBenchmarkListener* Listener = NewObject<UOsuEventBusBenchmarkListener>();
+			DynamicEvent.AddDynamic(Listener, &UOsuEventBusBenchmarkListener::OnDynamicEvent);
+			Channel.Subscribe(TOsuEventChannel<FOsuBenchmarkEvent>::FListener::CreateUObject(
+				Listener, &UOsuEventBusBenchmarkListener::OnNativeEvent));
+			Listeners.Add(Listener);
+		}
+
+		double StartTime = FPlatformTime::Seconds();
+		for (int32 Index = 0; Index < EventCount; Index++)
+		{
+			DynamicEvent.Broadcast(Index);
+		}
+		const double DynamicTime = FPlatformTime::Seconds() - StartTime;
+
+		// A first flush grows the queues, the measured one runs at the steady state capacity
+		for (int32 Index = 0; Index < EventCount; Index++)
+		{
+			Channel.Publish({nullptr, Index});
+		}
+		Channel.Flush();
+		StartTime = FPlatformTime::Seconds();
+		for (int32 Index = 0; Index < EventCount; Index++)
+		{
+			Channel.Publish({nullptr, Index});
+		}
+		Channel.Flush();
+		const double BusTime = FPlatformTime::Seconds() - StartTime;
+
+		int64 Checksum = 0;
+		for (const UOsuEventBusBenchmarkListener* Listener : Listeners)
+		{
+			Checksum += Listener->Sum;
+		}
+		const double DeliveryCount = static_cast<double>(EventCount) * ListenerCount;
+		UE_LOG(LogTemp, Display, TEXT("Osu.EventBus.Benchmark: %d events, %d listeners (checksum %lld)"),
+		       EventCount, ListenerCount, Checksum);
+		UE_LOG(LogTemp, Display, TEXT("  Dynamic multicast: %8.2f ns/delivery"), DynamicTime * 1e9 / DeliveryCount);
+		UE_LOG(LogTemp, Display, TEXT("  Event bus:         %8.2f ns/delivery"), BusTime * 1e9 / DeliveryCount);
+	}));
@@ -0,0 +1,31 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "OsuEventBusBenchmark.generated.h"
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOsuBenchmarkDynamicEvent, int32, Value);
+
+// Payload of Osu.EventBus.Benchmark, which runs on a standalone channel so real listeners never see it
+struct FOsuBenchmarkEvent
+{
+	TWeakObjectPtr<AActor> Source;
+	int32 Value = 0;
+};
+
+// Dynamic delegates need a UFunction to bind to
+UCLASS(Transient)
+class THEPATHOFOSU_API UOsuEventBusBenchmarkListener : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	UFUNCTION()
+	void OnDynamicEvent(int32 Value) { Sum += Value; }
+
+	void OnNativeEvent(const FOsuBenchmarkEvent& Event) { Sum += Event.Value; }
+
+	int64 Sum = 0;
+};
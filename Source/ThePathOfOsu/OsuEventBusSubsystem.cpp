@@ -0,0 +1,46 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "OsuEventBusSubsystem.h"
+
+void UOsuEventBusSubsystem::SetBlueprintBridged(EOsuEventChannel Channel, bool Bridged)
+{
+	if (Channel < EOsuEventChannel::Count)
+	{
+		BridgedChannels[static_cast<int32>(Channel)] = Bridged;
+	}
+}
+
+void UOsuEventBusSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	// Listeners may publish again, those events wait for the next frame
+	HasPendingEvents = false;
+	for (const TUniquePtr<FOsuEventChannelBase>& Channel : Channels)
+	{
+		if (Channel)
+		{
+			Channel->Flush();
+		}
+	}
+
+	const int32 BridgedCount = BridgedEvents.Num();
+	for (int32 Index = 0; Index < BridgedCount; Index++)
+	{
+		// Copied, a Blueprint publishing from here grows the array
+		const FBridgedEvent Event = BridgedEvents[Index];
+		OnBridgedEvent.Broadcast(Event.Channel, Event.Source.Get());
+	}
+	BridgedEvents.RemoveAt(0, BridgedCount, false);
+}
+
+bool UOsuEventBusSubsystem::IsTickable() const
+{
+	return HasPendingEvents;
+}
+
+TStatId UOsuEventBusSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UOsuEventBusSubsystem, STATGROUP_Tickables);
+}
@@ -0,0 +1,217 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OsuFrameArena.h"
+#include "OsuGameplayEvents.h"
+#include "OsuType.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "OsuEventBusSubsystem.generated.h"
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnOsuBridgedEvent, EOsuEventChannel, Channel, AActor*, Source);
+
+// Lets the subsystem flush channels without knowing their payload type
+class FOsuEventChannelBase
+{
+public:
+	virtual ~FOsuEventChannelBase() = default;
+
+	virtual void Flush() = 0;
+};
+
+/**
+ * Listeners of one payload type. Published events are copied into a queue that is delivered in one go by Flush,
+ * both queues keep their capacity so a channel stops allocating once it has seen its busiest frame.
+ * Events published while delivering are queued for the next flush.
+ */
+template <typename EventType>
+class TOsuEventChannel : public FOsuEventChannelBase
+{
+public:
+	using FListener = TDelegate<void(const EventType&)>;
+
+	// A listener with a Source only receives events published by that actor
+	FDelegateHandle Subscribe(FListener&& Listener, const AActor* Source = nullptr)
+	{
+		const FDelegateHandle Handle = Listener.GetHandle();
+		// Adding while delivering could move the listener being executed
+		(IsDelivering ? AddedListeners : Listeners).Add({MoveTemp(Listener), FObjectKey(Source)});
+		return Handle;
+	}
+
+	void Unsubscribe(FDelegateHandle Handle)
+	{
+		for (TArray<FListenerEntry>* Entries : {&Listeners, &AddedListeners})
+		{
+			for (FListenerEntry& Entry : *Entries)
+			{
+				if (Entry.Listener.GetHandle() == Handle)
+				{
+					Entry.Listener.Unbind();
+					HasUnboundListeners = true;
+				}
+			}
+		}
+	}
+
+	void Publish(const EventType& Event)
+	{
+		const SIZE_T PendingSize = Pending.GetAllocatedSize();
+		Pending.Add(Event);
+		FOsuFrameArena::Get().ReportBufferGrowth(Pending, PendingSize);
+	}
+
+	void PublishImmediate(const EventType& Event)
+	{
+		IsDelivering = true;
+		Deliver(Event);
+		IsDelivering = false;
+		Compact();
+	}
+
+	virtual void Flush() override
+	{
+		Swap(Pending, Delivering);
+		IsDelivering = true;
+		for (const EventType& Event : Delivering)
+		{
+			Deliver(Event);
+		}
+		IsDelivering = false;
+		Delivering.Reset();
+		Compact();
+	}
+
+private:
+	struct FListenerEntry
+	{
+		FListener Listener;
+		FObjectKey Source;
+	};
+
+	void Deliver(const EventType& Event)
+	{
+		const FObjectKey EventSource(Event.Source.Get());
+		for (const FListenerEntry& Entry : Listeners)
+		{
+			if (Entry.Source != FObjectKey() && Entry.Source != EventSource)
+			{
+				continue;
+			}
+			// Listeners bound to a destroyed object report unbound and are dropped on the next compact
+			if (!Entry.Listener.ExecuteIfBound(Event))
+			{
+				HasUnboundListeners = true;
+			}
+		}
+	}
+
+	void Compact()
+	{
+		if (HasUnboundListeners)
+		{
+			Listeners.RemoveAllSwap([](const FListenerEntry& Entry) { return !Entry.Listener.IsBound(); });
+			HasUnboundListeners = false;
+		}
+		if (!AddedListeners.IsEmpty())
+		{
+			Listeners.Append(MoveTemp(AddedListeners));
+			AddedListeners.Reset();
+		}
+	}
+
+	TArray<FListenerEntry> Listeners;
+	TArray<FListenerEntry> AddedListeners;
+	TArray<EventType> Pending;
+	TArray<EventType> Delivering;
+	bool IsDelivering = false;
+	bool HasUnboundListeners = false;
+};
+
+/**
+ * Native replacement for dynamic multicast delegates between gameplay actors. Each payload struct in
+ * OsuGameplayEvents.h owns a channel picked at compile time, publishing copies the payload into that channel's
+ * queue and every queue is delivered once per frame after the actors ticked.
+ * Blueprints only see the channels they asked for through SetBlueprintBridged.
+ */
+UCLASS()
+class THEPATHOFOSU_API UOsuEventBusSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	template <typename EventType, typename UserClass>
+	FDelegateHandle Subscribe(UserClass* Object, void (UserClass::*Handler)(const EventType&),
+	                          const AActor* Source = nullptr)
+	{
+		return GetChannel<EventType>().Subscribe(
+			TOsuEventChannel<EventType>::FListener::CreateUObject(Object, Handler), Source);
+	}
+
+	template <typename EventType>
+	void Unsubscribe(FDelegateHandle Handle)
+	{
+		GetChannel<EventType>().Unsubscribe(Handle);
+	}
+
+	template <typename EventType>
+	void Publish(const EventType& Event)
+	{
+		GetChannel<EventType>().Publish(Event);
+		HasPendingEvents = true;
+		if (BridgedChannels[static_cast<int32>(EventType::Channel)])
+		{
+			BridgedEvents.Add({EventType::Channel, Event.Source});
+		}
+	}
+
+	// Does nothing in worlds without the subsystem
+	template <typename EventType>
+	static void Publish(const UObject* WorldContextObject, const EventType& Event)
+	{
+		const UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject,
+		                                                         EGetWorldErrorMode::LogAndReturnNull);
+		if (UOsuEventBusSubsystem* EventBus = World ? World->GetSubsystem<UOsuEventBusSubsystem>() : nullptr)
+		{
+			EventBus->Publish(Event);
+		}
+	}
+
+	// Also broadcasts the channel's events through OnBridgedEvent, after the native listeners got them
+	UFUNCTION(BlueprintCallable, Category = "EventBus")
+	void SetBlueprintBridged(EOsuEventChannel Channel, bool Bridged);
+
+	UPROPERTY(BlueprintAssignable, Category = "EventBus")
+	FOnOsuBridgedEvent OnBridgedEvent;
+
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+
+private:
+	template <typename EventType>
+	TOsuEventChannel<EventType>& GetChannel()
+	{
+		static_assert(std::is_same_v<decltype(EventType::Channel), const EOsuEventChannel>,
+		              "Event payloads must declare their EOsuEventChannel");
+		TUniquePtr<FOsuEventChannelBase>& Channel = Channels[static_cast<int32>(EventType::Channel)];
+		if (!Channel)
+		{
+			Channel = MakeUnique<TOsuEventChannel<EventType>>();
+		}
+		return static_cast<TOsuEventChannel<EventType>&>(*Channel);
+	}
+
+	struct FBridgedEvent
+	{
+		EOsuEventChannel Channel;
+		TWeakObjectPtr<AActor> Source;
+	};
+
+	TUniquePtr<FOsuEventChannelBase> Channels[static_cast<int32>(EOsuEventChannel::Count)];
+	bool BridgedChannels[static_cast<int32>(EOsuEventChannel::Count)] = {};
+	TArray<FBridgedEvent> BridgedEvents;
+	bool HasPendingEvents = false;
+};
@@ -0,0 +1,135 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "OsuFrameArena.h"
+
+#include "Misc/CoreDelegates.h"
+
+FOsuFrameArena& FOsuFrameArena::Get()
+{
+	static FOsuFrameArena Arena;
+	return Arena;
+}
+
+FOsuFrameArena::FOsuFrameArena()
+{
+	EndFrameHandle = FCoreDelegates::OnEndFrame.AddRaw(this, &FOsuFrameArena::OnEndFrame);
+}
+
+FOsuFrameArena::~FOsuFrameArena()
+{
+	FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+	for (uint8* Block : Blocks)
+	{
+		FMemory::Free(Block);
+	}
+}
+
+void* FOsuFrameArena::Allocate(SIZE_T Size)
+{
+	check(IsInGameThread());
+	LiveAllocations++;
+	FrameAllocations++;
+	FrameBytes += Size;
+	if (Size > MaxBlockAllocationSize)
+	{
+		FrameHeapAllocations++;
+		return FMemory::Malloc(Size, Alignment);
+	}
+
+	const SIZE_T AlignedSize = Align(Size, Alignment);
+	if (Blocks.IsEmpty() || Offset + AlignedSize > BlockSize)
+	{
+		if (!Blocks.IsEmpty())
+		{
+			CurrentBlock++;
+		}
+		if (CurrentBlock == Blocks.Num())
+		{
+			FrameHeapAllocations++;
+			Blocks.Add(static_cast<uint8*>(FMemory::Malloc(BlockSize, Alignment)));
+		}
+		Offset = 0;
+	}
+	uint8* Memory = Blocks[CurrentBlock] + Offset;
+	Offset += AlignedSize;
+	return Memory;
+}
+
+void FOsuFrameArena::Free(void* Memory, SIZE_T Size)
+{
+	check(IsInGameThread());
+	LiveAllocations--;
+	if (Size > MaxBlockAllocationSize)
+	{
+		FMemory::Free(Memory);
+		return;
+	}
+	// The latest allocation gives its memory back, so a scratch array freed before the next one is reused
+	uint8* Block = Blocks[CurrentBlock];
+	uint8* Start = static_cast<uint8*>(Memory);
+	if (Start >= Block && Start + Align(Size, Alignment) == Block + Offset)
+	{
+		Offset = Start - Block;
+	}
+}
+
+bool FOsuFrameArena::TryResizeInPlace(void* Memory, SIZE_T OldSize, SIZE_T NewSize)
+{
+	if (OldSize > MaxBlockAllocationSize || NewSize > MaxBlockAllocationSize)
+	{
+		return false;
+	}
+	uint8* Block = Blocks[CurrentBlock];
+	const SIZE_T Start = static_cast<uint8*>(Memory) - Block;
+	if (static_cast<uint8*>(Memory) < Block || Start + Align(OldSize, Alignment) != Offset ||
+		Start + NewSize > BlockSize)
+	{
+		return false;
+	}
+	Offset = Start + Align(NewSize, Alignment);
+	if (NewSize > OldSize)
+	{
+		FrameBytes += NewSize - OldSize;
+	}
+	return true;
+}
+
+void FOsuFrameArena::OnEndFrame()
+{
+	LastFrameBytes = FrameBytes;
+	LastFrameAllocations = FrameAllocations;
+	PeakFrameBytes = FMath::Max(PeakFrameBytes, FrameBytes);
+	HeapAllocations += FrameHeapAllocations;
+	FramesSinceHeapAllocation = FrameHeapAllocations > 0 ? 0 : FramesSinceHeapAllocation + 1;
+	FrameBytes = 0;
+	FrameAllocations = 0;
+	FrameHeapAllocations = 0;
+
+	// Rewinding under a live array would hand its memory out again, keep growing until it is gone
+	if (!ensureMsgf(LiveAllocations == 0, TEXT("%d frame arena allocations outlived their frame"), LiveAllocations))
+	{
+		return;
+	}
+	CurrentBlock = 0;
+	Offset = 0;
+}
+
+void FOsuFrameArena::DumpStats()
+{
+	UE_LOG(LogTemp, Display, TEXT("Frame arena: %d blocks (%llu KB), %d live allocations"),
+	       Blocks.Num(), static_cast<uint64>(Blocks.Num() * BlockSize / 1024), LiveAllocations);
+	UE_LOG(LogTemp, Display, TEXT("  last frame: %d allocations, %llu bytes, peak frame: %llu bytes"),
+	       LastFrameAllocations, static_cast<uint64>(LastFrameBytes), static_cast<uint64>(PeakFrameBytes));
+	UE_LOG(LogTemp, Display, TEXT("  heap allocations: %d (%d by reused buffers), frames since the last one: %llu"),
+	       HeapAllocations, BufferHeapAllocations, FramesSinceHeapAllocation);
+	UE_LOG(LogTemp, Display, TEXT("  allocations inside engine calls are not counted"));
+}
+
+static FAutoConsoleCommand DumpFrameArenaCommand(
+	TEXT("Osu.FrameArena.Dump"),
+	TEXT("Prints the frame arena usage and how many frames ran without it touching the heap"),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		FOsuFrameArena::Get().DumpStats();
+	}));
@@ -0,0 +1,202 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Linear game thread allocator for scratch memory that dies within the frame, such as query results and the
+ * lists built from them. Allocations bump a pointer in 64KB blocks, and the whole arena is reset at the end of
+ * every frame. Blocks are kept, so once the arena has grown to a level's busiest frame it stops touching the heap.
+ * Requests over a quarter block go to the heap and are released as soon as they are freed.
+ * Per-frame lists built and dropped within a call, such as finished kinematic moves and completed objectives, live
+ * here. Buffers that engine queries fill or that outlive the frame are reused members instead, the interactable
+ * scan, trace service, push grid and event bus queues report when one of them grows.
+ * Osu.FrameArena.Dump prints the usage and how many frames since the last heap allocation of either. Allocations
+ * made inside engine calls, such as a scene query's internal buffers, are not visible to these counters.
+ */
+class THEPATHOFOSU_API FOsuFrameArena
+{
+public:
+	static FOsuFrameArena& Get();
+
+	~FOsuFrameArena();
+
+	void* Allocate(SIZE_T Size);
+	void Free(void* Memory, SIZE_T Size);
+
+	// Grows or shrinks the latest allocation where it is, returns false when Memory is not on top of the block
+	bool TryResizeInPlace(void* Memory, SIZE_T OldSize, SIZE_T NewSize);
+
+	// Call after filling a reused scratch buffer that lives outside the arena, counted when it had to grow
+	template <typename ArrayType>
+	void ReportBufferGrowth(const ArrayType& Buffer, SIZE_T PreviousAllocatedSize)
+	{
+		if (Buffer.GetAllocatedSize() > PreviousAllocatedSize)
+		{
+			FrameHeapAllocations++;
+			BufferHeapAllocations++;
+		}
+	}
+
+	void DumpStats();
+
+private:
+	FOsuFrameArena();
+
+	void OnEndFrame();
+
+	static constexpr SIZE_T BlockSize = 64 * 1024;
+	static constexpr SIZE_T MaxBlockAllocationSize = BlockSize / 4;
+	static constexpr SIZE_T Alignment = 16;
+
+	TArray<uint8*> Blocks;
+	int32 CurrentBlock = 0;
+	SIZE_T Offset = 0;
+	// Allocations not freed yet, an arena array must not be kept past the frame it was made in
+	int32 LiveAllocations = 0;
+
+	SIZE_T FrameBytes = 0;
+	int32 FrameAllocations = 0;
+	int32 FrameHeapAllocations = 0;
+
+	SIZE_T LastFrameBytes = 0;
+	int32 LastFrameAllocations = 0;
+	SIZE_T PeakFrameBytes = 0;
+	int32 HeapAllocations = 0;
+	int32 BufferHeapAllocations = 0;
+	uint64 FramesSinceHeapAllocation = 0;
+
+	FDelegateHandle EndFrameHandle;
+};
+
+/**
+ * TArray allocator policy backed by FOsuFrameArena. Only for locals on the game thread, the array must be gone
+ * before the frame ends. Growing the latest allocation extends it in place.
+ */
+class FOsuFrameAllocator
+{
+public:
+	using SizeType = int32;
+
+	enum { NeedsElementType = false };
+	enum { RequireRangeCheck = true };
+
+	class ForAnyElementType
+	{
+	public:
+		ForAnyElementType() = default;
+		ForAnyElementType(const ForAnyElementType&) = delete;
+		ForAnyElementType& operator=(const ForAnyElementType&) = delete;
+
+		~ForAnyElementType()
+		{
+			if (Data)
+			{
+				FOsuFrameArena::Get().Free(Data, AllocatedBytes);
+			}
+		}
+
+		void MoveToEmpty(ForAnyElementType& Other)
+		{
+			check(this != &Other);
+			if (Data)
+			{
+				FOsuFrameArena::Get().Free(Data, AllocatedBytes);
+			}
+			Data = Other.Data;
+			AllocatedBytes = Other.AllocatedBytes;
+			Other.Data = nullptr;
+			Other.AllocatedBytes = 0;
+		}
+
+		FScriptContainerElement* GetAllocation() const
+		{
+			return Data;
+		}
+
+		void ResizeAllocation(SizeType CurrentNum, SizeType NewMax, SIZE_T NumBytesPerElement)
+		{
+			FOsuFrameArena& Arena = FOsuFrameArena::Get();
+			const SIZE_T NewBytes = NewMax * NumBytesPerElement;
+			if (NewBytes == 0)
+			{
+				if (Data)
+				{
+					Arena.Free(Data, AllocatedBytes);
+				}
+				Data = nullptr;
+				AllocatedBytes = 0;
+				return;
+			}
+			if (Data && Arena.TryResizeInPlace(Data, AllocatedBytes, NewBytes))
+			{
+				AllocatedBytes = NewBytes;
+				return;
+			}
+
+			FScriptContainerElement* NewData = static_cast<FScriptContainerElement*>(Arena.Allocate(NewBytes));
+			if (Data)
+			{
+				FMemory::Memcpy(NewData, Data, FMath::Min(CurrentNum, NewMax) * NumBytesPerElement);
+				Arena.Free(Data, AllocatedBytes);
+			}
+			Data = NewData;
+			AllocatedBytes = NewBytes;
+		}
+
+		SizeType CalculateSlackReserve(SizeType NewMax, SIZE_T NumBytesPerElement) const
+		{
+			return DefaultCalculateSlackReserve(NewMax, NumBytesPerElement, false);
+		}
+
+		SizeType CalculateSlackShrink(SizeType NewMax, SizeType CurrentMax, SIZE_T NumBytesPerElement) const
+		{
+			return DefaultCalculateSlackShrink(NewMax, CurrentMax, NumBytesPerElement, false);
+		}
+
+		SizeType CalculateSlackGrow(SizeType NewMax, SizeType CurrentMax, SIZE_T NumBytesPerElement) const
+		{
+			return DefaultCalculateSlackGrow(NewMax, CurrentMax, NumBytesPerElement, false);
+		}
+
+		SIZE_T GetAllocatedSize(SizeType CurrentMax, SIZE_T NumBytesPerElement) const
+		{
+			return CurrentMax * NumBytesPerElement;
+		}
+
+		bool HasAllocation() const
+		{
+			return Data != nullptr;
+		}
+
+		SizeType GetInitialCapacity() const
+		{
+			return 0;
+		}
+
+	private:
+		FScriptContainerElement* Data = nullptr;
+		SIZE_T AllocatedBytes = 0;
+	};
+
+	template <typename ElementType>
+	class ForElementType : public ForAnyElementType
+	{
+	public:
+		ElementType* GetAllocation() const
+		{
+			return reinterpret_cast<ElementType*>(ForAnyElementType::GetAllocation());
+		}
+	};
+};
+
+template <>
+struct TAllocatorTraits<FOsuFrameAllocator> : TAllocatorTraitsBase<FOsuFrameAllocator>
+{
+	enum { SupportsMove = true };
+	enum { IsZeroConstruct = true };
+};
+
+template <typename ElementType>
+using TOsuFrameArray = TArray<ElementType, FOsuFrameAllocator>;
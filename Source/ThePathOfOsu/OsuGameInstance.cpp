@@ -3,7 +3,7 @@
 
 #include "OsuGameInstance.h"
 
-#include "PlayerCharacter.h"
+#include "OsuUIScreenManager.h"
 #include "Blueprint/UserWidget.h"
 #include "Kismet/GameplayStatics.h"
 
@@ -14,32 +14,18 @@ void UOsuGameInstance::TogglePauseGame()
 		GetEngine()->AddOnScreenDebugMessage(-1, 15.0f, FColor::Red, "PauseMenuWidgetClass is null");
 		return;
 	}
+	UOsuUIScreenManager* ScreenManager = GetSubsystem<UOsuUIScreenManager>();
 	if (IsGamePaused)
 	{
 		OnGameResume.Broadcast();
-		PlayerController->SetInputMode(FInputModeGameOnly());
-		PlayerController->SetShowMouseCursor(false);
-		// PlayerCharacter->EnableInput(PlayerController);
+		ScreenManager->PopScreen(PauseMenuWidget);
 		IsGamePaused = false;
 	}
 	else
 	{
-		if (!PlayerController)
-		{
-			PlayerController = UGameplayStatics::GetPlayerController(GetWorld(), 0);
-		}
-		if (!PlayerCharacter)
-		{
-			PlayerCharacter = Cast<APlayerCharacter>(UGameplayStatics::GetPlayerCharacter(GetWorld(), 0));
-		}
-		PauseMenuWidget = CreateWidget<UUserWidget>(PlayerController, PauseMenuWidgetClass);
-		PauseMenuWidget->AddToViewport();
+		PauseMenuWidget = ScreenManager->PushScreen(PauseMenuWidgetClass, EOsuUILayer::Menu,
+		                                            EOsuUIInputMode::GameAndUI);
 		UGameplayStatics::SetGamePaused(GetWorld(), true);
-		// PlayerController->SetInputMode(FInputModeUIOnly());
-
-		// PlayerCharacter->DisableInput(PlayerController);
-		PlayerController->SetShowMouseCursor(true);
-		PlayerController->SetInputMode(FInputModeGameAndUI());
 		IsGamePaused = true;
 	}
 }
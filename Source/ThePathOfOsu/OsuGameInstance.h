@@ -26,6 +26,7 @@ public:
 	UPROPERTY(EditDefaultsOnly)
 	TSubclassOf<UUserWidget> PauseMenuWidgetClass;
 	
+	// Cached by UOsuUIScreenManager, the same instance is reopened on every pause
 	UPROPERTY(BlueprintReadOnly, VisibleAnywhere)
 	UUserWidget* PauseMenuWidget;
 	
@@ -42,7 +43,4 @@ public:
 	float SFXVolume = 100.0f;
 
 
-private:
-	APlayerController* PlayerController;
-	APlayerCharacter* PlayerCharacter;
 };
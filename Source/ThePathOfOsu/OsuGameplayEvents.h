@@ -0,0 +1,26 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OsuType.h"
+
+// Payloads of UOsuEventBusSubsystem. Each one names its channel and starts with the actor that published it,
+// which is what Source filtered listeners are matched against. Keep them small, they are copied into the queue
+
+// A puzzle element switched on or off, read by transporters and ALevelLogicGraph sources
+struct FLogicSignalEvent
+{
+	static constexpr EOsuEventChannel Channel = EOsuEventChannel::LogicSignal;
+
+	TWeakObjectPtr<AActor> Source;
+	bool Value = false;
+};
+
+struct FObjectiveProgressEvent
+{
+	static constexpr EOsuEventChannel Channel = EOsuEventChannel::ObjectiveProgress;
+
+	TWeakObjectPtr<AActor> Source;
+	EObjectiveEvent Event = EObjectiveEvent::None;
+};
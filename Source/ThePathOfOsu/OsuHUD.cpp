@@ -0,0 +1,145 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "OsuHUD.h"
+
+#include "EnemyCharacter.h"
+#include "EnemyMarkerLayerWidget.h"
+#include "CheckpointSubsystem.h"
+#include "EngineUtils.h"
+#include "PlayerCharacter.h"
+#include "PlayerHUDViewModel.h"
+#include "PlayerHUDWidget.h"
+
+AOsuHUD::AOsuHUD()
+{
+	EnemyMarkerLayerWidgetClass = UEnemyMarkerLayerWidget::StaticClass();
+	PlayerHUDWidgetClass = UPlayerHUDWidget::StaticClass();
+}
+
+void AOsuHUD::BeginPlay()
+{
+	Super::BeginPlay();
+	SetupPlayerHUD();
+	SetupEnemyMarkers();
+}
+
+void AOsuHUD::SetupPlayerHUD()
+{
+	if (!PlayerHUDWidgetClass)
+	{
+		UE_LOG(LogTemp, Error, TEXT("PlayerHUDWidgetClass is null! %s"), *GetName());
+		return;
+	}
+	if (!PlayerOwner)
+	{
+		return;
+	}
+
+	PlayerHUDViewModel = NewObject<UPlayerHUDViewModel>(this);
+	PlayerHUDWidget = CreateWidget<UPlayerHUDWidget>(PlayerOwner, PlayerHUDWidgetClass);
+	if (!PlayerHUDWidget)
+	{
+		return;
+	}
+	PlayerHUDWidget->SetViewModel(PlayerHUDViewModel);
+	PlayerHUDWidget->AddToViewport();
+	PlayerHUDWidget->SetVisibility(ESlateVisibility::Collapsed);
+
+	// The HUD is spawned before the player pawn is possessed, and the pawn changes again after respawn
+	NewPawnHandle = PlayerOwner->GetOnNewPawnNotifier().AddUObject(this, &AOsuHUD::OnNewPawn);
+	OnNewPawn(PlayerOwner->GetPawn());
+}
+
+void AOsuHUD::OnNewPawn(APawn* NewPawn)
+{
+	APlayerCharacter* PlayerCharacter = Cast<APlayerCharacter>(NewPawn);
+	if (PlayerCharacter)
+	{
+		PlayerHUDViewModel->Initialize(PlayerCharacter);
+	}
+	else
+	{
+		PlayerHUDViewModel->Deinitialize();
+	}
+	PlayerHUDWidget->SetVisibility(PlayerCharacter ? ESlateVisibility::HitTestInvisible : ESlateVisibility::Collapsed);
+}
+
+void AOsuHUD::SetupEnemyMarkers()
+{
+	if (!EnemyMarkerLayerWidgetClass)
+	{
+		UE_LOG(LogTemp, Error, TEXT("EnemyMarkerLayerWidgetClass is null! %s"), *GetName());
+		return;
+	}
+
+	for (TActorIterator<AEnemyCharacter> It(GetWorld()); It; ++It)
+	{
+		RegisterEnemy(*It);
+	}
+	ActorSpawnedHandle = GetWorld()->AddOnActorSpawnedHandler(
+		FOnActorSpawned::FDelegate::CreateUObject(this, &AOsuHUD::OnActorSpawned));
+	if (UCheckpointSubsystem* CheckpointSubsystem = GetWorld()->GetSubsystem<UCheckpointSubsystem>())
+	{
+		CheckpointRestoredHandle = CheckpointSubsystem->OnCheckpointRestored.AddUObject(
+			this, &AOsuHUD::OnCheckpointRestored);
+	}
+}
+
+void AOsuHUD::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (NewPawnHandle.IsValid() && PlayerOwner)
+	{
+		PlayerOwner->GetOnNewPawnNotifier().Remove(NewPawnHandle);
+		NewPawnHandle.Reset();
+	}
+	if (PlayerHUDViewModel)
+	{
+		PlayerHUDViewModel->Deinitialize();
+	}
+	if (ActorSpawnedHandle.IsValid())
+	{
+		GetWorld()->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+		ActorSpawnedHandle.Reset();
+	}
+	UCheckpointSubsystem* CheckpointSubsystem = GetWorld()->GetSubsystem<UCheckpointSubsystem>();
+	if (CheckpointRestoredHandle.IsValid() && CheckpointSubsystem)
+	{
+		CheckpointSubsystem->OnCheckpointRestored.Remove(CheckpointRestoredHandle);
+		CheckpointRestoredHandle.Reset();
+	}
+	Super::EndPlay(EndPlayReason);
+}
+
+void AOsuHUD::OnActorSpawned(AActor* SpawnedActor)
+{
+	if (AEnemyCharacter* Enemy = Cast<AEnemyCharacter>(SpawnedActor))
+	{
+		RegisterEnemy(Enemy);
+	}
+}
+
+void AOsuHUD::OnCheckpointRestored()
+{
+	// The marker layer drops enemies when they die, pick up the ones the checkpoint revived
+	for (TActorIterator<AEnemyCharacter> It(GetWorld()); It; ++It)
+	{
+		RegisterEnemy(*It);
+	}
+}
+
+void AOsuHUD::RegisterEnemy(AEnemyCharacter* Enemy)
+{
+	// Created on the first enemy so levels without enemies never pay for the layer
+	if (!EnemyMarkerLayerWidget)
+	{
+		EnemyMarkerLayerWidget = CreateWidget<UEnemyMarkerLayerWidget>(PlayerOwner, EnemyMarkerLayerWidgetClass);
+		if (!EnemyMarkerLayerWidget)
+		{
+			return;
+		}
+		EnemyMarkerLayerWidget->AddToViewport(-1);
+		EnemyMarkerLayerWidget->SetVisibility(ESlateVisibility::HitTestInvisible);
+	}
+	EnemyMarkerLayerWidget->RegisterEnemy(Enemy);
+}
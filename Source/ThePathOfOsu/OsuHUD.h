@@ -0,0 +1,59 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/HUD.h"
+#include "OsuHUD.generated.h"
+
+class AEnemyCharacter;
+class UEnemyMarkerLayerWidget;
+class UPlayerHUDViewModel;
+class UPlayerHUDWidget;
+
+/**
+ * Owns the screen space widget layers shared by every actor in the level
+ */
+UCLASS()
+class THEPATHOFOSU_API AOsuHUD : public AHUD
+{
+	GENERATED_BODY()
+
+public:
+	// Defaults to the native widgets, which build their own tree, a Blueprint HUD may swap in designed ones
+	AOsuHUD();
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	UPROPERTY(EditDefaultsOnly, Category = "UI")
+	TSubclassOf<UEnemyMarkerLayerWidget> EnemyMarkerLayerWidgetClass;
+
+	UPROPERTY(EditDefaultsOnly, Category = "UI")
+	TSubclassOf<UPlayerHUDWidget> PlayerHUDWidgetClass;
+
+private:
+	UPROPERTY()
+	UEnemyMarkerLayerWidget* EnemyMarkerLayerWidget;
+
+	UPROPERTY()
+	UPlayerHUDViewModel* PlayerHUDViewModel;
+
+	UPROPERTY()
+	UPlayerHUDWidget* PlayerHUDWidget;
+
+	FDelegateHandle NewPawnHandle;
+
+	void SetupPlayerHUD();
+	void OnNewPawn(APawn* NewPawn);
+
+	void SetupEnemyMarkers();
+
+	FDelegateHandle ActorSpawnedHandle;
+	FDelegateHandle CheckpointRestoredHandle;
+
+	void OnActorSpawned(AActor* SpawnedActor);
+	void OnCheckpointRestored();
+	void RegisterEnemy(AEnemyCharacter* Enemy);
+};
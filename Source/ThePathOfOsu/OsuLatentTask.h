@@ -0,0 +1,157 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include <coroutine>
+
+#include "CoreMinimal.h"
+#include "OsuLatentTaskSubsystem.h"
+#include "Components/TimelineComponent.h"
+
+class UAnimInstance;
+class UAnimMontage;
+struct FStreamableHandle;
+
+// Shared between a coroutine frame and whatever will wake it, which only holds it weakly
+struct THEPATHOFOSU_API FOsuLatentTaskState
+{
+	std::coroutine_handle<> Handle;
+	TWeakObjectPtr<const UObject> Owner;
+	TWeakObjectPtr<UOsuLatentTaskSubsystem> Subsystem;
+	bool IsRunning = false;
+	bool IsCancelled = false;
+
+	// Destroys the frame instead once the owner is gone or the task was cancelled
+	static void Resume(const TWeakPtr<FOsuLatentTaskState>& WeakState);
+	static void Destroy(const TSharedPtr<FOsuLatentTaskState>& State);
+
+	// Called by awaiters before they hand the task to a waker, false when the task must not be woken again
+	static bool Suspend(const TSharedPtr<FOsuLatentTaskState>& State);
+};
+
+/**
+ * A gameplay sequence written as a C++20 coroutine, for flows that used to be split over timers and callbacks:
+ *
+ *	FOsuLatentTask AMyActor::OpenSequence()
+ *	{
+ *		co_await FOsuLatentDelay{2.0f};
+ *		co_await FOsuLatentTimelineFinished{DoorTimeline};
+ *		OnOpened.Broadcast();
+ *	}
+ *
+ * The coroutine must be a member of a UObject or take one as first parameter, that object owns the task.
+ * It runs right away until its first co_await, a suspended task holds no tick or timer slot. It is destroyed
+ * without resuming once its owner is destroyed, when it is cancelled or when its world is torn down, so code
+ * after a co_await only runs with a valid owner. Parameters are copied into the frame, avoid references.
+ */
+class THEPATHOFOSU_API FOsuLatentTask
+{
+public:
+	struct promise_type
+	{
+		template <typename OwnerType, typename... ArgTypes>
+		explicit promise_type(OwnerType& Owner, ArgTypes&...)
+		{
+			if constexpr (std::is_pointer_v<OwnerType>)
+			{
+				static_assert(std::is_base_of_v<UObject, std::remove_cv_t<std::remove_pointer_t<OwnerType>>>,
+				              "A latent task needs a UObject owner as its first parameter");
+				Initialize(Owner);
+			}
+			else
+			{
+				static_assert(std::is_base_of_v<UObject, std::remove_cv_t<OwnerType>>,
+				              "A latent task must be a member of a UObject");
+				Initialize(&Owner);
+			}
+		}
+
+		FOsuLatentTask get_return_object()
+		{
+			State->Handle = std::coroutine_handle<promise_type>::from_promise(*this);
+			return FOsuLatentTask(State);
+		}
+
+		std::suspend_never initial_suspend() noexcept { return {}; }
+
+		std::suspend_never final_suspend() noexcept
+		{
+			State->Handle = nullptr;
+			return {};
+		}
+
+		void return_void()
+		{
+		}
+
+		void unhandled_exception()
+		{
+			checkNoEntry();
+		}
+
+		TSharedPtr<FOsuLatentTaskState> State;
+
+	private:
+		void Initialize(const UObject* Owner);
+	};
+
+	FOsuLatentTask() = default;
+
+	// Safe from inside the task itself and on a task that already finished
+	void Cancel();
+
+	bool IsActive() const;
+
+private:
+	explicit FOsuLatentTask(const TSharedPtr<FOsuLatentTaskState>& InState) : State(InState)
+	{
+	}
+
+	TWeakPtr<FOsuLatentTaskState> State;
+};
+
+using FOsuLatentTaskHandle = std::coroutine_handle<FOsuLatentTask::promise_type>;
+
+// Resumes after Seconds of world time, at the earliest on the next frame
+struct THEPATHOFOSU_API FOsuLatentDelay
+{
+	float Seconds = 0.0f;
+
+	bool await_ready() const noexcept { return false; }
+	void await_suspend(FOsuLatentTaskHandle Handle) const;
+	void await_resume() const noexcept {}
+};
+
+// Resumes once Montage stops playing on AnimInstance, co_await returns whether it was interrupted.
+// Replaces the end delegate of the montage instance
+struct THEPATHOFOSU_API FOsuLatentMontageEnded
+{
+	UAnimInstance* AnimInstance = nullptr;
+	UAnimMontage* Montage = nullptr;
+	bool IsInterrupted = false;
+
+	bool await_ready() const;
+	void await_suspend(FOsuLatentTaskHandle Handle);
+	bool await_resume() const noexcept { return IsInterrupted; }
+};
+
+// Resumes once Timeline reaches its end. Replaces the native finished function of the timeline, the one bound
+// with SetTimelineFinishedFunc still fires
+struct THEPATHOFOSU_API FOsuLatentTimelineFinished
+{
+	FTimeline& Timeline;
+
+	bool await_ready() const { return !Timeline.IsPlaying(); }
+	void await_suspend(FOsuLatentTaskHandle Handle) const;
+	void await_resume() const noexcept {}
+};
+
+// Resumes once the assets of an FOsuAssetLoader request or any streamable handle finished or were cancelled
+struct THEPATHOFOSU_API FOsuLatentAssetsLoaded
+{
+	TSharedPtr<FStreamableHandle> LoadHandle;
+
+	bool await_ready() const;
+	void await_suspend(FOsuLatentTaskHandle Handle) const;
+	void await_resume() const noexcept {}
+};
@@ -0,0 +1,246 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "OsuLatentTaskSubsystem.h"
+
+#include "OsuLatentTask.h"
+#include "Animation/AnimInstance.h"
+#include "Engine/StreamableManager.h"
+
+void FOsuLatentTaskState::Resume(const TWeakPtr<FOsuLatentTaskState>& WeakState)
+{
+	// Pinned, the frame releases its own reference when it finishes during resume
+	const TSharedPtr<FOsuLatentTaskState> State = WeakState.Pin();
+	if (!State || !State->Handle)
+	{
+		return;
+	}
+	if (State->IsCancelled || !State->Owner.IsValid())
+	{
+		Destroy(State);
+		return;
+	}
+	State->IsRunning = true;
+	State->Handle.resume();
+}
+
+void FOsuLatentTaskState::Destroy(const TSharedPtr<FOsuLatentTaskState>& State)
+{
+	if (const std::coroutine_handle<> Handle = State->Handle)
+	{
+		State->Handle = nullptr;
+		Handle.destroy();
+	}
+}
+
+bool FOsuLatentTaskState::Suspend(const TSharedPtr<FOsuLatentTaskState>& State)
+{
+	State->IsRunning = false;
+	if (!State->IsCancelled)
+	{
+		return true;
+	}
+	if (UOsuLatentTaskSubsystem* Subsystem = State->Subsystem.Get())
+	{
+		Subsystem->DestroyLater(State);
+	}
+	return false;
+}
+
+void FOsuLatentTask::promise_type::Initialize(const UObject* Owner)
+{
+	State = MakeShared<FOsuLatentTaskState>();
+	State->Owner = Owner;
+	State->IsRunning = true;
+	const UWorld* World = Owner ? Owner->GetWorld() : nullptr;
+	State->Subsystem = World ? World->GetSubsystem<UOsuLatentTaskSubsystem>() : nullptr;
+	if (UOsuLatentTaskSubsystem* Subsystem = State->Subsystem.Get())
+	{
+		Subsystem->Register(State);
+	}
+	else
+	{
+		UE_LOG(LogTemp, Error, TEXT("Latent task started outside a game world, it will not be resumed by delays"));
+	}
+}
+
+void FOsuLatentTask::Cancel()
+{
+	const TSharedPtr<FOsuLatentTaskState> PinnedState = State.Pin();
+	if (!PinnedState || !PinnedState->Handle)
+	{
+		return;
+	}
+	PinnedState->IsCancelled = true;
+	if (!PinnedState->IsRunning)
+	{
+		FOsuLatentTaskState::Destroy(PinnedState);
+	}
+	State.Reset();
+}
+
+bool FOsuLatentTask::IsActive() const
+{
+	const TSharedPtr<FOsuLatentTaskState> PinnedState = State.Pin();
+	return PinnedState && PinnedState->Handle && !PinnedState->IsCancelled;
+}
+
+void FOsuLatentDelay::await_suspend(FOsuLatentTaskHandle Handle) const
+{
+	const TSharedPtr<FOsuLatentTaskState>& State = Handle.promise().State;
+	if (FOsuLatentTaskState::Suspend(State))
+	{
+		if (UOsuLatentTaskSubsystem* Subsystem = State->Subsystem.Get())
+		{
+			Subsystem->AddDelay(State, Seconds);
+		}
+	}
+}
+
+bool FOsuLatentMontageEnded::await_ready() const
+{
+	return !AnimInstance || !Montage || !AnimInstance->Montage_IsPlaying(Montage);
+}
+
+void FOsuLatentMontageEnded::await_suspend(FOsuLatentTaskHandle Handle)
+{
+	const TSharedPtr<FOsuLatentTaskState>& State = Handle.promise().State;
+	if (!FOsuLatentTaskState::Suspend(State))
+	{
+		return;
+	}
+	FOnMontageEnded EndDelegate = FOnMontageEnded::CreateLambda(
+		[WeakState = TWeakPtr<FOsuLatentTaskState>(State), this](UAnimMontage*, bool Interrupted)
+		{
+			// This awaiter lives in the frame, only written to while the frame does
+			const TSharedPtr<FOsuLatentTaskState> PinnedState = WeakState.Pin();
+			if (PinnedState && PinnedState->Handle)
+			{
+				IsInterrupted = Interrupted;
+			}
+			FOsuLatentTaskState::Resume(WeakState);
+		});
+	AnimInstance->Montage_SetEndDelegate(EndDelegate, Montage);
+}
+
+void FOsuLatentTimelineFinished::await_suspend(FOsuLatentTaskHandle Handle) const
+{
+	const TSharedPtr<FOsuLatentTaskState>& State = Handle.promise().State;
+	if (FOsuLatentTaskState::Suspend(State))
+	{
+		Timeline.SetTimelineFinishedFuncStatic(FOnTimelineEventStatic::CreateLambda(
+			[WeakState = TWeakPtr<FOsuLatentTaskState>(State)]()
+			{
+				FOsuLatentTaskState::Resume(WeakState);
+			}));
+	}
+}
+
+bool FOsuLatentAssetsLoaded::await_ready() const
+{
+	return !LoadHandle.IsValid() || LoadHandle->HasLoadCompleted() || LoadHandle->WasCanceled();
+}
+
+void FOsuLatentAssetsLoaded::await_suspend(FOsuLatentTaskHandle Handle) const
+{
+	const TSharedPtr<FOsuLatentTaskState>& State = Handle.promise().State;
+	if (!FOsuLatentTaskState::Suspend(State))
+	{
+		return;
+	}
+	const FStreamableDelegate ResumeDelegate = FStreamableDelegate::CreateLambda(
+		[WeakState = TWeakPtr<FOsuLatentTaskState>(State)]()
+		{
+			FOsuLatentTaskState::Resume(WeakState);
+		});
+	LoadHandle->BindCancelDelegate(ResumeDelegate);
+	if (!LoadHandle->BindCompleteDelegate(ResumeDelegate))
+	{
+		// Finished between await_ready and now, resumed on the next frame instead
+		if (UOsuLatentTaskSubsystem* Subsystem = State->Subsystem.Get())
+		{
+			Subsystem->AddDelay(State, 0.0f);
+		}
+	}
+}
+
+void UOsuLatentTaskSubsystem::Deinitialize()
+{
+	for (const TWeakPtr<FOsuLatentTaskState>& WeakState : Tasks)
+	{
+		if (const TSharedPtr<FOsuLatentTaskState> State = WeakState.Pin())
+		{
+			FOsuLatentTaskState::Destroy(State);
+		}
+	}
+	Tasks.Empty();
+	DelayedTasks.Empty();
+	TasksToDestroy.Empty();
+	Super::Deinitialize();
+}
+
+void UOsuLatentTaskSubsystem::Register(const TSharedPtr<FOsuLatentTaskState>& State)
+{
+	// Finished tasks leave expired entries behind, dropped whenever the list doubled since the last sweep.
+	// A task waiting on a timeline or montage of a destroyed owner is never woken, its frame is destroyed here
+	if (Tasks.Num() >= FMath::Max(2 * CompactedTaskCount, 16))
+	{
+		Tasks.RemoveAllSwap([](const TWeakPtr<FOsuLatentTaskState>& WeakState)
+		{
+			const TSharedPtr<FOsuLatentTaskState> TaskState = WeakState.Pin();
+			if (TaskState && !TaskState->IsRunning && !TaskState->Owner.IsValid())
+			{
+				FOsuLatentTaskState::Destroy(TaskState);
+			}
+			return !TaskState || !TaskState->Handle;
+		});
+		CompactedTaskCount = Tasks.Num();
+	}
+	Tasks.Add(State);
+}
+
+void UOsuLatentTaskSubsystem::AddDelay(const TSharedPtr<FOsuLatentTaskState>& State, float Seconds)
+{
+	DelayedTasks.HeapPush({GetWorld()->GetTimeSeconds() + Seconds, State});
+}
+
+void UOsuLatentTaskSubsystem::DestroyLater(const TSharedPtr<FOsuLatentTaskState>& State)
+{
+	TasksToDestroy.Add(State);
+}
+
+void UOsuLatentTaskSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	for (const TWeakPtr<FOsuLatentTaskState>& WeakState : TasksToDestroy)
+	{
+		if (const TSharedPtr<FOsuLatentTaskState> State = WeakState.Pin())
+		{
+			FOsuLatentTaskState::Destroy(State);
+		}
+	}
+	TasksToDestroy.Reset();
+
+	// Taken out before resuming, a task waiting again in a loop must not run twice in one frame
+	const double Now = GetWorld()->GetTimeSeconds();
+	while (!DelayedTasks.IsEmpty() && DelayedTasks.HeapTop().WakeTime <= Now)
+	{
+		DelayedTasks.HeapPop(DueTasks.AddDefaulted_GetRef(), false);
+	}
+	for (const FDelayedTask& DueTask : DueTasks)
+	{
+		FOsuLatentTaskState::Resume(DueTask.State);
+	}
+	DueTasks.Reset();
+}
+
+bool UOsuLatentTaskSubsystem::IsTickable() const
+{
+	return !DelayedTasks.IsEmpty() || !TasksToDestroy.IsEmpty();
+}
+
+TStatId UOsuLatentTaskSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UOsuLatentTaskSubsystem, STATGROUP_Tickables);
+}
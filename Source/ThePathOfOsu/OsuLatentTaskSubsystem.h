@@ -0,0 +1,50 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "OsuLatentTaskSubsystem.generated.h"
+
+struct FOsuLatentTaskState;
+
+/**
+ * Wakes FOsuLatentTask coroutines waiting on a delay and owns every task started in the world, so the ones
+ * still suspended when the world goes away are destroyed with it. Delays sit in one heap ordered by wake time,
+ * the subsystem only ticks while one is pending. Tasks waiting on anything else cost nothing until woken.
+ */
+UCLASS()
+class THEPATHOFOSU_API UOsuLatentTaskSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	void Register(const TSharedPtr<FOsuLatentTaskState>& State);
+
+	// World time, stops while paused and follows the global time dilation like timers do
+	void AddDelay(const TSharedPtr<FOsuLatentTaskState>& State, float Seconds);
+
+	// For tasks cancelled from inside, which cannot destroy their own frame while it runs
+	void DestroyLater(const TSharedPtr<FOsuLatentTaskState>& State);
+
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+
+private:
+	struct FDelayedTask
+	{
+		double WakeTime;
+		TWeakPtr<FOsuLatentTaskState> State;
+
+		bool operator<(const FDelayedTask& Other) const { return WakeTime < Other.WakeTime; }
+	};
+
+	TArray<FDelayedTask> DelayedTasks;
+	TArray<FDelayedTask> DueTasks;
+	TArray<TWeakPtr<FOsuLatentTaskState>> Tasks;
+	TArray<TWeakPtr<FOsuLatentTaskState>> TasksToDestroy;
+	int32 CompactedTaskCount = 0;
+};
@@ -0,0 +1,205 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "OsuLevelTransitionSubsystem.h"
+
+#include "MoviePlayer.h"
+#include "Engine/Engine.h"
+#include "Kismet/GameplayStatics.h"
+#include "Misc/PackageName.h"
+#include "Widgets/Images/SThrobber.h"
+#include "Widgets/Layout/SBox.h"
+#include "Widgets/SBoxPanel.h"
+#include "Widgets/Text/STextBlock.h"
+
+void UOsuLevelTransitionSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	PostLoadMapHandle = FCoreUObjectDelegates::PostLoadMapWithWorld.AddUObject(
+		this, &UOsuLevelTransitionSubsystem::OnPostLoadMap);
+	TravelFailureHandle = GEngine->OnTravelFailure().AddUObject(this, &UOsuLevelTransitionSubsystem::OnTravelFailure);
+	NetworkFailureHandle = GEngine->OnNetworkFailure().AddUObject(
+		this, &UOsuLevelTransitionSubsystem::OnNetworkFailure);
+}
+
+void UOsuLevelTransitionSubsystem::Deinitialize()
+{
+	FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(PostLoadMapHandle);
+	if (GEngine)
+	{
+		GEngine->OnTravelFailure().Remove(TravelFailureHandle);
+		GEngine->OnNetworkFailure().Remove(NetworkFailureHandle);
+	}
+	PreloadedPackage = nullptr;
+	Super::Deinitialize();
+}
+
+void UOsuLevelTransitionSubsystem::PreloadLevel(FName LevelName)
+{
+	const FString PackageName = GetLevelPackageName(LevelName);
+	if (PackageName == PreloadingPackageName)
+	{
+		return;
+	}
+	if (!FPackageName::DoesPackageExist(PackageName))
+	{
+		UE_LOG(LogTemp, Error, TEXT("PreloadLevel: %s does not exist"), *PackageName);
+		return;
+	}
+
+	PreloadedPackage = nullptr;
+	PreloadingPackageName = PackageName;
+	PreloadStartTime = FPlatformTime::Seconds();
+	LoadPackageAsync(PackageName,
+	                 FLoadPackageAsyncDelegate::CreateUObject(this, &UOsuLevelTransitionSubsystem::OnLevelPackageLoaded));
+}
+
+bool UOsuLevelTransitionSubsystem::IsLevelPreloaded(FName LevelName) const
+{
+	return PreloadedPackage && PreloadingPackageName == GetLevelPackageName(LevelName);
+}
+
+bool UOsuLevelTransitionSubsystem::TravelToLevel(FName LevelName)
+{
+	if (IsTravelling())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("TravelToLevel: %s ignored, already travelling to %s"),
+		       *LevelName.ToString(), *TravellingLevelName.ToString());
+		return false;
+	}
+	UWorld* World = GetGameInstance()->GetWorld();
+	if (!World)
+	{
+		UE_LOG(LogTemp, Error, TEXT("TravelToLevel: World is null"));
+		return false;
+	}
+	if (!FPackageName::DoesPackageExist(GetLevelPackageName(LevelName)))
+	{
+		UE_LOG(LogTemp, Error, TEXT("TravelToLevel: %s does not exist"), *GetLevelPackageName(LevelName));
+		return false;
+	}
+
+	TravellingLevelName = LevelName;
+	TravelStartTime = FPlatformTime::Seconds();
+	ShowLoadingScreen();
+	UGameplayStatics::OpenLevel(World, FName(*GetLevelPackageName(LevelName)));
+	return true;
+}
+
+bool UOsuLevelTransitionSubsystem::IsTravelling() const
+{
+	return !TravellingLevelName.IsNone();
+}
+
+FString UOsuLevelTransitionSubsystem::GetLevelPackageName(FName LevelName)
+{
+	const FString Name = LevelName.ToString();
+	return Name.StartsWith(TEXT("/")) ? Name : TEXT("/Game/Maps/") + Name;
+}
+
+void UOsuLevelTransitionSubsystem::OnLevelPackageLoaded(const FName& PackageName, UPackage* LoadedPackage,
+                                                        EAsyncLoadingResult::Type Result)
+{
+	// A newer preload replaced this one while it was loading
+	if (PackageName.ToString() != PreloadingPackageName)
+	{
+		return;
+	}
+	if (Result != EAsyncLoadingResult::Succeeded || !LoadedPackage)
+	{
+		UE_LOG(LogTemp, Error, TEXT("PreloadLevel: failed to load %s"), *PreloadingPackageName);
+		PreloadingPackageName.Reset();
+		return;
+	}
+	PreloadedPackage = LoadedPackage;
+	UE_LOG(LogTemp, Log, TEXT("Preloaded %s in %.2f s"), *PreloadingPackageName,
+	       FPlatformTime::Seconds() - PreloadStartTime);
+}
+
+void UOsuLevelTransitionSubsystem::ShowLoadingScreen()
+{
+	// The movie player runs its own Slate thread, so the loading screen keeps animating while the game thread
+	// is blocked inside the map load. It is not available in the editor, PIE travels without one.
+	if (!IsMoviePlayerEnabled() || IsRunningDedicatedServer())
+	{
+		return;
+	}
+
+	FLoadingScreenAttributes LoadingScreen;
+	LoadingScreen.bAutoCompleteWhenLoadingCompletes = true;
+	LoadingScreen.MinimumLoadingScreenDisplayTime = 0.5f;
+	LoadingScreen.WidgetLoadingScreen =
+		SNew(SBox)
+		.HAlign(HAlign_Right)
+		.VAlign(VAlign_Bottom)
+		.Padding(FMargin(0.0f, 0.0f, 60.0f, 60.0f))
+		[
+			SNew(SHorizontalBox)
+			+ SHorizontalBox::Slot()
+			.AutoWidth()
+			.VAlign(VAlign_Center)
+			.Padding(FMargin(0.0f, 0.0f, 16.0f, 0.0f))
+			[
+				SNew(STextBlock)
+				.Text(NSLOCTEXT("OsuLevelTransition", "Loading", "Loading"))
+			]
+			+ SHorizontalBox::Slot()
+			.AutoWidth()
+			.VAlign(VAlign_Center)
+			[
+				SNew(SThrobber)
+			]
+		];
+	GetMoviePlayer()->SetupLoadingScreen(LoadingScreen);
+}
+
+void UOsuLevelTransitionSubsystem::OnPostLoadMap(UWorld* LoadedWorld)
+{
+	if (!LoadedWorld || LoadedWorld->GetGameInstance() != GetGameInstance())
+	{
+		return;
+	}
+
+	// The travelled map now references its own package, the preload has served its purpose
+	PreloadedPackage = nullptr;
+	PreloadingPackageName.Reset();
+
+	if (!IsTravelling())
+	{
+		return;
+	}
+	const FName LevelName = TravellingLevelName;
+	const float LoadSeconds = FPlatformTime::Seconds() - TravelStartTime;
+	TravellingLevelName = NAME_None;
+	UE_LOG(LogTemp, Log, TEXT("Travelled to %s in %.2f s"), *LevelName.ToString(), LoadSeconds);
+	OnLevelTransitionFinished.Broadcast(LevelName, LoadSeconds);
+}
+
+void UOsuLevelTransitionSubsystem::OnTravelFailure(UWorld* World, ETravelFailure::Type FailureType,
+                                                   const FString& ErrorString)
+{
+	FailTravel(FString::Printf(TEXT("%s, %s"), ETravelFailure::ToString(FailureType), *ErrorString));
+}
+
+void UOsuLevelTransitionSubsystem::OnNetworkFailure(UWorld* World, UNetDriver* NetDriver,
+                                                    ENetworkFailure::Type FailureType, const FString& ErrorString)
+{
+	FailTravel(FString::Printf(TEXT("%s, %s"), ENetworkFailure::ToString(FailureType), *ErrorString));
+}
+
+void UOsuLevelTransitionSubsystem::FailTravel(const FString& Reason)
+{
+	if (!IsTravelling())
+	{
+		return;
+	}
+	const FName LevelName = TravellingLevelName;
+	TravellingLevelName = NAME_None;
+	UE_LOG(LogTemp, Error, TEXT("Travel to %s failed: %s"), *LevelName.ToString(), *Reason);
+
+	if (IsMoviePlayerEnabled() && GetMoviePlayer()->IsMovieCurrentlyPlaying())
+	{
+		GetMoviePlayer()->StopMovie();
+	}
+	OnLevelTransitionFailed.Broadcast(LevelName);
+}
@@ -0,0 +1,75 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineBaseTypes.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "OsuLevelTransitionSubsystem.generated.h"
+
+class UNetDriver;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnLevelTransitionFinished, FName, LevelName, float, LoadSeconds);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnLevelTransitionFailed, FName, LevelName);
+
+/**
+ * Moves between maps behind a loading screen instead of a frozen frame. The next map's package can be streamed in
+ * ahead of time, while the current map is still idle, so the travel itself only has to finish what is left.
+ */
+UCLASS()
+class THEPATHOFOSU_API UOsuLevelTransitionSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	// LevelName is a map under /Game/Maps or a long package name. The loaded package is kept until the next travel
+	UFUNCTION(BlueprintCallable, Category = "Level")
+	void PreloadLevel(FName LevelName);
+
+	UFUNCTION(BlueprintPure, Category = "Level")
+	bool IsLevelPreloaded(FName LevelName) const;
+
+	// Opens LevelName with the loading screen shown until the new map has loaded. Returns false when the travel
+	// could not start, including while another travel is in progress
+	UFUNCTION(BlueprintCallable, Category = "Level")
+	bool TravelToLevel(FName LevelName);
+
+	UFUNCTION(BlueprintPure, Category = "Level")
+	bool IsTravelling() const;
+
+	// LoadSeconds is measured from TravelToLevel to the new map being ready
+	UPROPERTY(BlueprintAssignable)
+	FOnLevelTransitionFinished OnLevelTransitionFinished;
+
+	// A started travel failed, the current map stays loaded
+	UPROPERTY(BlueprintAssignable)
+	FOnLevelTransitionFailed OnLevelTransitionFailed;
+
+private:
+	static FString GetLevelPackageName(FName LevelName);
+
+	void OnLevelPackageLoaded(const FName& PackageName, UPackage* LoadedPackage, EAsyncLoadingResult::Type Result);
+	void ShowLoadingScreen();
+	void OnPostLoadMap(UWorld* LoadedWorld);
+	void OnTravelFailure(UWorld* World, ETravelFailure::Type FailureType, const FString& ErrorString);
+	void OnNetworkFailure(UWorld* World, UNetDriver* NetDriver, ENetworkFailure::Type FailureType,
+	                      const FString& ErrorString);
+	void FailTravel(const FString& Reason);
+
+	// Holds the preloaded map so it is not garbage collected before the travel
+	UPROPERTY()
+	UPackage* PreloadedPackage;
+
+	FString PreloadingPackageName;
+	double PreloadStartTime = 0.0;
+
+	FName TravellingLevelName;
+	double TravelStartTime = 0.0;
+
+	FDelegateHandle PostLoadMapHandle;
+	FDelegateHandle TravelFailureHandle;
+	FDelegateHandle NetworkFailureHandle;
+};
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "Engine/DataAsset.h"
+#include "OsuType.h"
 #include "OsuMission.generated.h"
 
 UCLASS()
@@ -25,4 +26,20 @@ public:
 
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Mission")
 	int32 CountToComplete;
+
+	// Each of these events advances the mission by one, None leaves it to CompleteMission and AddMissionProgress
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Mission")
+	EObjectiveEvent ProgressEvent = EObjectiveEvent::None;
+
+	// Only events from actors with this tag count, None counts all of them
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Mission", meta = (EditCondition = "ProgressEvent != EObjectiveEvent::None"))
+	FName ProgressActorTag;
+
+	// Progress is ignored until all of these are completed
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Mission")
+	TArray<UOsuMission*> Prerequisites;
+
+	// Not needed to win the level
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Mission")
+	bool IsOptional = false;
 };
@@ -0,0 +1,180 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "OsuObjectiveGraph.h"
+
+#include "OsuMission.h"
+#include "GameFramework/Actor.h"
+
+void FOsuObjectiveGraph::Compile(const TArray<UOsuMission*>& InMissions)
+{
+	Missions.Reset();
+	ObjectiveIndices.Reset();
+	for (UOsuMission* Mission : InMissions)
+	{
+		if (Mission && !ObjectiveIndices.Contains(Mission))
+		{
+			ObjectiveIndices.Add(Mission, Missions.Add(Mission));
+		}
+	}
+
+	const int32 ObjectiveCount = Missions.Num();
+	Progress.Init(0, ObjectiveCount);
+	Targets.SetNumUninitialized(ObjectiveCount);
+	Optional.SetNumUninitialized(ObjectiveCount);
+	ActorTags.SetNumUninitialized(ObjectiveCount);
+
+	// Counting pass, then a fill pass, so both adjacency lists are single allocations
+	TArray<int32> DependentCounts;
+	DependentCounts.Init(0, ObjectiveCount);
+	TArray<int32> ListenerCounts;
+	ListenerCounts.Init(0, static_cast<int32>(EObjectiveEvent::Count));
+	for (int32 Objective = 0; Objective < ObjectiveCount; Objective++)
+	{
+		const UOsuMission* Mission = Missions[Objective];
+		Targets[Objective] = FMath::Max(1, Mission->CountToComplete);
+		Optional[Objective] = Mission->IsOptional;
+		ActorTags[Objective] = Mission->ProgressActorTag;
+		ListenerCounts[static_cast<int32>(Mission->ProgressEvent)]++;
+		for (const UOsuMission* Prerequisite : Mission->Prerequisites)
+		{
+			if (const int32* PrerequisiteIndex = ObjectiveIndices.Find(Prerequisite))
+			{
+				DependentCounts[*PrerequisiteIndex]++;
+			}
+		}
+	}
+
+	auto BuildStarts = [](const TArray<int32>& Counts, TArray<int32>& OutStarts)
+	{
+		OutStarts.SetNumUninitialized(Counts.Num() + 1);
+		OutStarts[0] = 0;
+		for (int32 Index = 0; Index < Counts.Num(); Index++)
+		{
+			OutStarts[Index + 1] = OutStarts[Index] + Counts[Index];
+		}
+	};
+	BuildStarts(DependentCounts, DependentStarts);
+	BuildStarts(ListenerCounts, EventListenerStarts);
+	Dependents.SetNumUninitialized(DependentStarts.Last());
+	EventListeners.SetNumUninitialized(EventListenerStarts.Last());
+
+	TArray<int32> DependentCursors(DependentStarts.GetData(), ObjectiveCount);
+	TArray<int32> ListenerCursors(EventListenerStarts.GetData(), ListenerCounts.Num());
+	for (int32 Objective = 0; Objective < ObjectiveCount; Objective++)
+	{
+		const UOsuMission* Mission = Missions[Objective];
+		EventListeners[ListenerCursors[static_cast<int32>(Mission->ProgressEvent)]++] = Objective;
+		for (const UOsuMission* Prerequisite : Mission->Prerequisites)
+		{
+			if (const int32* PrerequisiteIndex = ObjectiveIndices.Find(Prerequisite))
+			{
+				Dependents[DependentCursors[*PrerequisiteIndex]++] = Objective;
+			}
+		}
+	}
+
+	RebuildCounters();
+
+	// Kahn's algorithm, whatever is never unlocked sits on a cycle
+	TArray<int32> Unlocks = LockCounts;
+	TArray<int32> Ready;
+	for (int32 Objective = 0; Objective < ObjectiveCount; Objective++)
+	{
+		if (Unlocks[Objective] == 0)
+		{
+			Ready.Add(Objective);
+		}
+	}
+	int32 VisitedCount = 0;
+	while (!Ready.IsEmpty())
+	{
+		const int32 Objective = Ready.Pop(false);
+		VisitedCount++;
+		for (int32 Index = DependentStarts[Objective]; Index < DependentStarts[Objective + 1]; Index++)
+		{
+			if (--Unlocks[Dependents[Index]] == 0)
+			{
+				Ready.Add(Dependents[Index]);
+			}
+		}
+	}
+	if (VisitedCount != ObjectiveCount)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Mission prerequisites form a cycle, %d missions can never be unlocked"),
+		       ObjectiveCount - VisitedCount);
+	}
+}
+
+int32 FOsuObjectiveGraph::FindObjective(const UOsuMission* Mission) const
+{
+	const int32* Objective = ObjectiveIndices.Find(Mission);
+	return Objective ? *Objective : INDEX_NONE;
+}
+
+void FOsuObjectiveGraph::AddProgress(int32 Objective, int32 Amount, TOsuFrameArray<int32>& OutCompleted)
+{
+	if (!IsUnlocked(Objective) || IsCompleted(Objective))
+	{
+		return;
+	}
+	Progress[Objective] = FMath::Min(Progress[Objective] + Amount, Targets[Objective]);
+	if (IsCompleted(Objective))
+	{
+		Complete(Objective, OutCompleted);
+	}
+}
+
+void FOsuObjectiveGraph::CompleteObjective(int32 Objective, TOsuFrameArray<int32>& OutCompleted)
+{
+	AddProgress(Objective, Targets[Objective] - Progress[Objective], OutCompleted);
+}
+
+void FOsuObjectiveGraph::AddEventProgress(EObjectiveEvent Event, const AActor* Source, TOsuFrameArray<int32>& OutCompleted)
+{
+	const int32 EventIndex = static_cast<int32>(Event);
+	if (!EventListenerStarts.IsValidIndex(EventIndex + 1))
+	{
+		return;
+	}
+	for (int32 Index = EventListenerStarts[EventIndex]; Index < EventListenerStarts[EventIndex + 1]; Index++)
+	{
+		const int32 Objective = EventListeners[Index];
+		if (ActorTags[Objective].IsNone() || (Source && Source->ActorHasTag(ActorTags[Objective])))
+		{
+			AddProgress(Objective, 1, OutCompleted);
+		}
+	}
+}
+
+void FOsuObjectiveGraph::SetProgress(int32 Objective, int32 NewProgress)
+{
+	Progress[Objective] = FMath::Clamp(NewProgress, 0, Targets[Objective]);
+}
+
+void FOsuObjectiveGraph::RebuildCounters()
+{
+	LockCounts.Init(0, Missions.Num());
+	RemainingRequiredCount = 0;
+	for (int32 Objective = 0; Objective < Missions.Num(); Objective++)
+	{
+		if (!IsCompleted(Objective))
+		{
+			RemainingRequiredCount += Optional[Objective] ? 0 : 1;
+			for (int32 Index = DependentStarts[Objective]; Index < DependentStarts[Objective + 1]; Index++)
+			{
+				LockCounts[Dependents[Index]]++;
+			}
+		}
+	}
+}
+
+void FOsuObjectiveGraph::Complete(int32 Objective, TOsuFrameArray<int32>& OutCompleted)
+{
+	OutCompleted.Add(Objective);
+	RemainingRequiredCount -= Optional[Objective] ? 0 : 1;
+	for (int32 Index = DependentStarts[Objective]; Index < DependentStarts[Objective + 1]; Index++)
+	{
+		LockCounts[Dependents[Index]]--;
+	}
+}
@@ -0,0 +1,62 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OsuFrameArena.h"
+#include "OsuType.h"
+
+class UOsuMission;
+
+/**
+ * The missions of a level compiled into flat arrays once at level start. Progress updates only touch the
+ * objective and its dependents, and the counters of locked and unfinished required objectives are kept
+ * current so completion checks never scan.
+ */
+struct THEPATHOFOSU_API FOsuObjectiveGraph
+{
+	// Prerequisites outside Missions are ignored, a prerequisite cycle is reported and leaves its missions locked
+	void Compile(const TArray<UOsuMission*>& Missions);
+
+	int32 FindObjective(const UOsuMission* Mission) const;
+	int32 Num() const { return Missions.Num(); }
+	UOsuMission* GetMission(int32 Objective) const { return Missions[Objective]; }
+
+	// Returns the objectives completed by the call, progress on a locked or completed objective is dropped
+	void AddProgress(int32 Objective, int32 Amount, TOsuFrameArray<int32>& OutCompleted);
+	// Fills in whatever the compiled target still needs, the mission's CountToComplete may be below it
+	void CompleteObjective(int32 Objective, TOsuFrameArray<int32>& OutCompleted);
+	// Dropped until Compile has run
+	void AddEventProgress(EObjectiveEvent Event, const AActor* Source, TOsuFrameArray<int32>& OutCompleted);
+
+	// Puts back a saved count without reporting completions, counters are rebuilt once all are set
+	void SetProgress(int32 Objective, int32 NewProgress);
+	void RebuildCounters();
+
+	int32 GetProgress(int32 Objective) const { return Progress[Objective]; }
+	bool IsCompleted(int32 Objective) const { return Progress[Objective] >= Targets[Objective]; }
+	bool IsUnlocked(int32 Objective) const { return LockCounts[Objective] == 0; }
+	bool IsAllRequiredCompleted() const { return RemainingRequiredCount == 0; }
+
+private:
+	void Complete(int32 Objective, TOsuFrameArray<int32>& OutCompleted);
+
+	TArray<UOsuMission*> Missions;
+	TMap<const UOsuMission*, int32> ObjectiveIndices;
+
+	TArray<int32> Progress;
+	TArray<int32> Targets;
+	TArray<bool> Optional;
+	TArray<FName> ActorTags;
+	// Prerequisites not completed yet
+	TArray<int32> LockCounts;
+
+	// Dependents of objective I are Dependents[DependentStarts[I]] up to DependentStarts[I + 1]
+	TArray<int32> DependentStarts;
+	TArray<int32> Dependents;
+	// Same layout, the objectives advanced by each EObjectiveEvent
+	TArray<int32> EventListenerStarts;
+	TArray<int32> EventListeners;
+
+	int32 RemainingRequiredCount = 0;
+};
@@ -0,0 +1,301 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "OsuSaveSubsystem.h"
+
+#include "OsuGameInstance.h"
+#include "OsuLevelTransitionSubsystem.h"
+#include "Async/Async.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace
+{
+	constexpr uint32 SaveFileMagic = 0x4F535556; // "OSUV"
+	// Far above any real save, the header size is allocated before the payload can be checked
+	constexpr int32 MaxUncompressedSaveSize = 64 * 1024 * 1024;
+}
+
+void UOsuSaveSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	PostLoadMapHandle = FCoreUObjectDelegates::PostLoadMapWithWorld.AddUObject(this, &UOsuSaveSubsystem::OnPostLoadMap);
+	Collection.InitializeDependency<UOsuLevelTransitionSubsystem>()->OnLevelTransitionFailed.AddDynamic(
+		this, &UOsuSaveSubsystem::OnLevelTransitionFailed);
+}
+
+void UOsuSaveSubsystem::Deinitialize()
+{
+	FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(PostLoadMapHandle);
+	PendingLoadData.Reset();
+	Super::Deinitialize();
+}
+
+void UOsuSaveSubsystem::SaveGame(const FString& SlotName)
+{
+	if (SlotName.IsEmpty())
+	{
+		UE_LOG(LogTemp, Error, TEXT("SaveGame: SlotName is empty"));
+		return;
+	}
+	if (IsSaving)
+	{
+		QueuedSaveSlot = SlotName;
+		return;
+	}
+
+	UWorld* World = GetGameInstance()->GetWorld();
+	if (!World)
+	{
+		UE_LOG(LogTemp, Error, TEXT("SaveGame: World is null"));
+		return;
+	}
+
+	FSaveGameData Data;
+	Data.MapName = GetMapName(World);
+	if (const UOsuGameInstance* OsuGameInstance = Cast<UOsuGameInstance>(GetGameInstance()))
+	{
+		Data.MusicVolume = OsuGameInstance->MusicVolume;
+		Data.SFXVolume = OsuGameInstance->SFXVolume;
+	}
+	Data.WorldSnapshot.Capture(World);
+
+	TArray<uint8> Payload;
+	FMemoryWriter Writer(Payload);
+	Writer.SetIsSaveGame(true);
+	Writer << Data;
+
+	IsSaving = true;
+	AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask,
+	          [WeakThis = TWeakObjectPtr<UOsuSaveSubsystem>(this), SlotName, FilePath = GetSlotFilePath(SlotName),
+		          Payload = MoveTemp(Payload)]()
+	          {
+		          const bool IsSuccessful = WriteSaveFile(FilePath, Payload);
+		          AsyncTask(ENamedThreads::GameThread, [WeakThis, SlotName, IsSuccessful]()
+		          {
+			          if (UOsuSaveSubsystem* SaveSubsystem = WeakThis.Get())
+			          {
+				          SaveSubsystem->OnSaveFileWritten(SlotName, IsSuccessful);
+			          }
+		          });
+	          });
+}
+
+void UOsuSaveSubsystem::LoadGame(const FString& SlotName)
+{
+	if (IsLoading)
+	{
+		UE_LOG(LogTemp, Error, TEXT("LoadGame: already loading, %s ignored"), *SlotName);
+		return;
+	}
+
+	IsLoading = true;
+	AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask,
+	          [WeakThis = TWeakObjectPtr<UOsuSaveSubsystem>(this), SlotName, FilePath = GetSlotFilePath(SlotName)]()
+	          {
+		          TArray<uint8> Payload;
+		          int32 Version = 0;
+		          const bool IsSuccessful = ReadSaveFile(FilePath, Payload, Version);
+		          AsyncTask(ENamedThreads::GameThread, [WeakThis, SlotName, Payload = MoveTemp(Payload), Version,
+			                    IsSuccessful]()
+		                    {
+			                    if (UOsuSaveSubsystem* SaveSubsystem = WeakThis.Get())
+			                    {
+				                    SaveSubsystem->OnSaveFileRead(SlotName, Payload, Version, IsSuccessful);
+			                    }
+		                    });
+	          });
+}
+
+bool UOsuSaveSubsystem::DoesSaveGameExist(const FString& SlotName) const
+{
+	return IFileManager::Get().FileExists(*GetSlotFilePath(SlotName));
+}
+
+bool UOsuSaveSubsystem::IsBusy() const
+{
+	return IsSaving || IsLoading;
+}
+
+FString UOsuSaveSubsystem::GetSlotFilePath(const FString& SlotName)
+{
+	return FPaths::ProjectSavedDir() / TEXT("SaveGames") / SlotName + TEXT(".osusave");
+}
+
+FString UOsuSaveSubsystem::GetMapName(const UWorld* World)
+{
+	return UWorld::RemovePIEPrefix(World->GetOutermost()->GetName());
+}
+
+bool UOsuSaveSubsystem::WriteSaveFile(const FString& FilePath, const TArray<uint8>& Payload)
+{
+	TArray<uint8> FileData;
+	FMemoryWriter Writer(FileData);
+	uint32 Magic = SaveFileMagic;
+	int32 Version = FOsuSaveVersion::LatestVersion;
+	int32 UncompressedSize = Payload.Num();
+	Writer << Magic << Version << UncompressedSize;
+
+	const int32 HeaderSize = FileData.Num();
+	int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Oodle, UncompressedSize);
+	FileData.AddUninitialized(CompressedSize);
+	if (!FCompression::CompressMemory(NAME_Oodle, FileData.GetData() + HeaderSize, CompressedSize,
+	                                  Payload.GetData(), UncompressedSize))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Failed to compress save game %s"), *FilePath);
+		return false;
+	}
+	FileData.SetNum(HeaderSize + CompressedSize);
+
+	// Written next to the slot and moved over it, a crash mid write keeps the previous save intact
+	const FString TempFilePath = FilePath + TEXT(".tmp");
+	if (!FFileHelper::SaveArrayToFile(FileData, *TempFilePath) || !IFileManager::Get().Move(*FilePath, *TempFilePath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Failed to write save game %s"), *FilePath);
+		return false;
+	}
+	return true;
+}
+
+bool UOsuSaveSubsystem::ReadSaveFile(const FString& FilePath, TArray<uint8>& OutPayload, int32& OutVersion)
+{
+	TArray<uint8> FileData;
+	if (!FFileHelper::LoadFileToArray(FileData, *FilePath, FILEREAD_Silent))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Failed to read save game %s"), *FilePath);
+		return false;
+	}
+
+	FMemoryReader Reader(FileData);
+	uint32 Magic = 0;
+	int32 UncompressedSize = 0;
+	Reader << Magic << OutVersion << UncompressedSize;
+	if (Reader.IsError() || Magic != SaveFileMagic || UncompressedSize < 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s is not a save game"), *FilePath);
+		return false;
+	}
+	if (OutVersion < FOsuSaveVersion::Initial || OutVersion > FOsuSaveVersion::LatestVersion)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Save game %s has unsupported version %d"), *FilePath, OutVersion);
+		return false;
+	}
+	if (UncompressedSize > MaxUncompressedSaveSize)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Save game %s claims %d bytes, more than the %d allowed"), *FilePath,
+		       UncompressedSize, MaxUncompressedSaveSize);
+		return false;
+	}
+
+	const int32 HeaderSize = Reader.Tell();
+	OutPayload.SetNumUninitialized(UncompressedSize);
+	if (!FCompression::UncompressMemory(NAME_Oodle, OutPayload.GetData(), UncompressedSize,
+	                                    FileData.GetData() + HeaderSize, FileData.Num() - HeaderSize))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Failed to decompress save game %s"), *FilePath);
+		return false;
+	}
+	return true;
+}
+
+void UOsuSaveSubsystem::OnSaveFileWritten(const FString& SlotName, bool IsSuccessful)
+{
+	IsSaving = false;
+	OnSaveFinished.Broadcast(SlotName, IsSuccessful);
+
+	if (!QueuedSaveSlot.IsEmpty())
+	{
+		const FString NextSlotName = MoveTemp(QueuedSaveSlot);
+		QueuedSaveSlot.Reset();
+		SaveGame(NextSlotName);
+	}
+}
+
+void UOsuSaveSubsystem::OnSaveFileRead(const FString& SlotName, const TArray<uint8>& Payload, int32 Version,
+                                       bool IsSuccessful)
+{
+	UWorld* World = GetGameInstance()->GetWorld();
+	if (!IsSuccessful || !World)
+	{
+		IsLoading = false;
+		OnLoadFinished.Broadcast(SlotName, false);
+		return;
+	}
+
+	FSaveGameData Data;
+	FMemoryReader Reader(Payload);
+	Reader.SetIsSaveGame(true);
+	Reader.SetCustomVersion(FOsuSaveVersion::GUID, Version, TEXT("OsuSave"));
+	Reader << Data;
+	if (Reader.IsError())
+	{
+		UE_LOG(LogTemp, Error, TEXT("Save game %s is corrupted"), *SlotName);
+		IsLoading = false;
+		OnLoadFinished.Broadcast(SlotName, false);
+		return;
+	}
+
+	if (GetMapName(World) == Data.MapName)
+	{
+		ApplySaveGameData(World, SlotName, Data);
+		return;
+	}
+	PendingLoadData = MoveTemp(Data);
+	PendingLoadSlot = SlotName;
+	if (!GetGameInstance()->GetSubsystem<UOsuLevelTransitionSubsystem>()->TravelToLevel(
+		FName(*PendingLoadData->MapName)))
+	{
+		FailPendingLoad();
+	}
+}
+
+void UOsuSaveSubsystem::OnLevelTransitionFailed(FName LevelName)
+{
+	if (PendingLoadData.IsSet())
+	{
+		FailPendingLoad();
+	}
+}
+
+void UOsuSaveSubsystem::FailPendingLoad()
+{
+	UE_LOG(LogTemp, Error, TEXT("Save game %s: could not open map %s"), *PendingLoadSlot, *PendingLoadData->MapName);
+	PendingLoadData.Reset();
+	IsLoading = false;
+	OnLoadFinished.Broadcast(PendingLoadSlot, false);
+}
+
+void UOsuSaveSubsystem::ApplySaveGameData(UWorld* World, const FString& SlotName, const FSaveGameData& Data)
+{
+	if (UOsuGameInstance* OsuGameInstance = Cast<UOsuGameInstance>(GetGameInstance()))
+	{
+		OsuGameInstance->MusicVolume = Data.MusicVolume;
+		OsuGameInstance->SFXVolume = Data.SFXVolume;
+	}
+	Data.WorldSnapshot.Restore(World);
+
+	IsLoading = false;
+	OnLoadFinished.Broadcast(SlotName, true);
+}
+
+void UOsuSaveSubsystem::OnPostLoadMap(UWorld* LoadedWorld)
+{
+	if (!PendingLoadData.IsSet() || !LoadedWorld || LoadedWorld->GetGameInstance() != GetGameInstance())
+	{
+		return;
+	}
+
+	const FSaveGameData Data = MoveTemp(PendingLoadData.GetValue());
+	PendingLoadData.Reset();
+	if (GetMapName(LoadedWorld) != Data.MapName)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Save game %s expects map %s"), *PendingLoadSlot, *Data.MapName);
+		IsLoading = false;
+		OnLoadFinished.Broadcast(PendingLoadSlot, false);
+		return;
+	}
+	ApplySaveGameData(LoadedWorld, PendingLoadSlot, Data);
+}
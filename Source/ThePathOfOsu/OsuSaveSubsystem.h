@@ -0,0 +1,87 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OsuWorldSnapshot.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "OsuSaveSubsystem.generated.h"
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnSaveGameFinished, const FString&, SlotName, bool, IsSuccessful);
+
+/**
+ * One compressed binary file per save slot. The snapshot is gathered on the game thread, compression and file IO
+ * run on a background thread. A slot saved on another map opens that map first and is applied once it has loaded.
+ */
+UCLASS()
+class THEPATHOFOSU_API UOsuSaveSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	// Saving again while a save is still being written queues the latest request instead of dropping it
+	UFUNCTION(BlueprintCallable, Category = "Save")
+	void SaveGame(const FString& SlotName);
+
+	UFUNCTION(BlueprintCallable, Category = "Save")
+	void LoadGame(const FString& SlotName);
+
+	UFUNCTION(BlueprintPure, Category = "Save")
+	bool DoesSaveGameExist(const FString& SlotName) const;
+
+	UFUNCTION(BlueprintPure, Category = "Save")
+	bool IsBusy() const;
+
+	UPROPERTY(BlueprintAssignable)
+	FOnSaveGameFinished OnSaveFinished;
+
+	UPROPERTY(BlueprintAssignable)
+	FOnSaveGameFinished OnLoadFinished;
+
+private:
+	struct FSaveGameData
+	{
+		// Long package name of the map, without the PIE prefix
+		FString MapName;
+		float MusicVolume = 100.0f;
+		float SFXVolume = 100.0f;
+		FOsuWorldSnapshot WorldSnapshot;
+
+		friend FArchive& operator<<(FArchive& Ar, FSaveGameData& Data)
+		{
+			Ar << Data.MapName;
+			Ar << Data.MusicVolume;
+			Ar << Data.SFXVolume;
+			Ar << Data.WorldSnapshot;
+			return Ar;
+		}
+	};
+
+	static FString GetSlotFilePath(const FString& SlotName);
+	static FString GetMapName(const UWorld* World);
+
+	// Run on a background thread
+	static bool WriteSaveFile(const FString& FilePath, const TArray<uint8>& Payload);
+	static bool ReadSaveFile(const FString& FilePath, TArray<uint8>& OutPayload, int32& OutVersion);
+
+	void OnSaveFileWritten(const FString& SlotName, bool IsSuccessful);
+	void OnSaveFileRead(const FString& SlotName, const TArray<uint8>& Payload, int32 Version, bool IsSuccessful);
+	void ApplySaveGameData(UWorld* World, const FString& SlotName, const FSaveGameData& Data);
+	void OnPostLoadMap(UWorld* LoadedWorld);
+	UFUNCTION()
+	void OnLevelTransitionFailed(FName LevelName);
+	void FailPendingLoad();
+
+	bool IsSaving = false;
+	bool IsLoading = false;
+	FString QueuedSaveSlot;
+
+	// Read from disk and waiting for its map to finish loading
+	TOptional<FSaveGameData> PendingLoadData;
+	FString PendingLoadSlot;
+
+	FDelegateHandle PostLoadMapHandle;
+};
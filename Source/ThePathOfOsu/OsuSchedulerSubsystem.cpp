@@ -0,0 +1,270 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "OsuSchedulerSubsystem.h"
+
+namespace
+{
+	TAutoConsoleVariable<float> CVarSchedulerBudgetMs(
+		TEXT("Osu.Scheduler.BudgetMs"),
+		1.0f,
+		TEXT("Game thread time queued scheduler work may spend per frame, at least one step runs per frame"));
+
+	// A bucket is split so each slice lasts about a frame at 60 fps, capped to keep short intervals responsive
+	constexpr float TargetSliceSeconds = 1.0f / 60.0f;
+	constexpr int32 MaxSlicesPerBucket = 8;
+}
+
+void UOsuSchedulerSubsystem::SchedulePeriodic(FOsuJobHandle& Handle, FName JobName, float Interval,
+                                              FSimpleDelegate Job)
+{
+	Cancel(Handle);
+	FJob NewJob{NextJobId++, FindOrAddStats(JobName), MoveTemp(Job)};
+	ScheduledIds.Add(NewJob.Id);
+	Handle.Id = NewJob.Id;
+	if (IsRunningJobs)
+	{
+		PendingPeriodicJobs.Emplace(Interval, MoveTemp(NewJob));
+	}
+	else
+	{
+		AddToBucket(Interval, MoveTemp(NewJob));
+	}
+}
+
+void UOsuSchedulerSubsystem::AddToBucket(float Interval, FJob&& Job)
+{
+	// The least busy slice takes the job, which spreads jobs of one interval over its frames
+	FBucket& Bucket = FindOrAddBucket(Interval);
+	TArray<FJob>* LeastBusySlice = &Bucket.Slices[0];
+	for (TArray<FJob>& Slice : Bucket.Slices)
+	{
+		if (Slice.Num() < LeastBusySlice->Num())
+		{
+			LeastBusySlice = &Slice;
+		}
+	}
+	LeastBusySlice->Add(MoveTemp(Job));
+}
+
+void UOsuSchedulerSubsystem::ScheduleOnce(FOsuJobHandle& Handle, FName JobName, float Delay, FSimpleDelegate Job)
+{
+	Cancel(Handle);
+	FOneShotJob NewJob{{NextJobId++, FindOrAddStats(JobName), MoveTemp(Job)}, Delay};
+	ScheduledIds.Add(NewJob.Job.Id);
+	Handle.Id = NewJob.Job.Id;
+	(IsRunningJobs ? PendingOneShotJobs : OneShotJobs).Add(MoveTemp(NewJob));
+}
+
+void UOsuSchedulerSubsystem::Cancel(FOsuJobHandle& Handle)
+{
+	// The entry itself is dropped the next time its slice or the one shots are run
+	ScheduledIds.Remove(Handle.Id);
+	Handle.Invalidate();
+}
+
+bool UOsuSchedulerSubsystem::IsScheduled(const FOsuJobHandle& Handle) const
+{
+	return ScheduledIds.Contains(Handle.Id);
+}
+
+void UOsuSchedulerSubsystem::EnqueueWork(FName JobName, TFunction<bool()> Step)
+{
+	QueuedWork.Add({FindOrAddStats(JobName), MoveTemp(Step)});
+}
+
+UOsuSchedulerSubsystem::FBucket& UOsuSchedulerSubsystem::FindOrAddBucket(float Interval)
+{
+	if (FBucket* Bucket = Buckets.FindByPredicate([Interval](const FBucket& Candidate)
+	{
+		return FMath::IsNearlyEqual(Candidate.Interval, Interval);
+	}))
+	{
+		return *Bucket;
+	}
+	FBucket& Bucket = Buckets.AddDefaulted_GetRef();
+	Bucket.Interval = FMath::Max(Interval, KINDA_SMALL_NUMBER);
+	Bucket.Slices.SetNum(FMath::Clamp(FMath::RoundToInt32(Bucket.Interval / TargetSliceSeconds), 1,
+	                                  MaxSlicesPerBucket));
+	return Bucket;
+}
+
+int32 UOsuSchedulerSubsystem::FindOrAddStats(FName JobName)
+{
+	if (const int32* StatsIndex = StatsIndices.Find(JobName))
+	{
+		return *StatsIndex;
+	}
+	const int32 StatsIndex = Stats.Add({JobName});
+	StatsIndices.Add(JobName, StatsIndex);
+	return StatsIndex;
+}
+
+bool UOsuSchedulerSubsystem::RunJob(const FJob& Job)
+{
+	if (!ScheduledIds.Contains(Job.Id))
+	{
+		return false;
+	}
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+	if (!Job.Delegate.ExecuteIfBound())
+	{
+		ScheduledIds.Remove(Job.Id);
+		return false;
+	}
+	RecordCost(Job.StatsIndex, StartCycles);
+	// The job may have cancelled itself
+	return ScheduledIds.Contains(Job.Id);
+}
+
+void UOsuSchedulerSubsystem::RecordCost(int32 StatsIndex, uint64 StartCycles)
+{
+	const uint64 Cycles = FPlatformTime::Cycles64() - StartCycles;
+	FJobStats& JobStats = Stats[StatsIndex];
+	JobStats.CallCount++;
+	JobStats.TotalCycles += Cycles;
+	JobStats.MaxCycles = FMath::Max(JobStats.MaxCycles, Cycles);
+}
+
+void UOsuSchedulerSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	IsRunningJobs = true;
+	RunBuckets(DeltaTime);
+	RunOneShots(DeltaTime);
+	IsRunningJobs = false;
+	AddPendingJobs();
+	RunQueuedWork();
+}
+
+void UOsuSchedulerSubsystem::RunBuckets(float DeltaTime)
+{
+	for (FBucket& Bucket : Buckets)
+	{
+		const float SliceSeconds = Bucket.Interval / Bucket.Slices.Num();
+		Bucket.SliceElapsed += DeltaTime;
+		const int32 DueSlices = FMath::FloorToInt32(Bucket.SliceElapsed / SliceSeconds);
+		Bucket.SliceElapsed -= DueSlices * SliceSeconds;
+		// After a hitch every slice runs once instead of catching up on every missed interval
+		int32 SlicesToRun = FMath::Min(DueSlices, Bucket.Slices.Num());
+		for (; SlicesToRun > 0; SlicesToRun--)
+		{
+			TArray<FJob>& Slice = Bucket.Slices[Bucket.NextSlice];
+			Bucket.NextSlice = (Bucket.NextSlice + 1) % Bucket.Slices.Num();
+			for (int32 Index = Slice.Num() - 1; Index >= 0; --Index)
+			{
+				if (!RunJob(Slice[Index]))
+				{
+					Slice.RemoveAtSwap(Index, 1, false);
+				}
+			}
+		}
+	}
+}
+
+void UOsuSchedulerSubsystem::RunOneShots(float DeltaTime)
+{
+	for (int32 Index = OneShotJobs.Num() - 1; Index >= 0; --Index)
+	{
+		FOneShotJob& OneShotJob = OneShotJobs[Index];
+		OneShotJob.Remaining -= DeltaTime;
+		if (!ScheduledIds.Contains(OneShotJob.Job.Id))
+		{
+			OneShotJobs.RemoveAtSwap(Index, 1, false);
+		}
+		else if (OneShotJob.Remaining <= 0.0f)
+		{
+			RunJob(OneShotJob.Job);
+			ScheduledIds.Remove(OneShotJob.Job.Id);
+			OneShotJobs.RemoveAtSwap(Index, 1, false);
+		}
+	}
+}
+
+void UOsuSchedulerSubsystem::AddPendingJobs()
+{
+	for (TPair<float, FJob>& PendingJob : PendingPeriodicJobs)
+	{
+		if (ScheduledIds.Contains(PendingJob.Value.Id))
+		{
+			AddToBucket(PendingJob.Key, MoveTemp(PendingJob.Value));
+		}
+	}
+	PendingPeriodicJobs.Reset();
+	OneShotJobs.Append(MoveTemp(PendingOneShotJobs));
+	PendingOneShotJobs.Reset();
+}
+
+void UOsuSchedulerSubsystem::RunQueuedWork()
+{
+	const double BudgetSeconds = CVarSchedulerBudgetMs.GetValueOnGameThread() / 1000.0;
+	const double FrameStartTime = FPlatformTime::Seconds();
+	do
+	{
+		if (QueuedWork.IsEmpty())
+		{
+			return;
+		}
+		const uint64 StartCycles = FPlatformTime::Cycles64();
+		const bool IsDone = QueuedWork[0].Step();
+		RecordCost(QueuedWork[0].StatsIndex, StartCycles);
+		if (IsDone)
+		{
+			QueuedWork.RemoveAt(0, 1, false);
+		}
+	}
+	while (FPlatformTime::Seconds() - FrameStartTime < BudgetSeconds);
+}
+
+bool UOsuSchedulerSubsystem::IsTickable() const
+{
+	return !ScheduledIds.IsEmpty() || !QueuedWork.IsEmpty();
+}
+
+TStatId UOsuSchedulerSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UOsuSchedulerSubsystem, STATGROUP_Tickables);
+}
+
+void UOsuSchedulerSubsystem::DumpStats()
+{
+	UE_LOG(LogTemp, Display, TEXT("%s: %d scheduled jobs, %d queued work items"), *GetWorld()->GetName(),
+	       ScheduledIds.Num(), QueuedWork.Num());
+	for (const FBucket& Bucket : Buckets)
+	{
+		int32 JobCount = 0;
+		for (const TArray<FJob>& Slice : Bucket.Slices)
+		{
+			JobCount += Slice.Num();
+		}
+		UE_LOG(LogTemp, Display, TEXT("  Bucket %6.3fs: %3d jobs over %d slices"), Bucket.Interval, JobCount,
+		       Bucket.Slices.Num());
+	}
+	for (FJobStats& JobStats : Stats)
+	{
+		if (JobStats.CallCount == 0)
+		{
+			continue;
+		}
+		UE_LOG(LogTemp, Display, TEXT("  %-24s %6d calls, %8.2f us avg, %8.2f us max, %8.3f ms total"),
+		       *JobStats.Name.ToString(), JobStats.CallCount,
+		       FPlatformTime::ToSeconds64(JobStats.TotalCycles) * 1e6 / JobStats.CallCount,
+		       FPlatformTime::ToSeconds64(JobStats.MaxCycles) * 1e6,
+		       FPlatformTime::ToSeconds64(JobStats.TotalCycles) * 1e3);
+		JobStats.CallCount = 0;
+		JobStats.TotalCycles = 0;
+		JobStats.MaxCycles = 0;
+	}
+}
+
+static FAutoConsoleCommandWithWorld DumpSchedulerCommand(
+	TEXT("Osu.Scheduler.Dump"),
+	TEXT("Prints the scheduler buckets and the cost of every job since the last dump, then resets the costs"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (UOsuSchedulerSubsystem* Scheduler = World->GetSubsystem<UOsuSchedulerSubsystem>())
+		{
+			Scheduler->DumpStats();
+		}
+	}));
@@ -0,0 +1,113 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "OsuSchedulerSubsystem.generated.h"
+
+// Identifies a scheduled job, zero when not scheduled
+struct FOsuJobHandle
+{
+	uint32 Id = 0;
+
+	bool IsValid() const { return Id != 0; }
+	void Invalidate() { Id = 0; }
+};
+
+/**
+ * Runs the gameplay code that used to sit on its own timer handle. Periodic jobs sharing an interval are kept in
+ * one bucket, split into phase slices that run on different frames, so a room full of 0.1s checks does not
+ * land on the same frame. One shot jobs replace single timers, and queued work is stepped under
+ * Osu.Scheduler.BudgetMs per frame. Jobs bound to a destroyed object are dropped.
+ * Osu.Scheduler.Dump prints the cost of every job name since the last dump.
+ */
+UCLASS()
+class THEPATHOFOSU_API UOsuSchedulerSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// Runs Job every Interval seconds of world time, at most once per frame. Its first run is within one Interval.
+	// Like FTimerManager::SetTimer, a job already scheduled on Handle is cancelled first
+	void SchedulePeriodic(FOsuJobHandle& Handle, FName JobName, float Interval, FSimpleDelegate Job);
+
+	void ScheduleOnce(FOsuJobHandle& Handle, FName JobName, float Delay, FSimpleDelegate Job);
+
+	// Safe to call from inside a job, including the job itself. Invalidates Handle
+	void Cancel(FOsuJobHandle& Handle);
+
+	bool IsScheduled(const FOsuJobHandle& Handle) const;
+
+	// Step is called once per frame at least and then again while the budget lasts, until it returns true
+	void EnqueueWork(FName JobName, TFunction<bool()> Step);
+
+	void DumpStats();
+
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+
+private:
+	struct FJob
+	{
+		uint32 Id;
+		int32 StatsIndex;
+		FSimpleDelegate Delegate;
+	};
+
+	struct FBucket
+	{
+		float Interval;
+		float SliceElapsed = 0.0f;
+		int32 NextSlice = 0;
+		TArray<TArray<FJob>> Slices;
+	};
+
+	struct FOneShotJob
+	{
+		FJob Job;
+		float Remaining;
+	};
+
+	struct FQueuedWork
+	{
+		int32 StatsIndex;
+		TFunction<bool()> Step;
+	};
+
+	struct FJobStats
+	{
+		FName Name;
+		int32 CallCount = 0;
+		uint64 TotalCycles = 0;
+		uint64 MaxCycles = 0;
+	};
+
+	FBucket& FindOrAddBucket(float Interval);
+	void AddToBucket(float Interval, FJob&& Job);
+	int32 FindOrAddStats(FName JobName);
+
+	// Returns false once the job's object is gone or the job was cancelled
+	bool RunJob(const FJob& Job);
+	void RecordCost(int32 StatsIndex, uint64 StartCycles);
+
+	void RunBuckets(float DeltaTime);
+	void RunOneShots(float DeltaTime);
+	void RunQueuedWork();
+	void AddPendingJobs();
+
+	TArray<FBucket> Buckets;
+	TArray<FOneShotJob> OneShotJobs;
+	TArray<FQueuedWork> QueuedWork;
+
+	// Scheduled while jobs were running, a job array must not grow under the delegate being executed
+	TArray<TPair<float, FJob>> PendingPeriodicJobs;
+	TArray<FOneShotJob> PendingOneShotJobs;
+
+	TSet<uint32> ScheduledIds;
+	TArray<FJobStats> Stats;
+	TMap<FName, int32> StatsIndices;
+	uint32 NextJobId = 1;
+	bool IsRunningJobs = false;
+};
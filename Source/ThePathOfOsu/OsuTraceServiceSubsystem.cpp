@@ -0,0 +1,206 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "OsuTraceServiceSubsystem.h"
+
+#include "OsuFrameArena.h"
+
+namespace
+{
+	TAutoConsoleVariable<bool> CVarShowTraces(
+		TEXT("Osu.Traces.Show"),
+		false,
+		TEXT("Draws the scene queries of the last frame per caller on screen"));
+}
+
+bool UOsuTraceServiceSubsystem::LineTraceSingleByChannel(FHitResult& OutHit, const FVector& Start,
+                                                         const FVector& End, ECollisionChannel Channel,
+                                                         const FCollisionQueryParams& Params)
+{
+	FCallerStats& Stats = CountTrace(Params.TraceTag, EOsuTraceLatency::Immediate);
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+	const bool IsHit = GetWorld()->LineTraceSingleByChannel(OutHit, Start, End, Channel, Params);
+	Stats.ImmediateCycles += FPlatformTime::Cycles64() - StartCycles;
+	return IsHit;
+}
+
+bool UOsuTraceServiceSubsystem::LineTraceMultiByObjectType(TArray<FHitResult>& OutHits, const FVector& Start,
+                                                           const FVector& End,
+                                                           const FCollisionObjectQueryParams& ObjectParams,
+                                                           const FCollisionQueryParams& Params)
+{
+	FCallerStats& Stats = CountTrace(Params.TraceTag, EOsuTraceLatency::Immediate);
+	OutHits.Reset();
+	const SIZE_T HitsSize = OutHits.GetAllocatedSize();
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+	const bool IsHit = GetWorld()->LineTraceMultiByObjectType(OutHits, Start, End, ObjectParams, Params);
+	Stats.ImmediateCycles += FPlatformTime::Cycles64() - StartCycles;
+	FOsuFrameArena::Get().ReportBufferGrowth(OutHits, HitsSize);
+	return IsHit;
+}
+
+bool UOsuTraceServiceSubsystem::SweepSingleByObjectType(FHitResult& OutHit, const FVector& Start,
+                                                        const FVector& End,
+                                                        const FCollisionObjectQueryParams& ObjectParams,
+                                                        const FCollisionShape& Shape,
+                                                        const FCollisionQueryParams& Params)
+{
+	FCallerStats& Stats = CountTrace(Params.TraceTag, EOsuTraceLatency::Immediate);
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+	const bool IsHit = GetWorld()->SweepSingleByObjectType(OutHit, Start, End, FQuat::Identity, ObjectParams, Shape,
+	                                                       Params);
+	Stats.ImmediateCycles += FPlatformTime::Cycles64() - StartCycles;
+	return IsHit;
+}
+
+bool UOsuTraceServiceSubsystem::OverlapBlockingTestByChannel(const FVector& Position, ECollisionChannel Channel,
+                                                             const FCollisionShape& Shape,
+                                                             const FCollisionQueryParams& Params)
+{
+	FCallerStats& Stats = CountTrace(Params.TraceTag, EOsuTraceLatency::Immediate);
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+	const bool IsOverlapping = GetWorld()->OverlapBlockingTestByChannel(Position, FQuat::Identity, Channel, Shape,
+	                                                                    Params);
+	Stats.ImmediateCycles += FPlatformTime::Cycles64() - StartCycles;
+	return IsOverlapping;
+}
+
+void UOsuTraceServiceSubsystem::OverlapMultiByObjectType(EOsuTraceLatency Latency, const FVector& Position,
+                                                         const FCollisionObjectQueryParams& ObjectParams,
+                                                         const FCollisionShape& Shape,
+                                                         const FCollisionQueryParams& Params,
+                                                         FOsuOverlapResultDelegate OnResult)
+{
+	FCallerStats& Stats = CountTrace(Params.TraceTag, Latency);
+	if (Latency == EOsuTraceLatency::NextFrame)
+	{
+		// Read back by handle rather than through a batch delegate, so the result lands in the pooled datum
+		const FTraceHandle TraceHandle = GetWorld()->AsyncOverlapByObjectType(Position, FQuat::Identity,
+		                                                                      ObjectParams, Shape, Params);
+		PendingOverlaps.Add({TraceHandle, GFrameCounter, MoveTemp(OnResult)});
+		return;
+	}
+
+	TArray<FOverlapResult> Overlaps = MoveTemp(OverlapScratch);
+	Overlaps.Reset();
+	const SIZE_T OverlapsSize = Overlaps.GetAllocatedSize();
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+	GetWorld()->OverlapMultiByObjectType(Overlaps, Position, FQuat::Identity, ObjectParams, Shape, Params);
+	Stats.ImmediateCycles += FPlatformTime::Cycles64() - StartCycles;
+	FOsuFrameArena::Get().ReportBufferGrowth(Overlaps, OverlapsSize);
+	OnResult.ExecuteIfBound(Overlaps);
+	OverlapScratch = MoveTemp(Overlaps);
+}
+
+void UOsuTraceServiceSubsystem::DeliverAsyncOverlaps()
+{
+	// Swapped out, a callback may queue the next scan. Queries issued earlier this frame have not run yet
+	Swap(PendingOverlaps, DeliveringOverlaps);
+	for (FPendingOverlap& PendingOverlap : DeliveringOverlaps)
+	{
+		if (PendingOverlap.Frame == GFrameCounter)
+		{
+			PendingOverlaps.Add(MoveTemp(PendingOverlap));
+			continue;
+		}
+		// Only last frame's batch is still readable, a query missed while paused is dropped
+		const SIZE_T OverlapsSize = OverlapDatum.OutOverlaps.GetAllocatedSize();
+		if (GetWorld()->QueryOverlapData(PendingOverlap.TraceHandle, OverlapDatum))
+		{
+			FOsuFrameArena::Get().ReportBufferGrowth(OverlapDatum.OutOverlaps, OverlapsSize);
+			PendingOverlap.OnResult.ExecuteIfBound(OverlapDatum.OutOverlaps);
+		}
+	}
+	DeliveringOverlaps.Reset();
+}
+
+UOsuTraceServiceSubsystem::FCallerStats& UOsuTraceServiceSubsystem::CountTrace(FName Caller,
+	EOsuTraceLatency Latency)
+{
+	int32 CallerIndex;
+	if (const int32* FoundIndex = CallerIndices.Find(Caller))
+	{
+		CallerIndex = *FoundIndex;
+	}
+	else
+	{
+		CallerIndex = Callers.Add({Caller});
+		CallerIndices.Add(Caller, CallerIndex);
+	}
+
+	FCallerStats& Stats = Callers[CallerIndex];
+	(Latency == EOsuTraceLatency::Immediate ? Stats.FrameImmediate : Stats.FrameAsync)++;
+	return Stats;
+}
+
+void UOsuTraceServiceSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	DeliverAsyncOverlaps();
+
+	FrameCount++;
+	const bool IsShowingTraces = CVarShowTraces.GetValueOnGameThread() && GEngine;
+	for (FCallerStats& Stats : Callers)
+	{
+		Stats.LastFrameImmediate = Stats.FrameImmediate;
+		Stats.LastFrameAsync = Stats.FrameAsync;
+		Stats.PeakFrameTraces = FMath::Max(Stats.PeakFrameTraces, Stats.FrameImmediate + Stats.FrameAsync);
+		Stats.TotalImmediate += Stats.FrameImmediate;
+		Stats.TotalAsync += Stats.FrameAsync;
+		Stats.FrameImmediate = 0;
+		Stats.FrameAsync = 0;
+
+		if (IsShowingTraces)
+		{
+			// Keyed by caller so the line is replaced every frame instead of stacking up
+			GEngine->AddOnScreenDebugMessage(static_cast<uint64>(GetTypeHash(Stats.Caller)), 0.0f, FColor::White,
+			                                 FString::Printf(TEXT("Traces %s: %d immediate, %d next frame"),
+			                                                 *Stats.Caller.ToString(), Stats.LastFrameImmediate,
+			                                                 Stats.LastFrameAsync));
+		}
+	}
+}
+
+bool UOsuTraceServiceSubsystem::IsTickable() const
+{
+	return !Callers.IsEmpty();
+}
+
+TStatId UOsuTraceServiceSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UOsuTraceServiceSubsystem, STATGROUP_Tickables);
+}
+
+void UOsuTraceServiceSubsystem::DumpStats()
+{
+	UE_LOG(LogTemp, Display, TEXT("%s: scene queries over %llu frames"), *GetWorld()->GetName(), FrameCount);
+	const double Frames = FMath::Max<double>(FrameCount, 1);
+	for (FCallerStats& Stats : Callers)
+	{
+		if (Stats.TotalImmediate + Stats.TotalAsync == 0)
+		{
+			continue;
+		}
+		UE_LOG(LogTemp, Display,
+		       TEXT("  %-28s %6.2f immediate %6.2f next frame per frame, peak %3d in a frame, %.3f ms immediate"),
+		       *Stats.Caller.ToString(), Stats.TotalImmediate / Frames, Stats.TotalAsync / Frames,
+		       Stats.PeakFrameTraces, FPlatformTime::ToMilliseconds64(Stats.ImmediateCycles));
+		Stats.PeakFrameTraces = 0;
+		Stats.TotalImmediate = 0;
+		Stats.TotalAsync = 0;
+		Stats.ImmediateCycles = 0;
+	}
+	FrameCount = 0;
+}
+
+static FAutoConsoleCommandWithWorld DumpTracesCommand(
+	TEXT("Osu.Traces.Dump"),
+	TEXT("Prints the scene queries per frame of every caller since the last dump, then resets them"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (UOsuTraceServiceSubsystem* TraceService = World->GetSubsystem<UOsuTraceServiceSubsystem>())
+		{
+			TraceService->DumpStats();
+		}
+	}));
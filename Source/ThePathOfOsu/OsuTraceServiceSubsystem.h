@@ -0,0 +1,90 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OsuType.h"
+#include "WorldCollision.h"
+#include "Engine/OverlapResult.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "OsuTraceServiceSubsystem.generated.h"
+
+DECLARE_DELEGATE_OneParam(FOsuOverlapResultDelegate, const TArray<FOverlapResult>&);
+
+/**
+ * Front for the gameplay scene queries. Queries whose answer decides what happens this frame run immediately,
+ * the rest join the world's async trace batch, which runs off the game thread at the end of the frame and is
+ * answered during the next world tick. Every query is counted per frame under the TraceTag of its query params,
+ * so callers tag them with SCENE_QUERY_STAT. Osu.Traces.Show draws the counts of the last frame on screen and
+ * Osu.Traces.Dump prints the averages since the last dump.
+ */
+UCLASS()
+class THEPATHOFOSU_API UOsuTraceServiceSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	bool LineTraceSingleByChannel(FHitResult& OutHit, const FVector& Start, const FVector& End,
+	                              ECollisionChannel Channel, const FCollisionQueryParams& Params);
+	// OutHits is reset first, pass a reused array to keep the query from allocating
+	bool LineTraceMultiByObjectType(TArray<FHitResult>& OutHits, const FVector& Start, const FVector& End,
+	                                const FCollisionObjectQueryParams& ObjectParams,
+	                                const FCollisionQueryParams& Params);
+	bool SweepSingleByObjectType(FHitResult& OutHit, const FVector& Start, const FVector& End,
+	                             const FCollisionObjectQueryParams& ObjectParams, const FCollisionShape& Shape,
+	                             const FCollisionQueryParams& Params);
+	// Only components blocking Channel count, overlap-only triggers are ignored
+	bool OverlapBlockingTestByChannel(const FVector& Position, ECollisionChannel Channel, const FCollisionShape& Shape,
+	                                  const FCollisionQueryParams& Params);
+
+	// Immediate calls OnResult before returning. NextFrame calls it during the next world tick, with the result
+	// copied out of the batch into a pooled datum. Either way OnResult is skipped once its object is gone
+	void OverlapMultiByObjectType(EOsuTraceLatency Latency, const FVector& Position,
+	                              const FCollisionObjectQueryParams& ObjectParams, const FCollisionShape& Shape,
+	                              const FCollisionQueryParams& Params, FOsuOverlapResultDelegate OnResult);
+
+	void DumpStats();
+
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+
+private:
+	struct FCallerStats
+	{
+		FName Caller;
+		int32 FrameImmediate = 0;
+		int32 FrameAsync = 0;
+		int32 LastFrameImmediate = 0;
+		int32 LastFrameAsync = 0;
+		int32 PeakFrameTraces = 0;
+		int64 TotalImmediate = 0;
+		int64 TotalAsync = 0;
+		uint64 ImmediateCycles = 0;
+	};
+
+	// The returned stats are only valid until the next caller is added
+	FCallerStats& CountTrace(FName Caller, EOsuTraceLatency Latency);
+
+	struct FPendingOverlap
+	{
+		FTraceHandle TraceHandle;
+		uint64 Frame;
+		FOsuOverlapResultDelegate OnResult;
+	};
+
+	void DeliverAsyncOverlaps();
+
+	TArray<FCallerStats> Callers;
+	TMap<FName, int32> CallerIndices;
+	uint64 FrameCount = 0;
+
+	// Reused by immediate overlaps, taken out while OnResult runs in case it queries again
+	TArray<FOverlapResult> OverlapScratch;
+
+	// NextFrame overlaps waiting for the batch they joined to run
+	TArray<FPendingOverlap> PendingOverlaps;
+	TArray<FPendingOverlap> DeliveringOverlaps;
+	// Keeps its result capacity between deliveries, the batch's own datum is rebuilt for every query
+	FOverlapDatum OverlapDatum;
+};
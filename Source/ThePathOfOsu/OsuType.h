@@ -10,8 +10,29 @@ struct THEPATHOFOSU_API FOsuType
 	
 };
 
+class UTexture2D;
+
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnInteract);
 
+USTRUCT(BlueprintType)
+struct THEPATHOFOSU_API FInteractionPrompt
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	UTexture2D* Icon = nullptr;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FText Name;
+
+	// Relative to the interactable, the point the player's prompt widget is projected from
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FVector WorldOffset = FVector(0.0f, -48.0f, 31.0f);
+};
+
+// Custom depth stencil value the outline post process material draws around, see r.CustomDepth in DefaultEngine.ini
+constexpr int32 InteractableOutlineStencilValue = 1;
+
 UENUM(BlueprintType)
 enum class EAnimationState : uint8 {
 	Unarmed = 0 UMETA(DisplayName = "Unarmed"),
@@ -19,6 +40,71 @@ enum class EAnimationState : uint8 {
 	Rifle = 2 UMETA(DisplayName = "Rifle"),
 };
 
+// Row of the effect table in InventoryComponent.cpp
+UENUM(BlueprintType)
+enum class EItemEffect : uint8 {
+	None = 0 UMETA(DisplayName = "None"),
+	Heal = 1 UMETA(DisplayName = "Heal"),
+	EquipPistol = 2 UMETA(DisplayName = "EquipPistol"),
+	EquipRifle = 3 UMETA(DisplayName = "EquipRifle"),
+	Count UMETA(Hidden),
+};
+
+// Gameplay events that advance missions, see UOsuMission::ProgressEvent
+UENUM(BlueprintType)
+enum class EObjectiveEvent : uint8 {
+	None = 0 UMETA(DisplayName = "None"),
+	EnemyKilled = 1 UMETA(DisplayName = "EnemyKilled"),
+	CollectableCollected = 2 UMETA(DisplayName = "CollectableCollected"),
+	ItemPickedUp = 3 UMETA(DisplayName = "ItemPickedUp"),
+	TriggerActivated = 4 UMETA(DisplayName = "TriggerActivated"),
+	Count UMETA(Hidden),
+};
+
+// Node kinds of ALevelLogicGraph
+UENUM(BlueprintType)
+enum class ELevelLogicNodeType : uint8 {
+	Source = 0 UMETA(DisplayName = "Source"),
+	And = 1 UMETA(DisplayName = "And"),
+	Or = 2 UMETA(DisplayName = "Or"),
+	Latch = 3 UMETA(DisplayName = "Latch"),
+	Timer = 4 UMETA(DisplayName = "Timer"),
+	Sink = 5 UMETA(DisplayName = "Sink"),
+	Count UMETA(Hidden),
+};
+
+// Channels of UOsuEventBusSubsystem, one per payload struct in OsuGameplayEvents.h
+UENUM(BlueprintType)
+enum class EOsuEventChannel : uint8 {
+	LogicSignal = 0 UMETA(DisplayName = "LogicSignal"),
+	ObjectiveProgress = 1 UMETA(DisplayName = "ObjectiveProgress"),
+	Count UMETA(Hidden),
+};
+
+// How late UOsuTraceServiceSubsystem may answer a query
+UENUM(BlueprintType)
+enum class EOsuTraceLatency : uint8 {
+	Immediate = 0 UMETA(DisplayName = "Immediate"),
+	NextFrame = 1 UMETA(DisplayName = "NextFrame"),
+};
+
+UENUM(BlueprintType)
+enum class EOxAttribute : uint8 {
+	Hp = 0 UMETA(DisplayName = "Hp"),
+	PostureValue = 1 UMETA(DisplayName = "PostureValue"),
+	Stamina = 2 UMETA(DisplayName = "Stamina"),
+};
+
+// Soft referenced assets of a feature, loaded together in the background once the feature is about to be used
+UENUM(BlueprintType)
+enum class EOsuAssetBundle : uint8 {
+	Unarmed = 0 UMETA(DisplayName = "Unarmed"),
+	Pistol = 1 UMETA(DisplayName = "Pistol"),
+	Rifle = 2 UMETA(DisplayName = "Rifle"),
+	Puzzle = 3 UMETA(DisplayName = "Puzzle"),
+	Count UMETA(Hidden),
+};
+
 UENUM(BlueprintType)
 enum class EWeaponState : uint8 {
 	UnEquip = 0 UMETA(DisplayName = "UnEquip"),
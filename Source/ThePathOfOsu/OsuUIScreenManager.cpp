@@ -0,0 +1,159 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "OsuUIScreenManager.h"
+
+#include "Blueprint/UserWidget.h"
+
+void UOsuUIScreenManager::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	WorldCleanupHandle = FWorldDelegates::OnWorldCleanup.AddUObject(this, &UOsuUIScreenManager::OnWorldCleanup);
+}
+
+void UOsuUIScreenManager::Deinitialize()
+{
+	FWorldDelegates::OnWorldCleanup.Remove(WorldCleanupHandle);
+	CachedScreens.Empty();
+	OpenScreens.Empty();
+	Super::Deinitialize();
+}
+
+void UOsuUIScreenManager::PreloadScreen(TSubclassOf<UUserWidget> ScreenClass, EOsuUILayer Layer)
+{
+	UUserWidget* Screen = GetOrCreateScreen(ScreenClass);
+	if (Screen && !Screen->IsInViewport())
+	{
+		// Adding collapsed builds the slate tree now instead of on first open
+		AddScreenToViewport(Screen, Layer);
+		Screen->SetVisibility(ESlateVisibility::Collapsed);
+	}
+}
+
+UUserWidget* UOsuUIScreenManager::AddHudScreen(TSubclassOf<UUserWidget> ScreenClass)
+{
+	UUserWidget* Screen = GetOrCreateScreen(ScreenClass);
+	if (Screen && !Screen->IsInViewport())
+	{
+		AddScreenToViewport(Screen, EOsuUILayer::Hud);
+	}
+	return Screen;
+}
+
+UUserWidget* UOsuUIScreenManager::PushScreen(TSubclassOf<UUserWidget> ScreenClass, EOsuUILayer Layer,
+                                             EOsuUIInputMode InputMode)
+{
+	UUserWidget* Screen = GetOrCreateScreen(ScreenClass);
+	if (!Screen)
+	{
+		return nullptr;
+	}
+
+	OpenScreens.RemoveAll([Screen](const FOpenScreen& OpenScreen) { return OpenScreen.Screen == Screen; });
+	// Insert after every screen of the same or a lower layer, a menu pushed under a modal stays under it
+	int32 InsertIndex = OpenScreens.Num();
+	while (InsertIndex > 0 && OpenScreens[InsertIndex - 1].Layer > Layer)
+	{
+		--InsertIndex;
+	}
+	OpenScreens.Insert({Screen, Layer, InputMode}, InsertIndex);
+
+	if (!Screen->IsInViewport())
+	{
+		AddScreenToViewport(Screen, Layer);
+	}
+	Screen->SetVisibility(ESlateVisibility::Visible);
+	ApplyInputMode();
+	return Screen;
+}
+
+void UOsuUIScreenManager::PopScreen(UUserWidget* Screen)
+{
+	if (!Screen)
+	{
+		return;
+	}
+	OpenScreens.RemoveAll([Screen](const FOpenScreen& OpenScreen) { return OpenScreen.Screen == Screen; });
+	Screen->SetVisibility(ESlateVisibility::Collapsed);
+	ApplyInputMode();
+}
+
+bool UOsuUIScreenManager::IsScreenOpen(const UUserWidget* Screen) const
+{
+	return OpenScreens.ContainsByPredicate([Screen](const FOpenScreen& OpenScreen)
+	{
+		return OpenScreen.Screen == Screen;
+	});
+}
+
+UUserWidget* UOsuUIScreenManager::GetOrCreateScreen(TSubclassOf<UUserWidget> ScreenClass)
+{
+	if (!ScreenClass)
+	{
+		UE_LOG(LogTemp, Error, TEXT("ScreenClass is null, Function name: %s"), *FString(__FUNCTION__));
+		return nullptr;
+	}
+
+	UWorld* World = GetGameInstance()->GetWorld();
+	if (CachedWorld != World)
+	{
+		CachedScreens.Empty();
+		OpenScreens.Empty();
+		CachedWorld = World;
+	}
+
+	if (UUserWidget** CachedScreen = CachedScreens.Find(ScreenClass))
+	{
+		return *CachedScreen;
+	}
+
+	APlayerController* PlayerController = GetGameInstance()->GetFirstLocalPlayerController(World);
+	if (!PlayerController)
+	{
+		UE_LOG(LogTemp, Error, TEXT("No local player controller to own %s"), *ScreenClass->GetName());
+		return nullptr;
+	}
+	UUserWidget* Screen = CreateWidget<UUserWidget>(PlayerController, ScreenClass);
+	CachedScreens.Add(ScreenClass, Screen);
+	return Screen;
+}
+
+void UOsuUIScreenManager::AddScreenToViewport(UUserWidget* Screen, EOsuUILayer Layer)
+{
+	Screen->AddToViewport(static_cast<int32>(Layer));
+}
+
+void UOsuUIScreenManager::ApplyInputMode()
+{
+	APlayerController* PlayerController = GetGameInstance()->GetFirstLocalPlayerController(CachedWorld.Get());
+	if (!PlayerController)
+	{
+		return;
+	}
+
+	const EOsuUIInputMode InputMode = OpenScreens.IsEmpty() ? EOsuUIInputMode::GameOnly : OpenScreens.Last().InputMode;
+	switch (InputMode)
+	{
+	case EOsuUIInputMode::GameOnly:
+		PlayerController->SetInputMode(FInputModeGameOnly());
+		break;
+	case EOsuUIInputMode::GameAndUI:
+		PlayerController->SetInputMode(FInputModeGameAndUI());
+		break;
+	case EOsuUIInputMode::UIOnly:
+		PlayerController->SetInputMode(FInputModeUIOnly());
+		break;
+	}
+	PlayerController->SetShowMouseCursor(InputMode != EOsuUIInputMode::GameOnly);
+}
+
+void UOsuUIScreenManager::OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources)
+{
+	// Cached screens are owned by the player controller of the world being torn down
+	if (World == CachedWorld)
+	{
+		CachedScreens.Empty();
+		OpenScreens.Empty();
+		CachedWorld.Reset();
+	}
+}
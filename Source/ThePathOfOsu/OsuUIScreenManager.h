@@ -0,0 +1,79 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "OsuUIScreenManager.generated.h"
+
+class UUserWidget;
+
+// Doubles as the viewport z order, screens on a higher layer draw on top
+UENUM(BlueprintType)
+enum class EOsuUILayer : uint8 {
+	Hud = 0 UMETA(DisplayName = "Hud"),
+	Menu = 10 UMETA(DisplayName = "Menu"),
+	Modal = 20 UMETA(DisplayName = "Modal"),
+};
+
+UENUM(BlueprintType)
+enum class EOsuUIInputMode : uint8 {
+	GameOnly = 0 UMETA(DisplayName = "GameOnly"),
+	GameAndUI = 1 UMETA(DisplayName = "GameAndUI"),
+	UIOnly = 2 UMETA(DisplayName = "UIOnly"),
+};
+
+/**
+ * Creates every full screen widget once per level and keeps it in the viewport, collapsed while closed,
+ * so opening a screen again allocates nothing. Open screens form a stack and the top one decides
+ * the player's input mode and mouse cursor.
+ */
+UCLASS()
+class THEPATHOFOSU_API UOsuUIScreenManager : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	// Builds the screen ahead of time so its first push does not hitch, Layer must match the later push
+	UFUNCTION(BlueprintCallable, Category = "UI")
+	void PreloadScreen(TSubclassOf<UUserWidget> ScreenClass, EOsuUILayer Layer);
+
+	// Screen drawn on the hud layer outside the stack, visibility is left to the caller
+	UFUNCTION(BlueprintCallable, Category = "UI")
+	UUserWidget* AddHudScreen(TSubclassOf<UUserWidget> ScreenClass);
+
+	UFUNCTION(BlueprintCallable, Category = "UI")
+	UUserWidget* PushScreen(TSubclassOf<UUserWidget> ScreenClass, EOsuUILayer Layer, EOsuUIInputMode InputMode);
+
+	UFUNCTION(BlueprintCallable, Category = "UI")
+	void PopScreen(UUserWidget* Screen);
+
+	UFUNCTION(BlueprintPure, Category = "UI")
+	bool IsScreenOpen(const UUserWidget* Screen) const;
+
+private:
+	struct FOpenScreen
+	{
+		UUserWidget* Screen;
+		EOsuUILayer Layer;
+		EOsuUIInputMode InputMode;
+	};
+
+	UUserWidget* GetOrCreateScreen(TSubclassOf<UUserWidget> ScreenClass);
+	void AddScreenToViewport(UUserWidget* Screen, EOsuUILayer Layer);
+	void ApplyInputMode();
+	void OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources);
+
+	UPROPERTY()
+	TMap<TSubclassOf<UUserWidget>, UUserWidget*> CachedScreens;
+
+	// Sorted by layer, the last entry is the top of the stack
+	TArray<FOpenScreen> OpenScreens;
+
+	TWeakObjectPtr<UWorld> CachedWorld;
+
+	FDelegateHandle WorldCleanupHandle;
+};
@@ -0,0 +1,269 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "OsuWarmupSubsystem.h"
+
+#include "AudioDevice.h"
+#include "NiagaraComponent.h"
+#include "NiagaraFunctionLibrary.h"
+#include "NiagaraSystem.h"
+#include "OsuAssetLoader.h"
+#include "WarmupManifest.h"
+#include "Sound/SoundCue.h"
+#include "Sound/SoundNodeWavePlayer.h"
+#include "Sound/SoundWave.h"
+
+namespace
+{
+	TAutoConsoleVariable<bool> CVarWarmupEnable(
+		TEXT("Osu.Warmup.Enable"),
+		true,
+		TEXT("Prime the assets of the warm-up manifest while the main menu is shown"));
+
+	TAutoConsoleVariable<float> CVarWarmupBudgetMs(
+		TEXT("Osu.Warmup.BudgetMs"),
+		2.0f,
+		TEXT("Game thread time the warm-up may spend per frame, at least one item is primed per frame"));
+
+	// Far below any level, primed effects are never seen
+	const FVector HiddenSpawnLocation(0.0f, 0.0f, -100000.0f);
+
+	// Shared by every scope, emptied with each new game instance so each PIE session reports its own first uses
+	TSet<FName> ReportedFirstUses;
+}
+
+void UOsuWarmupSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	ReportedFirstUses.Reset();
+}
+
+void UOsuWarmupSubsystem::Deinitialize()
+{
+	FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+	DestroyPrimedObjects();
+	ManifestHandle.Reset();
+	Super::Deinitialize();
+}
+
+void UOsuWarmupSubsystem::StartWarmup(UWarmupManifest* Manifest)
+{
+	if (!Manifest)
+	{
+		UE_LOG(LogTemp, Error, TEXT("StartWarmup: Manifest is null"));
+		return;
+	}
+	if (!IsWarmupEnabled() || WarmupManifest == Manifest)
+	{
+		return;
+	}
+
+	FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+	WarmupManifest = Manifest;
+	IsComplete = false;
+	WarmupStartTime = FPlatformTime::Seconds();
+
+	TArray<FSoftObjectPath> Paths;
+	Manifest->GetAssetPaths(Paths);
+	ManifestHandle = FOsuAssetLoader::RequestAsyncLoad(MoveTemp(Paths), this);
+	if (!ManifestHandle.IsValid() || ManifestHandle->HasLoadCompleted())
+	{
+		OnManifestLoaded();
+		return;
+	}
+	ManifestHandle->BindCompleteDelegate(FStreamableDelegate::CreateUObject(this, &UOsuWarmupSubsystem::OnManifestLoaded));
+}
+
+bool UOsuWarmupSubsystem::IsWarmupComplete() const
+{
+	return IsComplete;
+}
+
+bool UOsuWarmupSubsystem::IsWarmupEnabled()
+{
+	return CVarWarmupEnable.GetValueOnGameThread();
+}
+
+void UOsuWarmupSubsystem::OnManifestLoaded()
+{
+	UE_LOG(LogTemp, Log, TEXT("Warm-up manifest %s loaded in %.2f s"), *WarmupManifest->GetName(),
+	       FPlatformTime::Seconds() - WarmupStartTime);
+	Step = EWarmupStep::NiagaraSystems;
+	ItemIndex = 0;
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+		FTickerDelegate::CreateUObject(this, &UOsuWarmupSubsystem::TickWarmup));
+}
+
+bool UOsuWarmupSubsystem::TickWarmup(float DeltaTime)
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_OsuWarmupTick);
+
+	DestroyPrimedObjects();
+	UWorld* World = GetGameInstance()->GetWorld();
+	if (!World || !WarmupManifest)
+	{
+		// Mid travel, try again next frame
+		return true;
+	}
+
+	const double BudgetSeconds = CVarWarmupBudgetMs.GetValueOnGameThread() / 1000.0;
+	const double FrameStartTime = FPlatformTime::Seconds();
+	do
+	{
+		bool HasPrimedItem = false;
+		switch (Step)
+		{
+		case EWarmupStep::NiagaraSystems:
+			HasPrimedItem = WarmupNiagaraSystem(World);
+			break;
+		case EWarmupStep::EffectActors:
+			HasPrimedItem = WarmupEffectActor(World);
+			break;
+		case EWarmupStep::Sounds:
+			HasPrimedItem = WarmupSound(World);
+			break;
+		default: ;
+		}
+
+		if (HasPrimedItem)
+		{
+			ItemIndex++;
+			continue;
+		}
+		Step = static_cast<EWarmupStep>(static_cast<uint8>(Step) + 1);
+		ItemIndex = 0;
+		if (Step == EWarmupStep::Done)
+		{
+			IsComplete = true;
+			UE_LOG(LogTemp, Log, TEXT("Warm-up of %s finished in %.2f s"), *WarmupManifest->GetName(),
+			       FPlatformTime::Seconds() - WarmupStartTime);
+			// Keep ticking one more frame so the last spawned effects get destroyed
+			return !PrimedObjects.IsEmpty();
+		}
+	}
+	while (FPlatformTime::Seconds() - FrameStartTime < BudgetSeconds);
+	return true;
+}
+
+bool UOsuWarmupSubsystem::WarmupNiagaraSystem(UWorld* World)
+{
+	if (!WarmupManifest->NiagaraSystems.IsValidIndex(ItemIndex))
+	{
+		return false;
+	}
+	if (UNiagaraSystem* NiagaraSystem = WarmupManifest->NiagaraSystems[ItemIndex].Get())
+	{
+		UNiagaraComponent* NiagaraComponent = UNiagaraFunctionLibrary::SpawnSystemAtLocation(
+			World, NiagaraSystem, HiddenSpawnLocation, FRotator::ZeroRotator, FVector::OneVector, false, true,
+			ENCPoolMethod::None, false);
+		if (NiagaraComponent)
+		{
+			PrimedObjects.Add(NiagaraComponent);
+		}
+	}
+	return true;
+}
+
+bool UOsuWarmupSubsystem::WarmupEffectActor(UWorld* World)
+{
+	if (!WarmupManifest->EffectActorClasses.IsValidIndex(ItemIndex))
+	{
+		return false;
+	}
+	if (UClass* EffectActorClass = WarmupManifest->EffectActorClasses[ItemIndex].Get())
+	{
+		FActorSpawnParameters SpawnParameters;
+		SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		if (AActor* EffectActor = World->SpawnActor<AActor>(EffectActorClass, HiddenSpawnLocation,
+		                                                    FRotator::ZeroRotator, SpawnParameters))
+		{
+			PrimedObjects.Add(EffectActor);
+		}
+	}
+	return true;
+}
+
+bool UOsuWarmupSubsystem::WarmupSound(UWorld* World)
+{
+	if (!WarmupManifest->Sounds.IsValidIndex(ItemIndex))
+	{
+		return false;
+	}
+	FAudioDeviceHandle AudioDevice = World->GetAudioDevice();
+	USoundBase* Sound = WarmupManifest->Sounds[ItemIndex].Get();
+	if (!AudioDevice.IsValid() || !Sound)
+	{
+		return true;
+	}
+
+	TArray<USoundWave*, TInlineAllocator<4>> SoundWaves;
+	if (USoundWave* SoundWave = Cast<USoundWave>(Sound))
+	{
+		SoundWaves.Add(SoundWave);
+	}
+	else if (USoundCue* SoundCue = Cast<USoundCue>(Sound))
+	{
+		TArray<USoundNodeWavePlayer*> WavePlayers;
+		SoundCue->RecursiveFindNode<USoundNodeWavePlayer>(SoundCue->FirstNode, WavePlayers);
+		for (const USoundNodeWavePlayer* WavePlayer : WavePlayers)
+		{
+			if (USoundWave* SoundWave = WavePlayer->GetSoundWave())
+			{
+				SoundWaves.Add(SoundWave);
+			}
+		}
+	}
+	for (USoundWave* SoundWave : SoundWaves)
+	{
+		AudioDevice->Precache(SoundWave, false, true, true);
+	}
+	return true;
+}
+
+void UOsuWarmupSubsystem::DestroyPrimedObjects()
+{
+	for (UObject* PrimedObject : PrimedObjects)
+	{
+		if (UNiagaraComponent* NiagaraComponent = Cast<UNiagaraComponent>(PrimedObject))
+		{
+			NiagaraComponent->DestroyComponent();
+		}
+		else if (AActor* EffectActor = Cast<AActor>(PrimedObject))
+		{
+			EffectActor->Destroy();
+		}
+	}
+	PrimedObjects.Reset();
+}
+
+FOsuFirstUseScope::FOsuFirstUseScope(const UObject* InWorldContextObject, FName InUseName)
+	: WorldContextObject(InWorldContextObject)
+	, UseName(InUseName)
+{
+	bool IsAlreadyReported = false;
+	ReportedFirstUses.Add(UseName, &IsAlreadyReported);
+	IsFirstUse = !IsAlreadyReported;
+	if (IsFirstUse)
+	{
+		StartTime = FPlatformTime::Seconds();
+	}
+}
+
+FOsuFirstUseScope::~FOsuFirstUseScope()
+{
+	if (!IsFirstUse)
+	{
+		return;
+	}
+	const double ElapsedMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	const UOsuWarmupSubsystem* WarmupSubsystem = World && World->GetGameInstance()
+		                                             ? World->GetGameInstance()->GetSubsystem<UOsuWarmupSubsystem>()
+		                                             : nullptr;
+	const TCHAR* WarmupState = !UOsuWarmupSubsystem::IsWarmupEnabled()
+		                           ? TEXT("disabled")
+		                           : WarmupSubsystem && WarmupSubsystem->IsWarmupComplete()
+		                           ? TEXT("complete")
+		                           : TEXT("incomplete");
+	UE_LOG(LogTemp, Display, TEXT("First %s took %.2f ms, warm-up %s"), *UseName.ToString(), ElapsedMs, WarmupState);
+}
@@ -0,0 +1,86 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "OsuWarmupSubsystem.generated.h"
+
+class UWarmupManifest;
+class UNiagaraSystem;
+struct FStreamableHandle;
+
+/**
+ * Pays the one time costs of gameplay assets ahead of their first use: Niagara system init, effect actor spawning
+ * and sound decompression. Montages need the mesh that plays them to be instanced, they are loaded and kept
+ * resident instead. The manifest is worked through a few items per frame within a time budget, so the menu
+ * it runs behind keeps its frame rate. Primed assets stay loaded for the rest of the session.
+ * Osu.Warmup.Enable 0 skips the warm-up to compare first use timings.
+ */
+UCLASS()
+class THEPATHOFOSU_API UOsuWarmupSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	UFUNCTION(BlueprintCallable, Category = "Warmup")
+	void StartWarmup(UWarmupManifest* Manifest);
+
+	UFUNCTION(BlueprintPure, Category = "Warmup")
+	bool IsWarmupComplete() const;
+
+	static bool IsWarmupEnabled();
+
+private:
+	enum class EWarmupStep : uint8
+	{
+		NiagaraSystems,
+		EffectActors,
+		Sounds,
+		Done,
+	};
+
+	void OnManifestLoaded();
+	bool TickWarmup(float DeltaTime);
+
+	// Each primes one item, returns false once the step has no item left
+	bool WarmupNiagaraSystem(UWorld* World);
+	bool WarmupEffectActor(UWorld* World);
+	bool WarmupSound(UWorld* World);
+
+	void DestroyPrimedObjects();
+
+	UPROPERTY()
+	UWarmupManifest* WarmupManifest;
+
+	// Spawned last frame, removed once they had a frame to initialize
+	UPROPERTY()
+	TArray<UObject*> PrimedObjects;
+
+	TSharedPtr<FStreamableHandle> ManifestHandle;
+	FTSTicker::FDelegateHandle TickerHandle;
+
+	EWarmupStep Step = EWarmupStep::Done;
+	int32 ItemIndex = 0;
+	double WarmupStartTime = 0.0;
+	bool IsComplete = false;
+};
+
+/**
+ * Logs how long a gameplay action took the first time it ran in this session, and whether the warm-up had finished
+ */
+struct THEPATHOFOSU_API FOsuFirstUseScope
+{
+	FOsuFirstUseScope(const UObject* InWorldContextObject, FName InUseName);
+	~FOsuFirstUseScope();
+
+private:
+	const UObject* WorldContextObject;
+	FName UseName;
+	double StartTime = 0.0;
+	bool IsFirstUse = false;
+};
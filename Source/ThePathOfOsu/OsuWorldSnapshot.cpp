@@ -0,0 +1,155 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "OsuWorldSnapshot.h"
+
+#include "CellPersistenceSubsystem.h"
+#include "Engine/Level.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+void FOsuWorldSnapshot::Capture(UWorld* World)
+{
+	ObjectStates.Reset();
+	ForEachSaveable(World, [this](UObject* Object)
+	{
+		FCellObjectState& ObjectState = ObjectStates.Add(GetObjectKey(Object));
+		ObjectState.Version = FOsuSaveVersion::LatestVersion;
+		CaptureObject(Object, ObjectState.State);
+	});
+
+	const UCellPersistenceSubsystem* CellPersistence = World ? World->GetSubsystem<UCellPersistenceSubsystem>() : nullptr;
+	if (CellPersistence)
+	{
+		for (const TPair<FString, FCellObjectState>& StoredState : CellPersistence->GetStoredStates())
+		{
+			if (!ObjectStates.Contains(StoredState.Key))
+			{
+				ObjectStates.Add(StoredState.Key, StoredState.Value);
+			}
+		}
+	}
+}
+
+void FOsuWorldSnapshot::Restore(UWorld* World) const
+{
+	TSet<FString> RestoredKeys;
+	ForEachSaveable(World, [this, &RestoredKeys](UObject* Object)
+	{
+		FString Key = GetObjectKey(Object);
+		if (const FCellObjectState* ObjectState = ObjectStates.Find(Key))
+		{
+			RestoreObject(Object, ObjectState->State, ObjectState->Version);
+			RestoredKeys.Add(MoveTemp(Key));
+		}
+	});
+
+	UCellPersistenceSubsystem* CellPersistence = World ? World->GetSubsystem<UCellPersistenceSubsystem>() : nullptr;
+	if (CellPersistence)
+	{
+		TMap<FString, FCellObjectState> StreamedOutStates;
+		for (const TPair<FString, FCellObjectState>& ObjectState : ObjectStates)
+		{
+			if (!RestoredKeys.Contains(ObjectState.Key))
+			{
+				StreamedOutStates.Add(ObjectState.Key, ObjectState.Value);
+			}
+		}
+		CellPersistence->ResetStoredStates(MoveTemp(StreamedOutStates));
+	}
+}
+
+FString FOsuWorldSnapshot::GetObjectKey(const UObject* Object)
+{
+	const AActor* Actor = Cast<AActor>(Object);
+	if (!Actor)
+	{
+		Actor = Object->GetTypedOuter<AActor>();
+	}
+	const ISaveableInterface* SaveableActor = Cast<const ISaveableInterface>(Actor);
+	const FName SaveId = SaveableActor ? SaveableActor->GetSaveId() : NAME_None;
+	if (!SaveId.IsNone())
+	{
+		return Object == Actor
+			       ? FString::Printf(TEXT("Spawned:%s"), *SaveId.ToString())
+			       : FString::Printf(TEXT("Spawned:%s.%s"), *SaveId.ToString(), *Object->GetName());
+	}
+	// PIE worlds prefix their package names, strip it so editor saves load in packaged builds and the other way round
+	return UWorld::RemovePIEPrefix(Object->GetPathName());
+}
+
+void FOsuWorldSnapshot::CaptureObject(UObject* Object, TArray<uint8>& OutState)
+{
+	FMemoryWriter Writer(OutState);
+	Writer.SetIsSaveGame(true);
+	CastChecked<ISaveableInterface>(Object)->SerializeState(Writer);
+}
+
+void FOsuWorldSnapshot::RestoreObject(UObject* Object, const TArray<uint8>& State, int32 StateVersion)
+{
+	FMemoryReader Reader(State);
+	Reader.SetIsSaveGame(true);
+	Reader.SetCustomVersion(FOsuSaveVersion::GUID, StateVersion, TEXT("OsuSave"));
+	CastChecked<ISaveableInterface>(Object)->SerializeState(Reader);
+	if (Reader.IsError() || Reader.Tell() != State.Num())
+	{
+		UE_LOG(LogTemp, Error, TEXT("Saved state of %s does not match its layout"), *Object->GetName());
+	}
+}
+
+void FOsuWorldSnapshot::ForEachSaveable(UWorld* World, TFunctionRef<void(UObject*)> Callback)
+{
+	if (!World)
+	{
+		return;
+	}
+	for (ULevel* Level : World->GetLevels())
+	{
+		ForEachSaveableInLevel(Level, Callback);
+	}
+}
+
+void FOsuWorldSnapshot::ForEachSaveableInLevel(ULevel* Level, TFunctionRef<void(UObject*)> Callback)
+{
+	if (!Level)
+	{
+		return;
+	}
+	for (AActor* Actor : Level->Actors)
+	{
+		if (!IsValid(Actor))
+		{
+			continue;
+		}
+		if (Actor->Implements<USaveableInterface>())
+		{
+			Callback(Actor);
+		}
+		for (UActorComponent* Component : Actor->GetComponents())
+		{
+			if (Component && Component->Implements<USaveableInterface>())
+			{
+				Callback(Component);
+			}
+		}
+	}
+}
+
+FArchive& operator<<(FArchive& Ar, FOsuWorldSnapshot& Snapshot)
+{
+	const int32 FileVersion = Ar.CustomVer(FOsuSaveVersion::GUID);
+	if (Ar.IsLoading() && FileVersion < FOsuSaveVersion::PerObjectVersion)
+	{
+		// Older files wrote every state with the file's version
+		TMap<FString, TArray<uint8>> LegacyStates;
+		Ar << LegacyStates;
+		Snapshot.ObjectStates.Reset();
+		for (TPair<FString, TArray<uint8>>& LegacyState : LegacyStates)
+		{
+			Snapshot.ObjectStates.Add(LegacyState.Key, {MoveTemp(LegacyState.Value), FileVersion});
+		}
+		return Ar;
+	}
+	Ar << Snapshot.ObjectStates;
+	return Ar;
+}
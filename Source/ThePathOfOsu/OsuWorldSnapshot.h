@@ -0,0 +1,31 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CellPersistenceSubsystem.h"
+#include "Interface/SaveableInterface.h"
+
+/**
+ * SerializeState output of every ISaveableInterface actor and component in a world, keyed by object path.
+ * Each object gets its own blob and the FOsuSaveVersion it was written with, so one object changing its layout
+ * cannot corrupt the ones after it, and states taken over from the cell store keep their older version.
+ */
+struct THEPATHOFOSU_API FOsuWorldSnapshot
+{
+	TMap<FString, FCellObjectState> ObjectStates;
+
+	// Includes the stored state of objects in World Partition cells that are streamed out
+	void Capture(UWorld* World);
+	// Objects that are missing from the snapshot are left untouched, states of objects that are not loaded
+	// replace the cell persistence store and are applied when their cell streams in
+	void Restore(UWorld* World) const;
+
+	static FString GetObjectKey(const UObject* Object);
+	static void CaptureObject(UObject* Object, TArray<uint8>& OutState);
+	static void RestoreObject(UObject* Object, const TArray<uint8>& State, int32 StateVersion);
+	static void ForEachSaveable(UWorld* World, TFunctionRef<void(UObject*)> Callback);
+	static void ForEachSaveableInLevel(ULevel* Level, TFunctionRef<void(UObject*)> Callback);
+
+	friend FArchive& operator<<(FArchive& Ar, FOsuWorldSnapshot& Snapshot);
+};
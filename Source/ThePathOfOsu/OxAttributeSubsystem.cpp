@@ -0,0 +1,36 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "OxAttributeSubsystem.h"
+
+#include "OxCharacter.h"
+
+void UOxAttributeSubsystem::RequestUpdate(AOxCharacter* Character)
+{
+	UpdatingCharacters.Add(Character);
+}
+
+void UOxAttributeSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	for (int32 Index = UpdatingCharacters.Num() - 1; Index >= 0; --Index)
+	{
+		AOxCharacter* Character = UpdatingCharacters[Index].Get();
+		// Match what the character's own tick would see under SetTimeScale
+		if (!Character || !Character->UpdateAttributes(DeltaTime * Character->CustomTimeDilation))
+		{
+			UpdatingCharacters.RemoveAtSwap(Index);
+		}
+	}
+}
+
+bool UOxAttributeSubsystem::IsTickable() const
+{
+	return !UpdatingCharacters.IsEmpty();
+}
+
+TStatId UOxAttributeSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UOxAttributeSubsystem, STATGROUP_Tickables);
+}
@@ -0,0 +1,30 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "OxAttributeSubsystem.generated.h"
+
+class AOxCharacter;
+
+/**
+ * Updates hp, posture and stamina regen for every character in one pass per frame.
+ * Characters only stay registered while an attribute is below max or draining,
+ * and the subsystem stops ticking once none are left.
+ */
+UCLASS()
+class THEPATHOFOSU_API UOxAttributeSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	void RequestUpdate(AOxCharacter* Character);
+
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+
+private:
+	TArray<TWeakObjectPtr<AOxCharacter>> UpdatingCharacters;
+};
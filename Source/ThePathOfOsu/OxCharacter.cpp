@@ -2,6 +2,10 @@
 
 
 #include "OxCharacter.h"
+#include "KinematicMoverSubsystem.h"
+#include "OxAttributeSubsystem.h"
+#include "OsuAssetLoader.h"
+#include "OsuWarmupSubsystem.h"
 #include "ThePathOfOsuGameMode.h"
 #include "Components/CapsuleComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
@@ -50,6 +54,11 @@ void AOxCharacter::BeginPlay()
 	Super::BeginPlay();
 	AnimInstance = GetMesh()->GetAnimInstance();
 	CharacterMovementComponent = Cast<UCharacterMovementComponent>(GetMovementComponent());
+	if (UKinematicMoverSubsystem* KinematicMover = GetWorld()->GetSubsystem<UKinematicMoverSubsystem>())
+	{
+		// Lifts and buttons are moved before the character, which may be standing on one
+		KinematicMover->AddTickPrerequisiteTo(CharacterMovementComponent->PrimaryComponentTick);
+	}
 
 	LeftFistCollisionComponent->SetCollisionEnabled(ECollisionEnabled::NoCollision);
 	LeftFistCollisionComponent->OnComponentBeginOverlap.AddDynamic(this, &AOxCharacter::OnOverlapBegin);
@@ -57,8 +66,10 @@ void AOxCharacter::BeginPlay()
 	RightFistCollisionComponent->OnComponentBeginOverlap.AddDynamic(this, &AOxCharacter::OnOverlapBegin);
 
 	AnimInstance->OnMontageEnded.AddDynamic(this, &AOxCharacter::OnMontageEnded);
-	CurrentHp = MaxHp;
-	CurrentPostureValue = MaxPostureValue;
+	SetCurrentHp(MaxHp);
+	SetCurrentPostureValue(MaxPostureValue);
+	SetCurrentStamina(MaxStamina);
+	RequestAssetBundle(EOsuAssetBundle::Unarmed);
 }
 
 
@@ -72,7 +83,7 @@ float AOxCharacter::TakeDamage(float DamageAmount, FDamageEvent const& DamageEve
 
 	float DamageToApply = Super::TakeDamage(DamageAmount, DamageEvent, EventInstigator, DamageCauser);
 	DamageToApply = FMath::Min(CurrentHp, DamageToApply);
-	CurrentHp -= DamageToApply;
+	SetCurrentHp(CurrentHp - DamageToApply);
 
 	// GEngine->AddOnScreenDebugMessage(-1, 15.0f, FColor::White,
 	//                                  FString::Printf(
@@ -85,9 +96,9 @@ float AOxCharacter::TakeDamage(float DamageAmount, FDamageEvent const& DamageEve
 
 	if (IsAlive())
 	{
-		if (!AnimInstance->Montage_IsPlaying(BreakMontage) && !Cast<AGunBase>(DamageCauser))
+		if (!IsMontagePlaying(BreakMontage) && !Cast<AGunBase>(DamageCauser))
 		{
-			PlayAnimMontage(HitReactMontage);
+			PlayAnimMontage(GetMontage(HitReactMontage));
 		}
 	}
 	else
@@ -105,12 +116,12 @@ void AOxCharacter::Heal(float HealAmount)
 		                                 FString::Printf(TEXT("Hp To Restore <= 0 %f"), HealAmount));
 		return;
 	}
-	CurrentHp = FMath::Min(MaxHp, CurrentHp + HealAmount);
+	SetCurrentHp(CurrentHp + HealAmount);
 }
 
 void AOxCharacter::ReducePostureValue(float PostureValueToReduce)
 {
-	CurrentPostureValue = FMath::Max(0.0f, CurrentPostureValue - PostureValueToReduce);
+	SetCurrentPostureValue(CurrentPostureValue - PostureValueToReduce);
 	if (CurrentPostureValue <= 0)
 	{
 		BreakPosture();
@@ -119,12 +130,12 @@ void AOxCharacter::ReducePostureValue(float PostureValueToReduce)
 
 void AOxCharacter::RestorePostureValue(float PostureValueToRestore)
 {
-	CurrentPostureValue = FMath::Min(MaxPostureValue, CurrentPostureValue + PostureValueToRestore);
+	SetCurrentPostureValue(CurrentPostureValue + PostureValueToRestore);
 }
 
 void AOxCharacter::BreakPosture()
 {
-	if (!BreakMontage)
+	if (BreakMontage.IsNull())
 	{
 		UE_LOG(LogTemp, Error, TEXT("BreakMontage is null! %s"), *GetName());
 		return;
@@ -136,10 +147,10 @@ void AOxCharacter::BreakPosture()
 
 	IsExecutable = true;
 
-	if (!AnimInstance->Montage_IsPlaying(BreakMontage))
+	if (!IsMontagePlaying(BreakMontage))
 	{
 		AnimInstance->StopAllMontages(0.0f);
-		PlayAnimMontage(BreakMontage, BreakMontagePlayRate);
+		PlayAnimMontage(GetMontage(BreakMontage), BreakMontagePlayRate);
 	}
 }
 
@@ -152,22 +163,31 @@ void AOxCharacter::RestorePostureFromBreak()
 	}
 }
 
+bool AOxCharacter::CanRegenStamina()
+{
+	return !IsDodging();
+}
+
+void AOxCharacter::OnStaminaDepleted()
+{
+}
+
 bool AOxCharacter::CanRegenPosture()
 {
-	return !AnimInstance->Montage_IsPlaying(BeReflectedMontage)
-		&& !AnimInstance->Montage_IsPlaying(BreakMontage)
-		&& !AnimInstance->Montage_IsPlaying(HitReactMontage) && !AnimInstance->Montage_IsPlaying(DieMontage)
-		&& !AnimInstance->Montage_IsPlaying(BlockMontage)
+	return !IsMontagePlaying(BeReflectedMontage)
+		&& !IsMontagePlaying(BreakMontage)
+		&& !IsMontagePlaying(HitReactMontage) && !IsMontagePlaying(DieMontage)
+		&& !IsMontagePlaying(BlockMontage)
 		&& IsAlive()
 		&& BlockMovementReasons.IsEmpty() && !IsJumping();
 }
 
 bool AOxCharacter::CanMove()
 {
-	return !AnimInstance->Montage_IsPlaying(BeReflectedMontage)
-		&& !AnimInstance->Montage_IsPlaying(BreakMontage)
-		&& !AnimInstance->Montage_IsPlaying(HitReactMontage) && !AnimInstance->Montage_IsPlaying(DieMontage) &&
-		!AnimInstance->Montage_IsPlaying(ExecutePunchAttackMontage) && !AnimInstance->Montage_IsPlaying(BlockMontage)
+	return !IsMontagePlaying(BeReflectedMontage)
+		&& !IsMontagePlaying(BreakMontage)
+		&& !IsMontagePlaying(HitReactMontage) && !IsMontagePlaying(DieMontage) &&
+		!IsMontagePlaying(ExecutePunchAttackMontage) && !IsMontagePlaying(BlockMontage)
 		&& IsAlive()
 		&& !IsPlayingFistAttackMontage()
 		&& BlockMovementReasons.IsEmpty();
@@ -175,20 +195,20 @@ bool AOxCharacter::CanMove()
 
 bool AOxCharacter::CanCharacterJump()
 {
-	return IsAlive() && !AnimInstance->Montage_IsPlaying(BeReflectedMontage) &&
-		!AnimInstance->Montage_IsPlaying(BreakMontage) &&
-		!AnimInstance->Montage_IsPlaying(HitReactMontage) &&
-		!AnimInstance->Montage_IsPlaying(ExecutePunchAttackMontage) && !AnimInstance->Montage_IsPlaying(BlockMontage)
+	return IsAlive() && !IsMontagePlaying(BeReflectedMontage) &&
+		!IsMontagePlaying(BreakMontage) &&
+		!IsMontagePlaying(HitReactMontage) &&
+		!IsMontagePlaying(ExecutePunchAttackMontage) && !IsMontagePlaying(BlockMontage)
 		&& !IsPlayingFistAttackMontage()
 		&& BlockMovementReasons.IsEmpty();
 }
 
 bool AOxCharacter::CanAttack()
 {
-	return IsAlive() && !AnimInstance->Montage_IsPlaying(BeReflectedMontage) &&
-		!AnimInstance->Montage_IsPlaying(BreakMontage) &&
-		!AnimInstance->Montage_IsPlaying(HitReactMontage) &&
-		!AnimInstance->Montage_IsPlaying(ExecutePunchAttackMontage) && !AnimInstance->Montage_IsPlaying(BlockMontage)
+	return IsAlive() && !IsMontagePlaying(BeReflectedMontage) &&
+		!IsMontagePlaying(BreakMontage) &&
+		!IsMontagePlaying(HitReactMontage) &&
+		!IsMontagePlaying(ExecutePunchAttackMontage) && !IsMontagePlaying(BlockMontage)
 		&& BlockMovementReasons.IsEmpty() && !IsJumping() && !IsDodging() && !IsPushing();
 }
 
@@ -210,9 +230,9 @@ bool AOxCharacter::IsMoving()
 
 bool AOxCharacter::IsPlayingFistAttackMontage()
 {
-	for (UAnimMontage* FistAttackMontage : FistAttackMontages)
+	for (const TSoftObjectPtr<UAnimMontage>& FistAttackMontage : FistAttackMontages)
 	{
-		if (AnimInstance->Montage_IsPlaying(FistAttackMontage))
+		if (IsMontagePlaying(FistAttackMontage))
 		{
 			return true;
 		}
@@ -222,11 +242,11 @@ bool AOxCharacter::IsPlayingFistAttackMontage()
 
 bool AOxCharacter::CanGuard()
 {
-	return IsAlive() && !AnimInstance->Montage_IsPlaying(BeReflectedMontage) &&
-		!AnimInstance->Montage_IsPlaying(BreakMontage) &&
-		!AnimInstance->Montage_IsPlaying(HitReactMontage) &&
-		!AnimInstance->Montage_IsPlaying(ExecutePunchAttackMontage)
-		&& !AnimInstance->Montage_IsPlaying(BlockMontage)
+	return IsAlive() && !IsMontagePlaying(BeReflectedMontage) &&
+		!IsMontagePlaying(BreakMontage) &&
+		!IsMontagePlaying(HitReactMontage) &&
+		!IsMontagePlaying(ExecutePunchAttackMontage)
+		&& !IsMontagePlaying(BlockMontage)
 		&& !IsPlayingFistAttackMontage() && !IsJumping()
 	&& !IsDodging();
 }
@@ -248,7 +268,7 @@ bool AOxCharacter::CanDodgeRoll()
 
 bool AOxCharacter::CanPush()
 {
-	return CanMove() && !AnimInstance->Montage_IsPlaying(PushMontage) && !IsJumping();
+	return CanMove() && !IsMontagePlaying(PushMontage) && !IsJumping();
 }
 
 void AOxCharacter::Die()
@@ -259,6 +279,12 @@ void AOxCharacter::Die()
 	SetActorEnableCollision(false);
 }
 
+void AOxCharacter::Revive()
+{
+	CharacterMovementComponent->Activate();
+	SetActorEnableCollision(true);
+}
+
 void AOxCharacter::OnMontageEnded(UAnimMontage* Montage, bool bInterrupted)
 {
 	// GEngine->AddOnScreenDebugMessage(-1, 15.0f, FColor::White, FString::Printf(TEXT("Montage Ended %s"), *Montage->GetName()));
@@ -272,11 +298,6 @@ void AOxCharacter::OnMontageEnded(UAnimMontage* Montage, bool bInterrupted)
 void AOxCharacter::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
-
-	if (CanRegenPosture())
-	{
-		CurrentPostureValue = FMath::Min(MaxPostureValue, CurrentPostureValue + PostureValueRegenRate * DeltaTime);
-	}
 }
 
 // Called to bind functionality to input
@@ -324,7 +345,7 @@ void AOxCharacter::EndFistAttack(bool IsLeftFist)
 
 void AOxCharacter::TryUseItem()
 {
-	if (!DrinkPotionMontage)
+	if (DrinkPotionMontage.IsNull())
 	{
 		UE_LOG(LogTemp, Error, TEXT("DrinkPotionMontage is null! %s"), *GetName());
 		return;
@@ -335,12 +356,12 @@ void AOxCharacter::TryUseItem()
 		return;
 	}
 
-	AnimInstance->Montage_Play(DrinkPotionMontage, 1.0f);
+	AnimInstance->Montage_Play(GetMontage(DrinkPotionMontage), 1.0f);
 }
 
 void AOxCharacter::TryOsu()
 {
-	if (!OsuMontage)
+	if (OsuMontage.IsNull())
 	{
 		UE_LOG(LogTemp, Error, TEXT("OsuMontage is null! %s"), *GetName());
 		return;
@@ -350,7 +371,7 @@ void AOxCharacter::TryOsu()
 		return;
 	}
 
-	AnimInstance->Montage_Play(OsuMontage, 1.0f);
+	AnimInstance->Montage_Play(GetMontage(OsuMontage), 1.0f);
 	DoOsuGesture.Broadcast();
 }
 
@@ -360,7 +381,7 @@ void AOxCharacter::TryDodgeRoll()
 
 bool AOxCharacter::TryPush()
 {
-	if (!PushMontage)
+	if (PushMontage.IsNull())
 	{
 		UE_LOG(LogTemp, Error, TEXT("PushMontage is null! %s"), *GetName());
 		return false;
@@ -374,35 +395,35 @@ bool AOxCharacter::TryPush()
 	PlayerCapsule->SetCapsuleRadius(PushingEnlargedCapsuleRadius);
 	PlayerCapsule->MoveComponent(GetActorForwardVector() * PushMoveCapsuleOffset, PlayerCapsule->GetComponentRotation(),
 	                             false);
-	AnimInstance->Montage_Play(PushMontage, 1.0f);
+	AnimInstance->Montage_Play(GetMontage(PushMontage), 1.0f);
 	return true;
 }
 
 void AOxCharacter::EndPush()
 {
-	if (!PushMontage)
+	if (PushMontage.IsNull())
 	{
 		UE_LOG(LogTemp, Error, TEXT("PushMontage is null! %s"), *GetName());
 		return;
 	}
 	if (IsPushing())
 	{
-		AnimInstance->Montage_JumpToSection(FName("End"), PushMontage);
+		AnimInstance->Montage_JumpToSection(FName("End"), PushMontage.Get());
 	}
 	GetCapsuleComponent()->SetCapsuleRadius(DefaultCapsuleRadius);
 }
 
 bool AOxCharacter::IsPushing() const
 {
-	return AnimInstance->Montage_IsPlaying(PushMontage);
+	return IsMontagePlaying(PushMontage);
 }
 
 bool AOxCharacter::IsDodging()
 {
-	return AnimInstance->Montage_IsPlaying(DodgeRollForwardMontage) ||
-		AnimInstance->Montage_IsPlaying(DodgeRollBackwardMontage) ||
-		AnimInstance->Montage_IsPlaying(DodgeRollLeftMontage) ||
-		AnimInstance->Montage_IsPlaying(DodgeRollRightMontage);
+	return IsMontagePlaying(DodgeRollForwardMontage) ||
+		IsMontagePlaying(DodgeRollBackwardMontage) ||
+		IsMontagePlaying(DodgeRollLeftMontage) ||
+		IsMontagePlaying(DodgeRollRightMontage);
 }
 
 bool AOxCharacter::IsJumping()
@@ -433,9 +454,9 @@ void AOxCharacter::OnOverlapBegin(UPrimitiveComponent* OverlappedComponent, AAct
 			// Reflect
 			// GEngine->AddOnScreenDebugMessage(-1, 15.0f, FColor::Green, TEXT("Reflect"));
 			AnimInstance->StopAllMontages(0.0f);
-			PlayAnimMontage(BeReflectedMontage, 1.0f);
+			PlayAnimMontage(GetMontage(BeReflectedMontage), 1.0f);
 			ReducePostureValue(VictimActor->PunchDamage * 5);
-			UGameplayStatics::SpawnSoundAtLocation(GetWorld(), ReflectSound, GetActorLocation());
+			UGameplayStatics::SpawnSoundAtLocation(GetWorld(), FOsuAssetLoader::Get(ReflectSound, this), GetActorLocation());
 		}
 		else
 		{
@@ -449,24 +470,27 @@ void AOxCharacter::OnOverlapBegin(UPrimitiveComponent* OverlappedComponent, AAct
 				// GEngine->AddOnScreenDebugMessage(-1, 15.0f, FColor::Yellow, TEXT("Blocking"));
 				VictimActor->ReducePostureValue(PunchDamage);
 
-				UGameplayStatics::SpawnSoundAtLocation(GetWorld(), BlockSound, GetActorLocation());
+				UGameplayStatics::SpawnSoundAtLocation(GetWorld(), FOsuAssetLoader::Get(BlockSound, this),
+				                                       GetActorLocation());
 			}
 			else
 			{
 				// GEngine->AddOnScreenDebugMessage(-1, 15.0f, FColor::White, TEXT("Damage"));
+				FOsuFirstUseScope FirstUseScope(this, TEXT("PunchHit"));
 
 				AController* InstigatorController = GetInstigatorController();
 				UClass* DamageTypeClass = UDamageType::StaticClass();
 				UGameplayStatics::ApplyDamage(OtherActor, PunchDamage, InstigatorController, this, DamageTypeClass);
 				VictimActor->ReducePostureValue(0.7f * PunchDamage);
 
-				UGameplayStatics::SpawnSoundAtLocation(GetWorld(), PunchHitSound, GetActorLocation());
-				if (HitEffectActor)
+				UGameplayStatics::SpawnSoundAtLocation(GetWorld(), FOsuAssetLoader::Get(PunchHitSound, this),
+				                                       GetActorLocation());
+				if (UClass* HitEffectClass = FOsuAssetLoader::Get(HitEffectActor, this))
 				{
 					// UNiagaraFunctionLibrary::SpawnSystemAtLocation(GetWorld(), HitEffectActor, SweepResult.ImpactPoint,
 					// GetActorRotation());
 
-					AActor* HitVfx = GetWorld()->SpawnActor<AActor>(HitEffectActor,
+					AActor* HitVfx = GetWorld()->SpawnActor<AActor>(HitEffectClass,
 					                                                OverlappedComponent->GetComponentLocation(),
 					                                                GetActorRotation());
 				}
@@ -494,6 +518,122 @@ float AOxCharacter::GetHpPercentage() const
 	return CurrentHp / MaxHp;
 }
 
+void AOxCharacter::SetCurrentHp(float NewHp)
+{
+	NewHp = FMath::Clamp(NewHp, 0.0f, MaxHp);
+	if (NewHp == CurrentHp)
+	{
+		return;
+	}
+	CurrentHp = NewHp;
+	OnAttributeChanged.Broadcast(EOxAttribute::Hp, CurrentHp, MaxHp);
+	RequestAttributeUpdate();
+}
+
+void AOxCharacter::SetCurrentPostureValue(float NewPostureValue)
+{
+	NewPostureValue = FMath::Clamp(NewPostureValue, 0.0f, MaxPostureValue);
+	if (NewPostureValue == CurrentPostureValue)
+	{
+		return;
+	}
+	CurrentPostureValue = NewPostureValue;
+	OnAttributeChanged.Broadcast(EOxAttribute::PostureValue, CurrentPostureValue, MaxPostureValue);
+	RequestAttributeUpdate();
+}
+
+void AOxCharacter::SetCurrentStamina(float NewStamina)
+{
+	NewStamina = FMath::Clamp(NewStamina, 0.0f, MaxStamina);
+	if (NewStamina == CurrentStamina)
+	{
+		return;
+	}
+	CurrentStamina = NewStamina;
+	OnAttributeChanged.Broadcast(EOxAttribute::Stamina, CurrentStamina, MaxStamina);
+	RequestAttributeUpdate();
+}
+
+float AOxCharacter::GetStaminaPercentage() const
+{
+	return CurrentStamina / MaxStamina;
+}
+
+bool AOxCharacter::HasStamina(float Cost) const
+{
+	return CurrentStamina >= Cost;
+}
+
+bool AOxCharacter::TryConsumeStamina(float Cost)
+{
+	if (!HasStamina(Cost))
+	{
+		return false;
+	}
+	SetCurrentStamina(CurrentStamina - Cost);
+	return true;
+}
+
+void AOxCharacter::SetStaminaDrainRate(float NewStaminaDrainRate)
+{
+	StaminaDrainRate = NewStaminaDrainRate;
+	RequestAttributeUpdate();
+}
+
+bool AOxCharacter::UpdateAttributes(float DeltaTime)
+{
+	if (IsDead())
+	{
+		IsAttributeUpdateRequested = false;
+		return false;
+	}
+
+	if (HpRegenRate > 0 && CurrentHp < MaxHp)
+	{
+		SetCurrentHp(CurrentHp + HpRegenRate * DeltaTime);
+	}
+	if (CurrentPostureValue < MaxPostureValue && CanRegenPosture())
+	{
+		SetCurrentPostureValue(CurrentPostureValue + PostureValueRegenRate * DeltaTime);
+	}
+	if (StaminaDrainRate > 0)
+	{
+		SetCurrentStamina(CurrentStamina - StaminaDrainRate * DeltaTime);
+		if (CurrentStamina <= 0)
+		{
+			OnStaminaDepleted();
+		}
+	}
+	else if (CurrentStamina < MaxStamina && CanRegenStamina())
+	{
+		SetCurrentStamina(CurrentStamina + StaminaRegenRate * DeltaTime);
+	}
+
+	IsAttributeUpdateRequested = NeedsAttributeUpdate();
+	return IsAttributeUpdateRequested;
+}
+
+bool AOxCharacter::NeedsAttributeUpdate() const
+{
+	return (HpRegenRate > 0 && CurrentHp < MaxHp)
+		|| CurrentPostureValue < MaxPostureValue
+		|| CurrentStamina < MaxStamina
+		|| StaminaDrainRate > 0;
+}
+
+void AOxCharacter::RequestAttributeUpdate()
+{
+	if (IsAttributeUpdateRequested || IsDead() || !NeedsAttributeUpdate())
+	{
+		return;
+	}
+	if (UOxAttributeSubsystem* AttributeSubsystem = GetWorld()->GetSubsystem<UOxAttributeSubsystem>())
+	{
+		IsAttributeUpdateRequested = true;
+		AttributeSubsystem->RequestUpdate(this);
+	}
+}
+
 float AOxCharacter::GetPostureValuePercentage() const
 {
 	return CurrentPostureValue / MaxPostureValue;
@@ -514,11 +654,139 @@ void AOxCharacter::SetAnimationState(EAnimationState NewAnimationState)
 	CurrentAnimationState = NewAnimationState;
 }
 
+void AOxCharacter::SerializeState(FArchive& Ar)
+{
+	FTransform Transform = GetActorTransform();
+	float Hp = CurrentHp;
+	float PostureValue = CurrentPostureValue;
+	float Stamina = CurrentStamina;
+	EAnimationState AnimationState = CurrentAnimationState;
+	Ar << Transform << Hp << PostureValue << Stamina << AnimationState;
+	if (!Ar.IsLoading())
+	{
+		return;
+	}
+
+	const bool WasAlive = IsAlive();
+	ResetCombatState();
+	SetActorTransform(Transform, false, nullptr, ETeleportType::TeleportPhysics);
+	SetCurrentHp(Hp);
+	SetCurrentPostureValue(PostureValue);
+	SetCurrentStamina(Stamina);
+	if (AnimationState != CurrentAnimationState)
+	{
+		switch (AnimationState)
+		{
+		case EAnimationState::Pistol:
+			WeaponSystemComponent->EquipPistol();
+			break;
+		case EAnimationState::Rifle:
+			WeaponSystemComponent->EquipRifle();
+			break;
+		default:
+			WeaponSystemComponent->UnequipAllWeapon();
+			break;
+		}
+	}
+	if (WasAlive && IsDead())
+	{
+		Die();
+	}
+	else if (!WasAlive && IsAlive())
+	{
+		Revive();
+	}
+}
+
+void AOxCharacter::ResetCombatState()
+{
+	if (AnimInstance)
+	{
+		AnimInstance->StopAllMontages(0.0f);
+	}
+	CharacterMovementComponent->StopMovementImmediately();
+	IsAttackReflectable = false;
+	IsGuardReflectable = false;
+	IsGuarding = false;
+	IsExecutable = false;
+	BlockMovementReasons.Empty();
+	HittingActorList.Empty();
+}
+
 void AOxCharacter::PlayMontage(UAnimMontage* MontageToPlay, float PlayRate)
 {
 	AnimInstance->Montage_Play(MontageToPlay, PlayRate);
 }
 
+bool AOxCharacter::IsMontagePlaying(const TSoftObjectPtr<UAnimMontage>& Montage) const
+{
+	UAnimMontage* LoadedMontage = Montage.Get();
+	return LoadedMontage && AnimInstance && AnimInstance->Montage_IsPlaying(LoadedMontage);
+}
+
+UAnimMontage* AOxCharacter::GetMontage(const TSoftObjectPtr<UAnimMontage>& Montage) const
+{
+	return FOsuAssetLoader::Get(Montage, this);
+}
+
+void AOxCharacter::GetAssetBundlePaths(EOsuAssetBundle Bundle, TArray<FSoftObjectPath>& OutPaths) const
+{
+	switch (Bundle)
+	{
+	case EOsuAssetBundle::Unarmed:
+		FOsuAssetLoader::AddPath(OutPaths, BlockMontage);
+		for (const TSoftObjectPtr<UAnimMontage>& FistAttackMontage : FistAttackMontages)
+		{
+			FOsuAssetLoader::AddPath(OutPaths, FistAttackMontage);
+		}
+		FOsuAssetLoader::AddPath(OutPaths, ExecutePunchAttackMontage);
+		FOsuAssetLoader::AddPath(OutPaths, HitReactMontage);
+		FOsuAssetLoader::AddPath(OutPaths, BeReflectedMontage);
+		FOsuAssetLoader::AddPath(OutPaths, BreakMontage);
+		FOsuAssetLoader::AddPath(OutPaths, DrinkPotionMontage);
+		FOsuAssetLoader::AddPath(OutPaths, OsuMontage);
+		FOsuAssetLoader::AddPath(OutPaths, DodgeRollForwardMontage);
+		FOsuAssetLoader::AddPath(OutPaths, DodgeRollBackwardMontage);
+		FOsuAssetLoader::AddPath(OutPaths, DodgeRollLeftMontage);
+		FOsuAssetLoader::AddPath(OutPaths, DodgeRollRightMontage);
+		FOsuAssetLoader::AddPath(OutPaths, DieMontage);
+		FOsuAssetLoader::AddPath(OutPaths, PunchHitSound);
+		FOsuAssetLoader::AddPath(OutPaths, BlockSound);
+		FOsuAssetLoader::AddPath(OutPaths, ReflectSound);
+		FOsuAssetLoader::AddPath(OutPaths, HitEffectActor);
+		break;
+	case EOsuAssetBundle::Puzzle:
+		FOsuAssetLoader::AddPath(OutPaths, PushMontage);
+		break;
+	case EOsuAssetBundle::Pistol:
+	case EOsuAssetBundle::Rifle:
+		if (WeaponSystemComponent)
+		{
+			WeaponSystemComponent->GetAssetBundlePaths(Bundle, OutPaths);
+		}
+		break;
+	default: ;
+	}
+}
+
+void AOxCharacter::RequestAssetBundle(EOsuAssetBundle Bundle)
+{
+	TSharedPtr<FStreamableHandle>& Handle = AssetBundleHandles[static_cast<int32>(Bundle)];
+	if (Handle.IsValid())
+	{
+		return;
+	}
+	TArray<FSoftObjectPath> Paths;
+	GetAssetBundlePaths(Bundle, Paths);
+	Handle = FOsuAssetLoader::RequestAsyncLoad(MoveTemp(Paths), this);
+}
+
+bool AOxCharacter::IsAssetBundleLoaded(EOsuAssetBundle Bundle) const
+{
+	const TSharedPtr<FStreamableHandle>& Handle = AssetBundleHandles[static_cast<int32>(Bundle)];
+	return Handle.IsValid() && Handle->HasLoadCompleted();
+}
+
 EAnimationState AOxCharacter::GetCurrentAnimationState() const
 {
 	return CurrentAnimationState;
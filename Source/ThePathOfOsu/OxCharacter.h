@@ -9,14 +9,18 @@
 #include "NiagaraComponent.h"
 #include "OsuType.h"
 #include "WeaponSystemComponent.h"
+#include "Interface/SaveableInterface.h"
+#include "Engine/StreamableManager.h"
 #include "OxCharacter.generated.h"
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnBeginPush);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FDoOsuGesture);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnInterruptPushing);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnAttributeChanged, EOxAttribute, Attribute, float, CurrentValue,
+                                               float, MaxValue);
 
 UCLASS()
-class THEPATHOFOSU_API AOxCharacter : public ACharacter
+class THEPATHOFOSU_API AOxCharacter : public ACharacter, public ISaveableInterface
 {
 	GENERATED_BODY()
 
@@ -34,52 +38,52 @@ protected:
 
 
 	UPROPERTY(EditDefaultsOnly, Category = "Combat")
-	UAnimMontage* BlockMontage;
+	TSoftObjectPtr<UAnimMontage> BlockMontage;
 
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Combat")
 	float BlockMontagePlayRate = 1.5f;
 
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Combat")
-	TArray<UAnimMontage*> FistAttackMontages;
+	TArray<TSoftObjectPtr<UAnimMontage>> FistAttackMontages;
 
 	UPROPERTY(EditDefaultsOnly, Category = "Combat")
-	UAnimMontage* ExecutePunchAttackMontage;
+	TSoftObjectPtr<UAnimMontage> ExecutePunchAttackMontage;
 
 	UPROPERTY(EditDefaultsOnly, Category = "Combat")
-	UAnimMontage* HitReactMontage;
+	TSoftObjectPtr<UAnimMontage> HitReactMontage;
 
 	UPROPERTY(EditDefaultsOnly, Category = "Combat")
-	UAnimMontage* BeReflectedMontage;
+	TSoftObjectPtr<UAnimMontage> BeReflectedMontage;
 
 	UPROPERTY(EditDefaultsOnly, Category = "Combat")
-	UAnimMontage* BreakMontage;
+	TSoftObjectPtr<UAnimMontage> BreakMontage;
 
 	UPROPERTY(EditDefaultsOnly, Category = "Combat")
-	UAnimMontage* DrinkPotionMontage;
+	TSoftObjectPtr<UAnimMontage> DrinkPotionMontage;
 
 	UPROPERTY(EditDefaultsOnly, Category = "Combat")
-	UAnimMontage* OsuMontage;
+	TSoftObjectPtr<UAnimMontage> OsuMontage;
 
 	UPROPERTY(EditDefaultsOnly, Category = "Combat")
-	UAnimMontage* PushMontage;
+	TSoftObjectPtr<UAnimMontage> PushMontage;
 
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Combat")
 	float BreakMontagePlayRate = 0.7f;
 	
 	UPROPERTY(EditDefaultsOnly, Category = "Combat")
-	UAnimMontage* DodgeRollForwardMontage;
+	TSoftObjectPtr<UAnimMontage> DodgeRollForwardMontage;
 	
 	UPROPERTY(EditDefaultsOnly, Category = "Combat")
-	UAnimMontage* DodgeRollBackwardMontage;
+	TSoftObjectPtr<UAnimMontage> DodgeRollBackwardMontage;
 	
 	UPROPERTY(EditDefaultsOnly, Category = "Combat")
-	UAnimMontage* DodgeRollLeftMontage;
+	TSoftObjectPtr<UAnimMontage> DodgeRollLeftMontage;
 	
 	UPROPERTY(EditDefaultsOnly, Category = "Combat")
-	UAnimMontage* DodgeRollRightMontage;
+	TSoftObjectPtr<UAnimMontage> DodgeRollRightMontage;
 
 	UPROPERTY(EditDefaultsOnly, Category = "Combat")
-	UAnimMontage* DieMontage;
+	TSoftObjectPtr<UAnimMontage> DieMontage;
 
 	UPROPERTY(VisibleAnywhere, Category = "Combat")
 	USphereComponent* LeftFistCollisionComponent;
@@ -90,20 +94,26 @@ protected:
 	TArray<AActor*> HittingActorList;
 
 	UPROPERTY(EditAnywhere)
-	USoundBase* PunchHitSound;
+	TSoftObjectPtr<USoundBase> PunchHitSound;
 
 	UPROPERTY(EditAnywhere)
-	USoundBase* BlockSound;
+	TSoftObjectPtr<USoundBase> BlockSound;
 
 	UPROPERTY(EditAnywhere)
-	USoundBase* ReflectSound;
+	TSoftObjectPtr<USoundBase> ReflectSound;
 
 	UPROPERTY(EditAnywhere)
-	UClass* HitEffectActor;
+	TSoftClassPtr<AActor> HitEffectActor;
 
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Weapon")
 	UWeaponSystemComponent* WeaponSystemComponent;
 
+	// Montage_IsPlaying(nullptr) means any montage, an unset or not yet loaded montage is never playing
+	bool IsMontagePlaying(const TSoftObjectPtr<UAnimMontage>& Montage) const;
+	UAnimMontage* GetMontage(const TSoftObjectPtr<UAnimMontage>& Montage) const;
+
+	virtual void GetAssetBundlePaths(EOsuAssetBundle Bundle, TArray<FSoftObjectPath>& OutPaths) const;
+
 	UPROPERTY(EditDefaultsOnly)
 	float PushingEnlargedCapsuleRadius = 65.0f;
 	UPROPERTY(EditDefaultsOnly)
@@ -120,7 +130,6 @@ protected:
 
 	virtual float TakeDamage(float DamageAmount, FDamageEvent const& DamageEvent, AController* EventInstigator,
 	                         AActor* DamageCauser) override;
-	virtual void Heal(float HealAmount);
 
 	virtual void ReducePostureValue(float PostureValueToReduce);
 	virtual void RestorePostureValue(float PostureValueToRestore);
@@ -132,6 +141,8 @@ protected:
 
 	UFUNCTION(BlueprintPure)
 	virtual bool CanRegenPosture();
+	virtual bool CanRegenStamina();
+	virtual void OnStaminaDepleted();
 
 	UFUNCTION(BlueprintPure)
 	virtual bool CanMove();
@@ -168,6 +179,8 @@ protected:
 
 
 	virtual void Die();
+	// Undoes Die when a save or checkpoint brings the character back
+	virtual void Revive();
 
 	UFUNCTION()
 	virtual void OnMontageEnded(UAnimMontage* Montage, bool bInterrupted);
@@ -177,6 +190,17 @@ protected:
 	EAnimationState CurrentAnimationState;
 	
 public:
+	virtual void Heal(float HealAmount);
+
+	FORCEINLINE UWeaponSystemComponent* GetWeaponSystemComponent() const { return WeaponSystemComponent; }
+
+	// Starts loading the assets of Bundle in the background, they stay loaded for the lifetime of the character
+	UFUNCTION(BlueprintCallable)
+	void RequestAssetBundle(EOsuAssetBundle Bundle);
+
+	UFUNCTION(BlueprintPure)
+	bool IsAssetBundleLoaded(EOsuAssetBundle Bundle) const;
+
 	// Called every frame
 	virtual void Tick(float DeltaTime) override;
 
@@ -231,6 +255,39 @@ public:
 	UFUNCTION(BlueprintPure)
 	float GetPostureValuePercentage() const;
 
+	UPROPERTY(EditDefaultsOnly, Category = "Combat")
+	float HpRegenRate = 0.0f;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Stamina")
+	float MaxStamina = 100;
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Stamina")
+	float CurrentStamina = MaxStamina;
+	UPROPERTY(EditDefaultsOnly, Category = "Stamina")
+	float StaminaRegenRate = 10;
+
+	UFUNCTION(BlueprintPure)
+	float GetStaminaPercentage() const;
+
+	bool HasStamina(float Cost) const;
+	// Spends Cost only when enough stamina is left
+	bool TryConsumeStamina(float Cost);
+	// Stamina spent per second instead of regenerating, e.g. while sprinting
+	void SetStaminaDrainRate(float NewStaminaDrainRate);
+
+	// All writes to CurrentHp, CurrentPostureValue and CurrentStamina go through these so OnAttributeChanged fires only on change
+	void SetCurrentHp(float NewHp);
+	void SetCurrentPostureValue(float NewPostureValue);
+	void SetCurrentStamina(float NewStamina);
+
+	// Applies regen and drain for DeltaTime, called by UOxAttributeSubsystem. Returns false once nothing is left to update
+	bool UpdateAttributes(float DeltaTime);
+
+	// Transform, vitals and the equipped weapon
+	virtual void SerializeState(FArchive& Ar) override;
+
+	UPROPERTY(BlueprintAssignable)
+	FOnAttributeChanged OnAttributeChanged;
+
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat")
 	float PunchDamage = 15;
 
@@ -278,5 +335,16 @@ public:
 
 private:
 	float DefaultCapsuleRadius;
+
+	float StaminaDrainRate = 0.0f;
+	bool IsAttributeUpdateRequested = false;
+
+	bool NeedsAttributeUpdate() const;
+	void RequestAttributeUpdate();
+
+	// Drops montages and the flags their notifies left behind, the restored state starts from idle
+	void ResetCombatState();
+
+	TSharedPtr<FStreamableHandle> AssetBundleHandles[static_cast<int32>(EOsuAssetBundle::Count)];
 	
 };
@@ -8,13 +8,15 @@
 
 APenLight::APenLight()
 {
-	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bCanEverTick = false;
 	HasBeenRepaired = false;
 }
 
 void APenLight::BeginPlay()
 {
 	Super::BeginPlay();
+	BrokenMaterial = Mesh->GetMaterial(0);
+	BrokenIcon = InteractionPrompt.Icon;
 	if (!SubtitleActor)
 	{
 		GEngine->AddOnScreenDebugMessage(-1, 15.0f, FColor::Red,
@@ -23,11 +25,6 @@ void APenLight::BeginPlay()
 	}
 }
 
-void APenLight::Tick(float DeltaTime)
-{
-	Super::Tick(DeltaTime);
-}
-
 void APenLight::Interact_Implementation(APlayerCharacter* InteractCharacter)
 {
 	if (CanPickup(InteractCharacter))
@@ -49,6 +46,7 @@ void APenLight::Interact_Implementation(APlayerCharacter* InteractCharacter)
 				Repair();
 				OnInteract.Broadcast();
 				InteractCharacter->RemoveInventoryItem(RequireItemType);
+				InteractCharacter->RefreshInteractionPrompt();
 			}
 		}
 	}
@@ -73,8 +71,25 @@ bool APenLight::CanRepair(APlayerCharacter* PickingCharacter)
 
 void APenLight::Repair()
 {
-	Mesh->SetMaterial(0, LightingMaterial);
-	InteractionHUD->SetSprite(PickupIcon);
+	SetRepairedLook(true);
 	UGameplayStatics::SpawnSoundAtLocation(GetWorld(), RepairSound, GetActorLocation());
 	HasBeenRepaired = true;
 }
+
+void APenLight::SerializeState(FArchive& Ar)
+{
+	Super::SerializeState(Ar);
+	bool SavedHasBeenRepaired = HasBeenRepaired;
+	Ar << SavedHasBeenRepaired;
+	if (Ar.IsLoading() && SavedHasBeenRepaired != HasBeenRepaired)
+	{
+		HasBeenRepaired = SavedHasBeenRepaired;
+		SetRepairedLook(HasBeenRepaired);
+	}
+}
+
+void APenLight::SetRepairedLook(bool IsRepaired)
+{
+	Mesh->SetMaterial(0, IsRepaired ? LightingMaterial : BrokenMaterial);
+	InteractionPrompt.Icon = IsRepaired ? PickupIcon.Get() : BrokenIcon;
+}
@@ -19,10 +19,9 @@ protected:
 	virtual void BeginPlay() override;
 
 public:
-	virtual void Tick(float DeltaTime) override;
-
 	virtual void Interact_Implementation(APlayerCharacter* InteractCharacter) override;
 	virtual bool CanPickup(APlayerCharacter* PickingCharacter) override;
+	virtual void SerializeState(FArchive& Ar) override;
 	bool CanRepair(APlayerCharacter* PickingCharacter);
 	
 	UPROPERTY(BlueprintReadWrite, EditAnywhere)
@@ -51,5 +50,14 @@ public:
 	
 	UPROPERTY(EditAnywhere)
 	USoundBase* RepairSound;
+
+private:
+	void SetRepairedLook(bool IsRepaired);
+
+	UPROPERTY()
+	UMaterialInterface* BrokenMaterial;
+
+	UPROPERTY()
+	UTexture2D* BrokenIcon;
 	
 };
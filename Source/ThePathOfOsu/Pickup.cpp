@@ -1,31 +1,24 @@
 ﻿#include "Pickup.h"
 
 #include "PlayerCharacter.h"
+#include "OsuEventBusSubsystem.h"
+#include "OsuWarmupSubsystem.h"
 #include "Kismet/GameplayStatics.h"
-#include "Kismet/KismetMathLibrary.h"
 
 
 APickup::APickup()
 {
-	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bCanEverTick = false;
 	RootComp = CreateDefaultSubobject<USceneComponent>(TEXT("RootComp"));
 	SetRootComponent(RootComp);
 	Mesh = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("Mesh"));
 	Mesh->SetupAttachment(RootComp);
 	MeshOutline = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("MeshOutline"));
 	MeshOutline->SetupAttachment(Mesh);
-	InteractionHUD = CreateDefaultSubobject<UBillboardComponent>(TEXT("InteractionHUD"));
-	InteractionHUD->SetupAttachment(RootComp);
-	InteractionHUD->SetRelativeLocation(FVector(0.0f, -48.0f, 31.0f));
-	InteractionHUD->SetRelativeScale3D(FVector(0.5f, 0.5f, 0.5f));
-	InteractionHUD->SetHiddenInGame(false);
 	Arrow = CreateDefaultSubobject<UArrowComponent>(TEXT("Arrow"));
 	Arrow->SetupAttachment(RootComp);
 	FColor ArrowColor = FColor::FromHex(TEXT("7F7CFFFF"));
 	Arrow->SetArrowColor(ArrowColor);
-	ObjectNameText = CreateDefaultSubobject<UTextRenderComponent>(TEXT("ObjectNameText"));
-	ObjectNameText->SetupAttachment(InteractionHUD);
-	ObjectNameText->SetRelativeLocation(FVector(0.0f, 96.0f, 125.0f));
 }
 
 void APickup::BeginPlay()
@@ -37,48 +30,52 @@ void APickup::BeginPlay()
 void APickup::SetupOutline_Implementation()
 {
 	IInteractableInterface::SetupOutline_Implementation();
+	// The outline is drawn by the player camera's post process material around this stencil value
+	Mesh->SetCustomDepthStencilValue(InteractableOutlineStencilValue);
+	Mesh->SetRenderCustomDepth(false);
+
+	// Outline mesh, used while the player camera has no outline post process material
 	MeshOutline->SetStaticMesh(Mesh->GetStaticMesh());
 	MeshOutline->SetRelativeScale3D(FVector(1.02f, 1.02f, 1.02f));
-
 	if (!OutlineMaterial)
 	{
-		GEngine->AddOnScreenDebugMessage(-1, 15.0f, FColor::Red,
-		                                 FString::Printf(TEXT(
-			                                 "OutlineMaterial is null, function: AAPickup::SetupOutline_Implementation()")));
-		UE_LOG(LogTemp, Error, TEXT("OutlineMaterial is null, function: AAPickup::SetupOutline_Implementation()"));
+		UE_LOG(LogTemp, Error, TEXT("OutlineMaterial is null, function: %s::SetupOutline_Implementation()"), *GetName());
 	}
-
 	for (int i = 0; i <= Mesh->GetNumMaterials() - 1; i++)
 	{
-		// UMaterialInterface* OutlineMaterial = Cast<UMaterialInterface>(
-		// 	StaticLoadObject(UObject::StaticClass(), nullptr, TEXT("/Game/Materials/M_MeshOutline")));
 		MeshOutline->SetMaterial(i, OutlineMaterial);
 	}
 	MeshOutline->SetVisibility(false);
-	InteractionHUD->SetVisibility(false);
-	ObjectNameText->SetVisibility(false);
+	IsHighlighted = false;
 }
 
 bool APickup::IsInteractiveHUDVisible_Implementation()
 {
-	return InteractionHUD->IsVisible();
+	return IsHighlighted;
 }
 
-void APickup::Tick(float DeltaTime)
+FInteractionPrompt APickup::GetInteractionPrompt_Implementation()
 {
-	Super::Tick(DeltaTime);
-	if (ObjectNameText->IsVisible())
+	// The instance prompt wins, subclasses such as APenLight swap its icon at runtime
+	FInteractionPrompt Prompt = InteractionPrompt;
+	if (ItemType)
 	{
-		FVector CameraLocation = UGameplayStatics::GetPlayerCameraManager(GetWorld(), 0)->GetTransformComponent()->
-			GetComponentLocation();
-		FRotator ToSetRotation = UKismetMathLibrary::FindLookAtRotation(GetActorLocation(), CameraLocation);
-		ObjectNameText->SetWorldRotation(ToSetRotation);
+		if (!Prompt.Icon && ItemType->Icon)
+		{
+			Prompt.Icon = ItemType->Icon;
+		}
+		if (Prompt.Name.IsEmpty() && !ItemType->ItemName.IsEmpty())
+		{
+			Prompt.Name = ItemType->ItemName;
+		}
 	}
+	return Prompt;
 }
 
 
 bool APickup::GiveItem()
 {
+	FOsuFirstUseScope FirstUseScope(this, TEXT("Pickup"));
 	APlayerCharacter* PlayerCharacter = Cast<APlayerCharacter>(UGameplayStatics::GetPlayerCharacter(GetWorld(), 0));
 	if (!PlayerCharacter)
 	{
@@ -93,7 +90,8 @@ bool APickup::GiveItem()
 			GEngine->AddOnScreenDebugMessage(-1, 15.0f, FColor::Red, FString::Printf(TEXT("GiveItemSound is null!")));
 		}
 		UGameplayStatics::SpawnSoundAtLocation(GetWorld(), GiveItemSound, GetActorLocation());
-		Destroy();
+		SetCollected(true);
+		UOsuEventBusSubsystem::Publish(this, FObjectiveProgressEvent{this, EObjectiveEvent::ItemPickedUp});
 	}
 	return IsGiveItemSuccessful;
 }
@@ -111,7 +109,7 @@ void APickup::Interact_Implementation(APlayerCharacter* InteractCharacter)
 		else
 		{
 			UGameplayStatics::SpawnSoundAtLocation(GetWorld(), GiveItemSound, GetActorLocation());
-			Destroy();
+			SetCollected(true);
 		}
 	}
 	else
@@ -128,21 +126,58 @@ bool APickup::CanPickup(APlayerCharacter* PickingCharacter)
 void APickup::ToggleOutline_Implementation(bool bValue)
 {
 	IInteractableInterface::ToggleOutline_Implementation(bValue);
-	MeshOutline->SetVisibility(bValue);
-	InteractionHUD->SetVisibility(bValue);
-	ObjectNameText->SetVisibility(bValue);
+	APlayerCharacter* PlayerCharacter = Cast<APlayerCharacter>(UGameplayStatics::GetPlayerCharacter(GetWorld(), 0));
+	const bool UsesPostProcessOutline = PlayerCharacter && PlayerCharacter->HasOutlinePostProcess();
+	Mesh->SetRenderCustomDepth(bValue && UsesPostProcessOutline);
+	MeshOutline->SetVisibility(bValue && !UsesPostProcessOutline);
+	IsHighlighted = bValue;
+	// The player is about to pick a weapon up, get its assets streaming before it is equipped
+	if (bValue && ItemType && PlayerCharacter)
+	{
+		if (ItemType->Effect == EItemEffect::EquipPistol)
+		{
+			PlayerCharacter->RequestAssetBundle(EOsuAssetBundle::Pistol);
+		}
+		else if (ItemType->Effect == EItemEffect::EquipRifle)
+		{
+			PlayerCharacter->RequestAssetBundle(EOsuAssetBundle::Rifle);
+		}
+	}
 }
 
 bool APickup::IsEnable_Implementation()
 {
-	return true;
+	return !IsCollected;
+}
+
+void APickup::SetCollected(bool NewIsCollected)
+{
+	IsCollected = NewIsCollected;
+	SetActorHiddenInGame(IsCollected);
+	SetActorEnableCollision(!IsCollected);
+	if (IsCollected)
+	{
+		ToggleOutline_Implementation(false);
+		GetWorld()->GetSubsystem<UOsuSchedulerSubsystem>()->Cancel(CheckAndUpdateWidgetVisibleJob);
+	}
+}
+
+void APickup::SerializeState(FArchive& Ar)
+{
+	bool SavedIsCollected = IsCollected;
+	Ar << SavedIsCollected;
+	if (Ar.IsLoading() && SavedIsCollected != IsCollected)
+	{
+		SetCollected(SavedIsCollected);
+	}
 }
 
 void APickup::StartCheckAndUpdateWidgetVisibleTimer_Implementation()
 {
 	IInteractableInterface::StartCheckAndUpdateWidgetVisibleTimer_Implementation();
-	GetWorldTimerManager().SetTimer(
-		CheckAndUpdateWidgetVisibleTimer, this, &APickup::CheckAndUpdateWidgetVisible_Implementation, 0.1f, true);
+	GetWorld()->GetSubsystem<UOsuSchedulerSubsystem>()->SchedulePeriodic(
+		CheckAndUpdateWidgetVisibleJob, TEXT("InteractableWidgetCheck"), 0.1f,
+		FSimpleDelegate::CreateUObject(this, &APickup::CheckAndUpdateWidgetVisible_Implementation));
 }
 
 void APickup::CheckAndUpdateWidgetVisible_Implementation()
@@ -159,6 +194,6 @@ void APickup::CheckAndUpdateWidgetVisible_Implementation()
 	{
 		ToggleOutline_Implementation(false);
 		PlayerCharacter->FocusActor = nullptr;
-		GetWorldTimerManager().ClearTimer(CheckAndUpdateWidgetVisibleTimer);
+		GetWorld()->GetSubsystem<UOsuSchedulerSubsystem>()->Cancel(CheckAndUpdateWidgetVisibleJob);
 	}
 }
@@ -6,15 +6,15 @@
 #include "Components/ArrowComponent.h"
 #include "GameFramework/Actor.h"
 #include "Interface/InteractableInterface.h"
+#include "Interface/SaveableInterface.h"
 #include "Components/StaticMeshComponent.h"
-#include "Components/BillboardComponent.h"
-#include "Components/TextRenderComponent.h"
+#include "OsuSchedulerSubsystem.h"
 #include "OsuType.h"
 #include "PlayerCharacter.h"
 #include "Pickup.generated.h"
 
 UCLASS()
-class THEPATHOFOSU_API APickup : public AActor, public IInteractableInterface
+class THEPATHOFOSU_API APickup : public AActor, public IInteractableInterface, public ISaveableInterface
 {
 	GENERATED_BODY()
 
@@ -25,7 +25,6 @@ protected:
 	virtual void BeginPlay() override;
 
 public:
-	virtual void Tick(float DeltaTime) override;
 	bool GiveItem();
 
 	virtual void Interact_Implementation(APlayerCharacter* InteractCharacter) override;
@@ -35,6 +34,8 @@ public:
 	virtual void CheckAndUpdateWidgetVisible_Implementation() override;
 	virtual void SetupOutline_Implementation() override;
 	virtual bool IsInteractiveHUDVisible_Implementation() override;
+	virtual FInteractionPrompt GetInteractionPrompt_Implementation() override;
+	virtual void SerializeState(FArchive& Ar) override;
 
 	UFUNCTION(BlueprintCallable, BlueprintPure)
 	virtual bool CanPickup(APlayerCharacter* PickingCharacter);
@@ -47,27 +48,35 @@ public:
 	UPROPERTY(BlueprintReadWrite, VisibleAnywhere)
 	UStaticMeshComponent* MeshOutline;
 
+	// Drawn on MeshOutline while the player camera has no outline post process material
+	UPROPERTY(EditAnywhere)
+	UMaterialInterface* OutlineMaterial;
+
 	UPROPERTY(BlueprintAssignable)
 	FOnInteract OnInteract;
 
-	UPROPERTY(BlueprintReadWrite, VisibleAnywhere)
-	UBillboardComponent* InteractionHUD;
-
 	UPROPERTY(BlueprintReadWrite, VisibleAnywhere)
 	UArrowComponent* Arrow;
 
-	UPROPERTY(BlueprintReadWrite, VisibleAnywhere)
-	UTextRenderComponent* ObjectNameText;
+	// Icon and name fall back to these when ItemType does not provide them
+	UPROPERTY(EditAnywhere, Category = "Interaction")
+	FInteractionPrompt InteractionPrompt;
+
+	UPROPERTY(BlueprintReadOnly, VisibleAnywhere)
+	bool IsHighlighted = false;
 
 	UPROPERTY(EditAnywhere)
 	UItem* ItemType;
 
 	UPROPERTY(EditAnywhere)
 	USoundBase* GiveItemSound;
-	
-	UPROPERTY(EditAnywhere)
-	UMaterialInterface* OutlineMaterial;
+
+	// Collected pickups are hidden instead of destroyed so a loaded save or a retry can bring them back
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	bool IsCollected = false;
+
+	void SetCollected(bool NewIsCollected);
 	
 private:
-	FTimerHandle CheckAndUpdateWidgetVisibleTimer;
+	FOsuJobHandle CheckAndUpdateWidgetVisibleJob;
 };
@@ -12,6 +12,11 @@
 #include "EnhancedInputComponent.h"
 #include "EnhancedInputSubsystems.h"
 #include "InputActionValue.h"
+#include "InteractionPromptWidget.h"
+#include "InventoryComponent.h"
+#include "OsuFrameArena.h"
+#include "OsuTraceServiceSubsystem.h"
+#include "OsuUIScreenManager.h"
 #include "Interface/InteractableInterface.h"
 #include "Kismet/GameplayStatics.h"
 #include "Kismet/KismetMathLibrary.h"
@@ -55,6 +60,8 @@ APlayerCharacter::APlayerCharacter()
 	// Attach the camera to the end of the boom and let the boom adjust to match the controller orientation
 	FollowCamera->bUsePawnControlRotation = false; // Camera does not rotate relative to arm
 
+	InventoryComponent = CreateDefaultSubobject<UInventoryComponent>(TEXT("InventoryComponent"));
+
 	// Note: The skeletal mesh and anim blueprint references on the Mesh component (inherited from Character) 
 	// are set in the derived blueprint asset named ThirdPersonCharacter (to avoid direct content references in C++)
 
@@ -66,6 +73,7 @@ void APlayerCharacter::BeginPlay()
 {
 	// Call the base class  
 	Super::BeginPlay();
+	RequestAssetBundle(EOsuAssetBundle::Puzzle);
 
 	//Add Input Mapping Context
 	PlayerController = Cast<APlayerController>(Controller);
@@ -81,9 +89,11 @@ void APlayerCharacter::BeginPlay()
 	GameInstance = Cast<UOsuGameInstance>(GetGameInstance());
 
 	AnimInstance->OnPlayMontageNotifyBegin.AddDynamic(this, &APlayerCharacter::OnPlayMontageNotifyBegin);
+	InventoryComponent->OnItemAdded.AddDynamic(this, &APlayerCharacter::OnInventoryItemAdded);
 
-	GetWorldTimerManager().SetTimer(FindInteractableTimerHandle, this,
-	                                &APlayerCharacter::FindAndHighlightInteractableObjectNearPlayer, 0.1f, true);
+	GetWorld()->GetSubsystem<UOsuSchedulerSubsystem>()->SchedulePeriodic(
+		FindInteractableJob, TEXT("InteractableScan"), 0.1f,
+		FSimpleDelegate::CreateUObject(this, &APlayerCharacter::FindAndHighlightInteractableObjectNearPlayer));
 
 	if (InteractableObjectTypes.IsEmpty())
 	{
@@ -95,6 +105,8 @@ void APlayerCharacter::BeginPlay()
 	WalkSpeed = CharacterMovementComponent->MaxWalkSpeed;
 	SetupGunCameraZoomTimeline();
 	SetupCrosshairWidget();
+	SetupInteractionPromptWidget();
+	SetupOutlinePostProcess();
 
 	SetAnimationState(EAnimationState::Unarmed);
 }
@@ -112,15 +124,6 @@ void APlayerCharacter::Tick(float DeltaSeconds)
 			{
 				PlayerController->SetControlRotation(LookAtRotation);
 			}
-			if (LockTargetEnemy->IsExecutable && LockTargetEnemy->TargetWidget->IsVisible())
-			{
-				LockTargetEnemy->HideTargetWidget();
-			}
-
-			if (!LockTargetEnemy->IsExecutable && !LockTargetEnemy->TargetWidget->IsVisible())
-			{
-				LockTargetEnemy->ShowTargetWidget();
-			}
 		}
 		if (LockTargetEnemy->IsDead())
 		{
@@ -128,6 +131,7 @@ void APlayerCharacter::Tick(float DeltaSeconds)
 		}
 	}
 	GunCameraZoomTimeline.TickTimeline(DeltaSeconds);
+	UpdateInteractionPrompt();
 }
 
 
@@ -256,12 +260,11 @@ void APlayerCharacter::SearchEnemyInFront(FHitResult& OutHit, bool& IsHit)
 	FRotator CameraRotation = FollowCamera->GetComponentRotation();
 	FVector EndLocation = StartLocation + CameraRotation.Vector() * 1300.f;
 	EndLocation.Z = StartLocation.Z;
-	TArray<AActor*> IgnoredActors;
-	IgnoredActors.Add(this);
-	IsHit = UKismetSystemLibrary::SphereTraceSingleForObjects(GetWorld(), StartLocation, EndLocation, 500.f,
-	                                                          TraceEnemyObjectTypes, false, IgnoredActors,
-	                                                          EDrawDebugTrace::None, OutHit, true,
-	                                                          FLinearColor::Red, FLinearColor::Green, 15.f);
+	// Not through the Kismet wrapper, it builds an ignore list and a result array every call
+	const FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(SearchEnemyInFront), false, this);
+	IsHit = GetWorld()->GetSubsystem<UOsuTraceServiceSubsystem>()->SweepSingleByObjectType(
+		OutHit, StartLocation, EndLocation, FCollisionObjectQueryParams(TraceEnemyObjectTypes),
+		FCollisionShape::MakeSphere(500.f), QueryParams);
 }
 
 void APlayerCharacter::TryJump()
@@ -275,22 +278,18 @@ void APlayerCharacter::TryJump()
 
 void APlayerCharacter::Interact()
 {
-	if (FocusActor)
+	if (FInteractableDispatch::IsInteractable(FocusActor))
 	{
-		IInteractableInterface* InteractableInterface = Cast<IInteractableInterface>(FocusActor);
-		if (InteractableInterface)
+		if (FInteractableDispatch::IsEnable(FocusActor))
 		{
-			if (InteractableInterface->Execute_IsEnable(FocusActor))
-			{
-				InteractableInterface->Execute_Interact(FocusActor, this);
-			}
+			FInteractableDispatch::Interact(FocusActor, this);
 		}
 	}
 }
 
 bool APlayerCharacter::CanUseItem()
 {
-	return Super::CanUseItem() && InventoryData.Num() > 0 && HasItem(CurrentSlotItem) && !IsCrouching;
+	return Super::CanUseItem() && HasItem(CurrentSlotItem) && !IsCrouching;
 }
 
 bool APlayerCharacter::CanOsu()
@@ -309,11 +308,9 @@ bool APlayerCharacter::CanUncrouch()
 	FVector UpVector = UKismetMathLibrary::GetUpVector(GetActorRotation());
 	FVector TraceEndLocation = PlayerLocation + UpVector * 100.0f;
 	FHitResult TraceHitResult;
-	FCollisionQueryParams TraceCollisionParams;
-	TraceCollisionParams.AddIgnoredActor(this);
-	GetWorld()->LineTraceSingleByChannel(TraceHitResult, PlayerLocation, TraceEndLocation,
-	                                     ECC_Visibility,
-	                                     TraceCollisionParams);
+	const FCollisionQueryParams TraceCollisionParams(SCENE_QUERY_STAT(CanUncrouch), false, this);
+	GetWorld()->GetSubsystem<UOsuTraceServiceSubsystem>()->LineTraceSingleByChannel(
+		TraceHitResult, PlayerLocation, TraceEndLocation, ECC_Visibility, TraceCollisionParams);
 	bool IsSomethingAbovePlayer = TraceHitResult.bBlockingHit;
 	return !IsSomethingAbovePlayer && !IsJumping();
 }
@@ -359,7 +356,9 @@ void APlayerCharacter::OnSprintStart()
 {
 	if (IsSprinting) return;
 	if (!CanSprint()) return;
+	if (!HasStamina(MinSprintStamina)) return;
 	IsSprinting = true;
+	SetStaminaDrainRate(SprintStaminaDrainRate);
 	CharacterMovementComponent->MaxWalkSpeed = SprintSpeed;
 	WeaponSystemComponent->StartSprint();
 }
@@ -368,6 +367,7 @@ void APlayerCharacter::OnSprintEnd()
 {
 	if (!IsSprinting) return;
 	IsSprinting = false;
+	SetStaminaDrainRate(0.0f);
 	CharacterMovementComponent->MaxWalkSpeed = WalkSpeed;
 	WeaponSystemComponent->EndSprint();
 }
@@ -431,39 +431,122 @@ void APlayerCharacter::SetupCrosshairWidget()
 		                                 FString::Printf(TEXT("CrosshairWidgetClass is null")));
 		return;
 	}
-	CrosshairWidget = CreateWidget<UUserWidget>(PlayerController, CrosshairWidgetClass);
+	CrosshairWidget = GetGameInstance()->GetSubsystem<UOsuUIScreenManager>()->AddHudScreen(CrosshairWidgetClass);
 	if (CrosshairWidget)
 	{
-		CrosshairWidget->AddToViewport();
 		HideCrosshair();
 	}
 }
 
+void APlayerCharacter::SetupInteractionPromptWidget()
+{
+	if (!InteractionPromptWidgetClass)
+	{
+		GEngine->AddOnScreenDebugMessage(-1, 15.0f, FColor::Red,
+		                                 FString::Printf(TEXT("InteractionPromptWidgetClass is null")));
+		return;
+	}
+	InteractionPromptWidget = CreateWidget<UInteractionPromptWidget>(PlayerController, InteractionPromptWidgetClass);
+	if (InteractionPromptWidget)
+	{
+		InteractionPromptWidget->AddToViewport();
+		InteractionPromptWidget->SetAlignmentInViewport(FVector2D(0.5f, 0.5f));
+		InteractionPromptWidget->SetVisibility(ESlateVisibility::Collapsed);
+	}
+}
+
+void APlayerCharacter::RefreshInteractionPrompt()
+{
+	// Forces the next update to fetch the prompt again
+	PromptActor = nullptr;
+	UpdateInteractionPrompt();
+}
+
+void APlayerCharacter::UpdateInteractionPrompt()
+{
+	if (!InteractionPromptWidget)
+	{
+		return;
+	}
+
+	AActor* HighlightedActor = nullptr;
+	if (IsValid(FocusActor) && FInteractableDispatch::IsInteractable(FocusActor) &&
+		FInteractableDispatch::IsInteractiveHUDVisible(FocusActor))
+	{
+		HighlightedActor = FocusActor;
+	}
+
+	if (HighlightedActor != PromptActor)
+	{
+		PromptActor = HighlightedActor;
+		if (PromptActor)
+		{
+			const FInteractionPrompt Prompt = FInteractableDispatch::GetInteractionPrompt(PromptActor);
+			PromptWorldOffset = Prompt.WorldOffset;
+			InteractionPromptWidget->SetPrompt(Prompt);
+		}
+	}
+
+	FVector2D ScreenPosition;
+	if (PromptActor && PlayerController && PlayerController->ProjectWorldLocationToScreen(
+		PromptActor->GetActorTransform().TransformPosition(PromptWorldOffset), ScreenPosition, true))
+	{
+		InteractionPromptWidget->SetPositionInViewport(ScreenPosition);
+		InteractionPromptWidget->SetVisibility(ESlateVisibility::HitTestInvisible);
+	}
+	else
+	{
+		InteractionPromptWidget->SetVisibility(ESlateVisibility::Collapsed);
+	}
+}
+
+void APlayerCharacter::SetupOutlinePostProcess()
+{
+	if (!OutlinePostProcessMaterial)
+	{
+		UE_LOG(LogTemp, Display, TEXT("OutlinePostProcessMaterial is not set, interactables use outline meshes"));
+		return;
+	}
+	FollowCamera->PostProcessSettings.AddBlendable(OutlinePostProcessMaterial, 1.0f);
+}
+
 void APlayerCharacter::TryDodgeRoll()
 {
 	if (!CanDodgeRoll()) return;
 	if (IsDodging()) return;
+	if (!TryConsumeStamina(RollStaminaCost)) return;
 	if (!IsTargetLocking && CurrentAnimationState == EAnimationState::Unarmed)
 	{
-		AnimInstance->Montage_Play(DodgeRollForwardMontage, 1.0f);
+		AnimInstance->Montage_Play(GetMontage(DodgeRollForwardMontage), 1.0f);
 		return;
 	}
 	if (CurrentMovementVector.X > 0)
 	{
-		AnimInstance->Montage_Play(DodgeRollRightMontage, 1.0f);
+		AnimInstance->Montage_Play(GetMontage(DodgeRollRightMontage), 1.0f);
 		return;
 	}
 	if (CurrentMovementVector.X < 0)
 	{
-		AnimInstance->Montage_Play(DodgeRollLeftMontage, 1.0f);
+		AnimInstance->Montage_Play(GetMontage(DodgeRollLeftMontage), 1.0f);
 		return;
 	}
 	if (CurrentMovementVector.Y < 0)
 	{
-		AnimInstance->Montage_Play(DodgeRollBackwardMontage, 1.0f);
+		AnimInstance->Montage_Play(GetMontage(DodgeRollBackwardMontage), 1.0f);
 		return;
 	}
-	AnimInstance->Montage_Play(DodgeRollForwardMontage, 1.0f);
+	AnimInstance->Montage_Play(GetMontage(DodgeRollForwardMontage), 1.0f);
+}
+
+bool APlayerCharacter::CanRegenStamina()
+{
+	return Super::CanRegenStamina() && !IsSprinting;
+}
+
+void APlayerCharacter::OnStaminaDepleted()
+{
+	Super::OnStaminaDepleted();
+	OnSprintEnd();
 }
 
 void APlayerCharacter::OnAttackActionEnd()
@@ -477,7 +560,7 @@ void APlayerCharacter::OnAttackActionEnd()
 void APlayerCharacter::UnlockTarget()
 {
 	IsTargetLocking = false;
-	LockTargetEnemy->HideTargetWidget();
+	LockTargetEnemy->SetTargetLocked(false);
 	CharacterMovementComponent->bOrientRotationToMovement = true;
 	bUseControllerRotationYaw = false;
 }
@@ -503,7 +586,7 @@ void APlayerCharacter::TryTargetLock()
 			{
 				// GEngine->AddOnScreenDebugMessage(-1, 15.0f, FColor::White, FString::Printf(TEXT("Target Actor: %s"),
 				// *TargetActor->GetName()));
-				LockTargetEnemy->ShowTargetWidget();
+				LockTargetEnemy->SetTargetLocked(true);
 				CharacterMovementComponent->bOrientRotationToMovement = false;
 				bUseControllerRotationYaw = true;
 				IsTargetLocking = true;
@@ -545,7 +628,7 @@ void APlayerCharacter::TryGuard()
 {
 	if (!CanGuard()) return;
 	Super::TryGuard();
-	AnimInstance->Montage_Play(BlockMontage, BlockMontagePlayRate);
+	AnimInstance->Montage_Play(GetMontage(BlockMontage), BlockMontagePlayRate);
 }
 
 void APlayerCharacter::TryGuardOrZoom()
@@ -620,16 +703,21 @@ void APlayerCharacter::TryFistAttack()
 			if (IsInAttackRange && InFrontEnemy->IsExecutable)
 			{
 				ExecutingTarget = InFrontEnemy;
-				AnimInstance->Montage_Play(ExecutePunchAttackMontage, 1.f);
+				AnimInstance->Montage_Play(GetMontage(ExecutePunchAttackMontage), 1.f);
 				return;
 			}
 		}
 	}
 
+	// A press during the montage only queues the next punch, which pays when it starts at ComboContinue
 	if (!IsPlayingFistAttackMontage())
 	{
+		if (!TryConsumeStamina(PunchStaminaCost))
+		{
+			return;
+		}
 		int32 RandomIndex = FMath::RandRange(0, FistAttackMontages.Num() - 1);
-		UAnimMontage* RandomFistAttackMontage = FistAttackMontages[RandomIndex];
+		UAnimMontage* RandomFistAttackMontage = GetMontage(FistAttackMontages[RandomIndex]);
 		AnimInstance->Montage_Play(RandomFistAttackMontage, 1.0f);
 	}
 	else
@@ -643,7 +731,7 @@ void APlayerCharacter::OnPlayMontageNotifyBegin(FName NotifyName,
                                                 const FBranchingPointNotifyPayload& BranchingPointPayload)
 {
 	// GEngine->AddOnScreenDebugMessage(-1, 15.0f, FColor::White, FString::Printf(TEXT("Notify Name %s"), *NotifyName.ToString()));
-	if (!IsMeleeAttackInputReceived && NotifyName == "ComboContinue")
+	if (NotifyName == "ComboContinue" && (!IsMeleeAttackInputReceived || !TryConsumeStamina(PunchStaminaCost)))
 	{
 		AnimInstance->Montage_Stop(0.35f);
 	}
@@ -684,6 +772,19 @@ void APlayerCharacter::Die()
 	OnPlayerDeath.Broadcast();
 }
 
+void APlayerCharacter::SerializeState(FArchive& Ar)
+{
+	Super::SerializeState(Ar);
+	if (Ar.IsLoading())
+	{
+		OnSprintEnd();
+		if (GetIsTargetLocking())
+		{
+			UnlockTarget();
+		}
+	}
+}
+
 void APlayerCharacter::SetAnimationState(EAnimationState NewAnimationState)
 {
 	Super::SetAnimationState(NewAnimationState);
@@ -729,13 +830,29 @@ void APlayerCharacter::EndFistAttack(bool IsLeftFist)
 
 void APlayerCharacter::FindAndHighlightInteractableObjectNearPlayer()
 {
-	TArray<AActor*> IgnoredActors;
-	IgnoredActors.Add(this);
-	bool IsHit = UKismetSystemLibrary::SphereOverlapActors(GetWorld(), GetActorLocation(),
-	                                                       FindHighlightInteractiveObjectDistance,
-	                                                       InteractableObjectTypes, nullptr,
-	                                                       IgnoredActors, CloseActors);
-	if (IsHit)
+	// A periodic scan can take its answer a frame late, so it goes into the async batch
+	const FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(FindInteractableObject), false, this);
+	GetWorld()->GetSubsystem<UOsuTraceServiceSubsystem>()->OverlapMultiByObjectType(
+		EOsuTraceLatency::NextFrame, GetActorLocation(), FCollisionObjectQueryParams(InteractableObjectTypes),
+		FCollisionShape::MakeSphere(FindHighlightInteractiveObjectDistance), QueryParams,
+		FOsuOverlapResultDelegate::CreateUObject(this, &APlayerCharacter::HighlightClosestInteractableObject));
+}
+
+void APlayerCharacter::HighlightClosestInteractableObject(const TArray<FOverlapResult>& Overlaps)
+{
+	// CloseActors keeps its capacity, so the scan stops allocating once the busiest spot has been visited.
+	// Other actors read it after this frame, so it cannot be an arena array
+	const SIZE_T CloseActorsSize = CloseActors.GetAllocatedSize();
+	CloseActors.Reset();
+	for (const FOverlapResult& Overlap : Overlaps)
+	{
+		if (AActor* OverlapActor = Overlap.GetActor())
+		{
+			CloseActors.AddUnique(OverlapActor);
+		}
+	}
+	FOsuFrameArena::Get().ReportBufferGrowth(CloseActors, CloseActorsSize);
+	if (!CloseActors.IsEmpty())
 	{
 		float MinDistance = 1000000;
 		AActor* ClosestInteractableObject = nullptr;
@@ -750,14 +867,13 @@ void APlayerCharacter::FindAndHighlightInteractableObjectNearPlayer()
 		}
 
 		FocusActor = ClosestInteractableObject;
-		IInteractableInterface* InteractableInterface = Cast<IInteractableInterface>(ClosestInteractableObject);
-		if (InteractableInterface)
+		if (FInteractableDispatch::IsInteractable(ClosestInteractableObject))
 		{
-			if (!InteractableInterface->Execute_IsInteractiveHUDVisible(ClosestInteractableObject) &&
-				InteractableInterface->Execute_IsEnable(ClosestInteractableObject))
+			if (!FInteractableDispatch::IsInteractiveHUDVisible(ClosestInteractableObject) &&
+				FInteractableDispatch::IsEnable(ClosestInteractableObject))
 			{
-				InteractableInterface->Execute_ToggleOutline(ClosestInteractableObject, true);
-				InteractableInterface->Execute_StartCheckAndUpdateWidgetVisibleTimer(ClosestInteractableObject);
+				FInteractableDispatch::ToggleOutline(ClosestInteractableObject, true);
+				FInteractableDispatch::StartCheckAndUpdateWidgetVisibleTimer(ClosestInteractableObject);
 			}
 		}
 	}
@@ -777,114 +893,37 @@ float APlayerCharacter::TakeDamage(float DamageAmount, FDamageEvent const& Damag
 
 int32 APlayerCharacter::GetInventoryItemCount(UItem* Item) const
 {
-	if (const int32* FoundItemCount = InventoryData.Find(Item))
-	{
-		return *FoundItemCount;
-	}
-	return 0;
+	return InventoryComponent->GetItemCount(Item);
 }
 
 bool APlayerCharacter::HasItem(UItem* Item)
 {
-	return InventoryData.Contains(Item);
+	return InventoryComponent->HasItem(Item);
 }
 
 bool APlayerCharacter::AddInventoryItem(UItem* NewItem, int32 ItemCount)
 {
-	bool IsAddSuccessful;
-	if (!NewItem)
-	{
-		GEngine->AddOnScreenDebugMessage(-1, 15.0f, FColor::Red,
-		                                 FString::Printf(TEXT("AddInventoryItem: Failed trying to add null item!")));
-		return false;
-	}
-	if (ItemCount <= 0)
-	{
-		GEngine->AddOnScreenDebugMessage(-1, 15.0f, FColor::Red,
-		                                 FString::Printf(TEXT("AddInventoryItem: ItemCount must be greater than 0!")));
-		return false;
-	}
-
-	int32 MaxCount = NewItem->MaxCount;
-	if (MaxCount <= 0)
-	{
-		MaxCount = MAX_int32;
-	}
-	if (InventoryData.Contains(NewItem))
-	{
-		int32 OldItemCount = InventoryData[NewItem];
-		InventoryData[NewItem] = FMath::Clamp(OldItemCount + ItemCount, 1, MaxCount);
-		IsAddSuccessful = true;
-	}
-	else
-	{
-		InventoryData.Add(NewItem, ItemCount);
-		IsAddSuccessful = true;
-		OnPlayerAddItem.Broadcast(NewItem);
-	}
-	// Temp set slotItem
-	return IsAddSuccessful;
+	return InventoryComponent->AddItem(NewItem, ItemCount);
 }
 
 bool APlayerCharacter::RemoveInventoryItem(UItem* RemovedItem, int32 RemoveCount)
 {
-	bool IsRemoveSuccessful;
-	if (!RemovedItem)
-	{
-		GEngine->AddOnScreenDebugMessage(-1, 15.0f, FColor::Red,
-		                                 FString::Printf(
-			                                 TEXT("RemoveInventoryItem: Failed trying to remove null item!")));
-		return false;
-	}
-
-	int32 ItemCount = GetInventoryItemCount(RemovedItem);
-	if (ItemCount <= 0)
-	{
-		GEngine->AddOnScreenDebugMessage(-1, 15.0f, FColor::Red,
-		                                 FString::Printf(TEXT(
-			                                 "RemoveInventoryItem: Failed trying to remove item with 0 count!")));
-		return false;
-	}
-
-	// If RemoveCount <= 0, delete all
-	if (RemoveCount <= 0)
-	{
-		ItemCount = 0;
-	}
-	else
-	{
-		ItemCount = FMath::Clamp(ItemCount - RemoveCount, 0, RemovedItem->MaxCount);
-	}
-
-	if (ItemCount > 0)
-	{
-		InventoryData[RemovedItem] = ItemCount;
-		IsRemoveSuccessful = true;
-	}
-	else
-	{
-		InventoryData.Remove(RemovedItem);
-		IsRemoveSuccessful = true;
-	}
-	return IsRemoveSuccessful;
+	return InventoryComponent->RemoveItem(RemovedItem, RemoveCount);
 }
 
 bool APlayerCharacter::UseItem(UItem* Item)
 {
-	if (GetInventoryItemCount(Item) <= 0)
+	const bool IsUseItemSuccessful = InventoryComponent->UseItem(Item);
+	if (IsUseItemSuccessful)
 	{
-		GEngine->AddOnScreenDebugMessage(-1, 15.0f, FColor::Red, FString::Printf(TEXT("No Item in Inventory")));
-		return false;
-	}
-
-	bool IsRemoveItemSuccessful = RemoveInventoryItem(Item, 1);
-	if (IsRemoveItemSuccessful)
-	{
-		// Vinegar Only
-		Heal(MaxHp * 0.5f);
 		OnPlayerUseItem.Broadcast();
 	}
-	return IsRemoveItemSuccessful;
+	return IsUseItemSuccessful;
+}
+
+void APlayerCharacter::OnInventoryItemAdded(UItem* Item, int32 NewCount)
+{
+	OnPlayerAddItem.Broadcast(Item);
 }
 
 bool APlayerCharacter::UseSlotItem()
@@ -894,10 +933,16 @@ bool APlayerCharacter::UseSlotItem()
 
 void APlayerCharacter::ShowCrosshair()
 {
-	CrosshairWidget->SetVisibility(ESlateVisibility::Visible);
+	if (CrosshairWidget)
+	{
+		CrosshairWidget->SetVisibility(ESlateVisibility::HitTestInvisible);
+	}
 }
 
 void APlayerCharacter::HideCrosshair()
 {
-	CrosshairWidget->SetVisibility(ESlateVisibility::Hidden);
+	if (CrosshairWidget)
+	{
+		CrosshairWidget->SetVisibility(ESlateVisibility::Collapsed);
+	}
 }
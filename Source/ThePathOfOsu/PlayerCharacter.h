@@ -10,6 +10,7 @@
 #include "Item.h"
 #include "OsuType.h"
 #include "OsuGameInstance.h"
+#include "OsuSchedulerSubsystem.h"
 #include "Components/TimelineComponent.h"
 #include "Kismet/KismetSystemLibrary.h"
 #include "PlayerCharacter.generated.h"
@@ -19,7 +20,10 @@ class USpringArmComponent;
 class UCameraComponent;
 class UInputMappingContext;
 class UInputAction;
+class UInteractionPromptWidget;
+class UInventoryComponent;
 struct FInputActionValue;
+struct FOverlapResult;
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnPlayerUseItem);
 
@@ -126,6 +130,9 @@ protected:
 
 	virtual void TryDodgeRoll() override;
 
+	virtual bool CanRegenStamina() override;
+	virtual void OnStaminaDepleted() override;
+
 	void OnAttackActionEnd();
 	// APawn interface
 	virtual void SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent) override;
@@ -142,6 +149,9 @@ protected:
 
 
 public:
+	virtual void SerializeState(FArchive& Ar) override;
+	virtual FName GetSaveId() const override { return TEXT("Player"); }
+
 	/** Returns CameraBoom subobject **/
 	FORCEINLINE class USpringArmComponent* GetCameraBoom() const { return CameraBoom; }
 	/** Returns FollowCamera subobject **/
@@ -167,10 +177,17 @@ public:
 	virtual void EndFistAttack(bool IsLeftFist) override;
 
 	TArray<AActor*> CloseActors;
+
+	bool HasOutlinePostProcess() const { return OutlinePostProcessMaterial != nullptr; }
+
+	UPROPERTY()
 	AActor* FocusActor;
 
+	// Re-reads the prompt of the focused interactable, call when its icon or name changes
+	void RefreshInteractionPrompt();
+
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Inventory")
-	TMap<UItem*, int32> InventoryData;
+	UInventoryComponent* InventoryComponent;
 
 	UPROPERTY(EditDefaultsOnly, Category = "Inventory")
 	UItem* CurrentSlotItem;
@@ -245,14 +262,15 @@ private:
 	bool IsCrouching = false;
 	
 
-	UPROPERTY(EditDefaultsOnly)
-	float MaxStamina = 100;
-	UPROPERTY(VisibleAnywhere)
-	float CurrentStamina;
-	UPROPERTY(EditDefaultsOnly)
-	float StaminaRegenRate = 10;
-	UPROPERTY(EditDefaultsOnly)
+	UPROPERTY(EditDefaultsOnly, Category = "Stamina")
 	float RollStaminaCost = 70;
+	UPROPERTY(EditDefaultsOnly, Category = "Stamina")
+	float PunchStaminaCost = 10;
+	UPROPERTY(EditDefaultsOnly, Category = "Stamina")
+	float SprintStaminaDrainRate = 15;
+	// Sprint cannot start below this, so it does not flicker on and off at empty stamina
+	UPROPERTY(EditDefaultsOnly, Category = "Stamina")
+	float MinSprintStamina = 10;
 	UPROPERTY(EditDefaultsOnly)
 	float FindHighlightInteractiveObjectDistance = 350.0f;
 
@@ -267,12 +285,20 @@ private:
 	APlayerController* PlayerController;
 	AEnemyCharacter* ExecutingTarget = nullptr;
 
-	FTimerHandle FindInteractableTimerHandle;
+	FOsuJobHandle FindInteractableJob;
 	void FindAndHighlightInteractableObjectNearPlayer();
+	void HighlightClosestInteractableObject(const TArray<FOverlapResult>& Overlaps);
 
 	UPROPERTY(EditAnywhere)
 	TArray<TEnumAsByte<EObjectTypeQuery>> InteractableObjectTypes;
 
+	// Post process material drawing the outline of every interactable rendering custom depth. Until it is set,
+	// interactables fall back to their outline meshes
+	UPROPERTY(EditDefaultsOnly)
+	UMaterialInterface* OutlinePostProcessMaterial;
+
+	void SetupOutlinePostProcess();
+
 	void TogglePauseGame();
 
 	UOsuGameInstance* GameInstance;
@@ -318,4 +344,22 @@ private:
 
 	UUserWidget* CrosshairWidget;
 	void SetupCrosshairWidget();
+
+	// Single prompt shared by every interactable, projected onto the highlighted one
+	UPROPERTY(EditDefaultsOnly)
+	TSubclassOf<UInteractionPromptWidget> InteractionPromptWidgetClass;
+
+	UPROPERTY()
+	UInteractionPromptWidget* InteractionPromptWidget;
+
+	UPROPERTY()
+	AActor* PromptActor;
+
+	FVector PromptWorldOffset;
+
+	void SetupInteractionPromptWidget();
+	void UpdateInteractionPrompt();
+
+	UFUNCTION()
+	void OnInventoryItemAdded(UItem* Item, int32 NewCount);
 };
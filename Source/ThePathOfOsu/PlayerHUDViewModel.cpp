@@ -0,0 +1,71 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "PlayerHUDViewModel.h"
+
+#include "InventoryComponent.h"
+#include "PlayerCharacter.h"
+
+void UPlayerHUDViewModel::Initialize(APlayerCharacter* InPlayerCharacter)
+{
+	Deinitialize();
+	if (!InPlayerCharacter)
+	{
+		return;
+	}
+	PlayerCharacter = InPlayerCharacter;
+	InPlayerCharacter->OnAttributeChanged.AddDynamic(this, &UPlayerHUDViewModel::OnAttributeChanged);
+	InPlayerCharacter->InventoryComponent->OnItemCountChanged.AddDynamic(
+		this, &UPlayerHUDViewModel::OnInventoryItemCountChanged);
+
+	HpPercentage = InPlayerCharacter->GetHpPercentage();
+	PostureValuePercentage = InPlayerCharacter->GetPostureValuePercentage();
+	StaminaPercentage = InPlayerCharacter->GetStaminaPercentage();
+	SlotItem = InPlayerCharacter->CurrentSlotItem;
+	SlotItemCount = InPlayerCharacter->GetInventoryItemCount(SlotItem);
+	OnFieldChanged.Broadcast(EPlayerHUDField::HpPercentage);
+	OnFieldChanged.Broadcast(EPlayerHUDField::PostureValuePercentage);
+	OnFieldChanged.Broadcast(EPlayerHUDField::StaminaPercentage);
+	OnFieldChanged.Broadcast(EPlayerHUDField::SlotItem);
+}
+
+void UPlayerHUDViewModel::Deinitialize()
+{
+	if (APlayerCharacter* OldPlayerCharacter = PlayerCharacter.Get())
+	{
+		OldPlayerCharacter->OnAttributeChanged.RemoveDynamic(this, &UPlayerHUDViewModel::OnAttributeChanged);
+		OldPlayerCharacter->InventoryComponent->OnItemCountChanged.RemoveDynamic(
+			this, &UPlayerHUDViewModel::OnInventoryItemCountChanged);
+	}
+	PlayerCharacter.Reset();
+}
+
+void UPlayerHUDViewModel::OnAttributeChanged(EOxAttribute Attribute, float CurrentValue, float MaxValue)
+{
+	const float Percentage = MaxValue > 0 ? CurrentValue / MaxValue : 0.0f;
+	switch (Attribute)
+	{
+	case EOxAttribute::Hp:
+		HpPercentage = Percentage;
+		OnFieldChanged.Broadcast(EPlayerHUDField::HpPercentage);
+		break;
+	case EOxAttribute::PostureValue:
+		PostureValuePercentage = Percentage;
+		OnFieldChanged.Broadcast(EPlayerHUDField::PostureValuePercentage);
+		break;
+	case EOxAttribute::Stamina:
+		StaminaPercentage = Percentage;
+		OnFieldChanged.Broadcast(EPlayerHUDField::StaminaPercentage);
+		break;
+	}
+}
+
+void UPlayerHUDViewModel::OnInventoryItemCountChanged(UItem* Item, int32 NewCount)
+{
+	if (Item != SlotItem || NewCount == SlotItemCount)
+	{
+		return;
+	}
+	SlotItemCount = NewCount;
+	OnFieldChanged.Broadcast(EPlayerHUDField::SlotItem);
+}
@@ -0,0 +1,62 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OsuType.h"
+#include "UObject/Object.h"
+#include "PlayerHUDViewModel.generated.h"
+
+class APlayerCharacter;
+class UItem;
+
+UENUM(BlueprintType)
+enum class EPlayerHUDField : uint8 {
+	HpPercentage = 0 UMETA(DisplayName = "HpPercentage"),
+	PostureValuePercentage = 1 UMETA(DisplayName = "PostureValuePercentage"),
+	SlotItem = 2 UMETA(DisplayName = "SlotItem"),
+	StaminaPercentage = 3 UMETA(DisplayName = "StaminaPercentage"),
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnPlayerHUDFieldChanged, EPlayerHUDField, Field);
+
+/**
+ * Values the player HUD displays, kept up to date from the player's change delegates
+ * so widgets never have to poll the character through property bindings
+ */
+UCLASS(BlueprintType)
+class THEPATHOFOSU_API UPlayerHUDViewModel : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	void Initialize(APlayerCharacter* InPlayerCharacter);
+	void Deinitialize();
+
+	UPROPERTY(BlueprintReadOnly)
+	float HpPercentage = 1.0f;
+
+	UPROPERTY(BlueprintReadOnly)
+	float PostureValuePercentage = 1.0f;
+
+	UPROPERTY(BlueprintReadOnly)
+	float StaminaPercentage = 1.0f;
+
+	UPROPERTY(BlueprintReadOnly)
+	UItem* SlotItem = nullptr;
+
+	UPROPERTY(BlueprintReadOnly)
+	int32 SlotItemCount = 0;
+
+	UPROPERTY(BlueprintAssignable)
+	FOnPlayerHUDFieldChanged OnFieldChanged;
+
+private:
+	TWeakObjectPtr<APlayerCharacter> PlayerCharacter;
+
+	UFUNCTION()
+	void OnAttributeChanged(EOxAttribute Attribute, float CurrentValue, float MaxValue);
+
+	UFUNCTION()
+	void OnInventoryItemCountChanged(UItem* Item, int32 NewCount);
+};
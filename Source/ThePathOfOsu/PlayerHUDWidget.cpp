@@ -0,0 +1,134 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "PlayerHUDWidget.h"
+
+#include "Item.h"
+#include "Blueprint/WidgetTree.h"
+#include "Components/CanvasPanel.h"
+#include "Components/CanvasPanelSlot.h"
+#include "Components/HorizontalBox.h"
+#include "Components/HorizontalBoxSlot.h"
+#include "Components/Image.h"
+#include "Components/ProgressBar.h"
+#include "Components/TextBlock.h"
+#include "Components/VerticalBox.h"
+#include "Components/VerticalBoxSlot.h"
+#include "Widgets/SInvalidationPanel.h"
+
+void UPlayerHUDWidget::SetViewModel(UPlayerHUDViewModel* InViewModel)
+{
+	if (ViewModel)
+	{
+		ViewModel->OnFieldChanged.RemoveDynamic(this, &UPlayerHUDWidget::OnFieldChanged);
+	}
+	ViewModel = InViewModel;
+	if (!ViewModel)
+	{
+		return;
+	}
+	ViewModel->OnFieldChanged.AddDynamic(this, &UPlayerHUDWidget::OnFieldChanged);
+	OnFieldChanged(EPlayerHUDField::HpPercentage);
+	OnFieldChanged(EPlayerHUDField::PostureValuePercentage);
+	OnFieldChanged(EPlayerHUDField::StaminaPercentage);
+	OnFieldChanged(EPlayerHUDField::SlotItem);
+}
+
+TSharedRef<SWidget> UPlayerHUDWidget::RebuildWidget()
+{
+	// Caches the HUD only, menus and the loading screen keep the project's default paint path
+	return SNew(SInvalidationPanel)
+	[
+		Super::RebuildWidget()
+	];
+}
+
+void UPlayerHUDWidget::NativeOnInitialized()
+{
+	Super::NativeOnInitialized();
+	if (WidgetTree && !WidgetTree->RootWidget)
+	{
+		BuildDefaultWidgetTree();
+	}
+}
+
+void UPlayerHUDWidget::BuildDefaultWidgetTree()
+{
+	UCanvasPanel* Root = WidgetTree->ConstructWidget<UCanvasPanel>();
+	WidgetTree->RootWidget = Root;
+
+	// Bars stacked in the top left corner
+	UVerticalBox* Bars = WidgetTree->ConstructWidget<UVerticalBox>();
+	UCanvasPanelSlot* BarsSlot = Root->AddChildToCanvas(Bars);
+	BarsSlot->SetPosition(FVector2D(40.0f, 40.0f));
+	BarsSlot->SetSize(FVector2D(320.0f, 60.0f));
+	auto AddBar = [this, Bars](const TCHAR* Name, const FLinearColor& FillColor)
+	{
+		UProgressBar* Bar = WidgetTree->ConstructWidget<UProgressBar>(UProgressBar::StaticClass(), Name);
+		Bar->SetFillColorAndOpacity(FillColor);
+		UVerticalBoxSlot* BarSlot = Bars->AddChildToVerticalBox(Bar);
+		BarSlot->SetSize(FSlateChildSize(ESlateSizeRule::Fill));
+		BarSlot->SetPadding(FMargin(0.0f, 0.0f, 0.0f, 4.0f));
+		return Bar;
+	};
+	HpBar = AddBar(TEXT("HpBar"), FLinearColor::Red);
+	PostureBar = AddBar(TEXT("PostureBar"), FLinearColor(1.0f, 0.6f, 0.0f));
+	StaminaBar = AddBar(TEXT("StaminaBar"), FLinearColor::Green);
+
+	// Slot item in the bottom right corner
+	UHorizontalBox* SlotItem = WidgetTree->ConstructWidget<UHorizontalBox>();
+	UCanvasPanelSlot* SlotItemSlot = Root->AddChildToCanvas(SlotItem);
+	SlotItemSlot->SetAnchors(FAnchors(1.0f, 1.0f));
+	SlotItemSlot->SetAlignment(FVector2D(1.0f, 1.0f));
+	SlotItemSlot->SetPosition(FVector2D(-40.0f, -40.0f));
+	SlotItemSlot->SetAutoSize(true);
+	SlotItemIcon = WidgetTree->ConstructWidget<UImage>(UImage::StaticClass(), TEXT("SlotItemIcon"));
+	SlotItemIcon->SetDesiredSizeOverride(FVector2D(64.0f, 64.0f));
+	SlotItem->AddChildToHorizontalBox(SlotItemIcon);
+	SlotItemCountText = WidgetTree->ConstructWidget<UTextBlock>(UTextBlock::StaticClass(), TEXT("SlotItemCountText"));
+	SlotItem->AddChildToHorizontalBox(SlotItemCountText)->SetVerticalAlignment(VAlign_Bottom);
+}
+
+void UPlayerHUDWidget::NativeDestruct()
+{
+	SetViewModel(nullptr);
+	Super::NativeDestruct();
+}
+
+void UPlayerHUDWidget::OnFieldChanged(EPlayerHUDField Field)
+{
+	switch (Field)
+	{
+	case EPlayerHUDField::HpPercentage:
+		if (HpBar)
+		{
+			HpBar->SetPercent(ViewModel->HpPercentage);
+		}
+		break;
+	case EPlayerHUDField::PostureValuePercentage:
+		if (PostureBar)
+		{
+			PostureBar->SetPercent(ViewModel->PostureValuePercentage);
+		}
+		break;
+	case EPlayerHUDField::StaminaPercentage:
+		if (StaminaBar)
+		{
+			StaminaBar->SetPercent(ViewModel->StaminaPercentage);
+		}
+		break;
+	case EPlayerHUDField::SlotItem:
+		if (SlotItemIcon)
+		{
+			UTexture2D* Icon = ViewModel->SlotItem ? ViewModel->SlotItem->Icon : nullptr;
+			SlotItemIcon->SetBrushFromTexture(Icon);
+			SlotItemIcon->SetVisibility(Icon ? ESlateVisibility::HitTestInvisible : ESlateVisibility::Collapsed);
+		}
+		if (SlotItemCountText)
+		{
+			SlotItemCountText->SetText(FText::AsNumber(ViewModel->SlotItemCount));
+		}
+		break;
+	}
+	OnViewModelFieldChanged(Field);
+}
@@ -0,0 +1,57 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Blueprint/UserWidget.h"
+#include "PlayerHUDViewModel.h"
+#include "PlayerHUDWidget.generated.h"
+
+class UImage;
+class UProgressBar;
+class UTextBlock;
+
+/**
+ * Player hp, posture, stamina and slot item display. Widgets are only touched when the view model reports a change,
+ * and the whole tree sits in an invalidation panel, so an idle HUD is not repainted.
+ */
+UCLASS()
+class THEPATHOFOSU_API UPlayerHUDWidget : public UUserWidget
+{
+	GENERATED_BODY()
+
+public:
+	void SetViewModel(UPlayerHUDViewModel* InViewModel);
+
+protected:
+	virtual TSharedRef<SWidget> RebuildWidget() override;
+	virtual void NativeOnInitialized() override;
+	virtual void NativeDestruct() override;
+
+	UPROPERTY(BlueprintReadOnly)
+	UPlayerHUDViewModel* ViewModel;
+
+	UPROPERTY(BlueprintReadOnly, meta = (BindWidgetOptional))
+	UProgressBar* HpBar;
+
+	UPROPERTY(BlueprintReadOnly, meta = (BindWidgetOptional))
+	UProgressBar* PostureBar;
+
+	UPROPERTY(BlueprintReadOnly, meta = (BindWidgetOptional))
+	UProgressBar* StaminaBar;
+
+	UPROPERTY(BlueprintReadOnly, meta = (BindWidgetOptional))
+	UImage* SlotItemIcon;
+
+	UPROPERTY(BlueprintReadOnly, meta = (BindWidgetOptional))
+	UTextBlock* SlotItemCountText;
+
+	UFUNCTION(BlueprintImplementableEvent)
+	void OnViewModelFieldChanged(EPlayerHUDField Field);
+
+private:
+	UFUNCTION()
+	void OnFieldChanged(EPlayerHUDField Field);
+
+	void BuildDefaultWidgetTree();
+};
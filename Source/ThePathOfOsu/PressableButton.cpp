@@ -1,11 +1,12 @@
 #include "PressableButton.h"
 
+#include "OsuEventBusSubsystem.h"
 #include "PlayerCharacter.h"
 #include "Kismet/GameplayStatics.h"
 
 APressableButton::APressableButton()
 {
-	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bCanEverTick = false;
 	IsActivated = false;
 	RootComp = CreateDefaultSubobject<USceneComponent>(TEXT("RootComp"));
 	SetRootComponent(RootComp);
@@ -16,41 +17,39 @@ APressableButton::APressableButton()
 	Transporter = CreateDefaultSubobject<UTransporter>(TEXT("Transporter"));
 	Transporter->MoveTime = 0.1f;
 	Transporter->IsOwnerTriggerActor = true;
-	InteractionHUD = CreateDefaultSubobject<UBillboardComponent>(TEXT("InteractionHUD"));
-	InteractionHUD->SetupAttachment(RootComp);
-	InteractionHUD->SetRelativeLocation(FVector(0.0f, -48.0f, 31.0f));
-	InteractionHUD->SetRelativeScale3D(FVector(0.5f, 0.5f, 0.5f));
-	InteractionHUD->SetHiddenInGame(false);
+	Transporter->PreloadsDestination = false;
 }
 
 void APressableButton::SetupOutline_Implementation()
 {
 	IInteractableInterface::SetupOutline_Implementation();
+	// The outline is drawn by the player camera's post process material around this stencil value
+	Mesh->SetCustomDepthStencilValue(InteractableOutlineStencilValue);
+	Mesh->SetRenderCustomDepth(false);
+
+	// Outline mesh, used while the player camera has no outline post process material
 	MeshOutline->SetStaticMesh(Mesh->GetStaticMesh());
 	MeshOutline->SetRelativeScale3D(FVector(1.02f, 1.02f, 1.02f));
-
-
 	if (!OutlineMaterial)
 	{
-		GEngine->AddOnScreenDebugMessage(-1, 15.0f, FColor::Red,
-		                                 FString::Printf(TEXT(
-			                                 "OutlineMaterial is null, function: AAPickup::SetupOutline_Implementation()")));
-		UE_LOG(LogTemp, Error, TEXT("OutlineMaterial is null, function: AAPickup::SetupOutline_Implementation()"));
+		UE_LOG(LogTemp, Error, TEXT("OutlineMaterial is null, function: %s::SetupOutline_Implementation()"), *GetName());
 	}
-
 	for (int i = 0; i <= Mesh->GetNumMaterials() - 1; i++)
 	{
-		// UMaterialInterface* OutlineMaterial = Cast<UMaterialInterface>(
-		// 	StaticLoadObject(UObject::StaticClass(), nullptr, TEXT("/Game/Materials/M_MeshOutline")));
 		MeshOutline->SetMaterial(i, OutlineMaterial);
 	}
 	MeshOutline->SetVisibility(false);
-	InteractionHUD->SetVisibility(false);
+	IsHighlighted = false;
 }
 
 bool APressableButton::IsInteractiveHUDVisible_Implementation()
 {
-	return InteractionHUD->IsVisible();
+	return IsHighlighted;
+}
+
+FInteractionPrompt APressableButton::GetInteractionPrompt_Implementation()
+{
+	return InteractionPrompt;
 }
 
 void APressableButton::BeginPlay()
@@ -66,15 +65,14 @@ void APressableButton::BeginPlay()
 	// 	UnusedHandle, TimerDelegate, 5.0f, false);
 }
 
-
-void APressableButton::Tick(float DeltaTime)
-{
-	Super::Tick(DeltaTime);
-}
-
 void APressableButton::Reset()
 {
 	Super::Reset();
+	ResetTask.Cancel();
+	if (IsActivated)
+	{
+		UOsuEventBusSubsystem::Publish(this, FLogicSignalEvent{this, false});
+	}
 	IsActivated = false;
 	Transporter->Reset();
 }
@@ -84,14 +82,11 @@ void APressableButton::Interact_Implementation(APlayerCharacter* InteractCharact
 {
 	IInteractableInterface::Interact_Implementation(InteractCharacter);
 	OnActivated.Broadcast();
+	UOsuEventBusSubsystem::Publish(this, FLogicSignalEvent{this, true});
 	IsActivated = true;
 	if (IsToggleable)
 	{
-		FTimerHandle TimerHandle;
-		GetWorld()->GetTimerManager().SetTimer(TimerHandle, [this]()
-		{
-			Reset();
-		}, 3.0f, false);
+		ScheduleReset();
 	}
 
 	if (PressSound)
@@ -103,8 +98,33 @@ void APressableButton::Interact_Implementation(APlayerCharacter* InteractCharact
 void APressableButton::ToggleOutline_Implementation(bool bValue)
 {
 	IInteractableInterface::ToggleOutline_Implementation(bValue);
-	MeshOutline->SetVisibility(bValue);
-	InteractionHUD->SetVisibility(bValue);
+	const APlayerCharacter* PlayerCharacter = Cast<APlayerCharacter>(UGameplayStatics::GetPlayerCharacter(GetWorld(), 0));
+	const bool UsesPostProcessOutline = PlayerCharacter && PlayerCharacter->HasOutlinePostProcess();
+	Mesh->SetRenderCustomDepth(bValue && UsesPostProcessOutline);
+	MeshOutline->SetVisibility(bValue && !UsesPostProcessOutline);
+	IsHighlighted = bValue;
+}
+
+void APressableButton::SerializeState(FArchive& Ar)
+{
+	// The transporter saves its own progress
+	Ar << IsActivated;
+	if (Ar.IsLoading() && IsActivated && IsToggleable)
+	{
+		ScheduleReset();
+	}
+}
+
+void APressableButton::ScheduleReset()
+{
+	ResetTask.Cancel();
+	ResetTask = ResetAfterDelay();
+}
+
+FOsuLatentTask APressableButton::ResetAfterDelay()
+{
+	co_await FOsuLatentDelay{ResetDelay};
+	Reset();
 }
 
 bool APressableButton::IsEnable_Implementation()
@@ -115,9 +135,9 @@ bool APressableButton::IsEnable_Implementation()
 void APressableButton::StartCheckAndUpdateWidgetVisibleTimer_Implementation()
 {
 	IInteractableInterface::StartCheckAndUpdateWidgetVisibleTimer_Implementation();
-	GetWorldTimerManager().SetTimer(
-		CheckAndUpdateWidgetVisibleTimer, this, &APressableButton::CheckAndUpdateWidgetVisible_Implementation, 0.1f,
-		true);
+	GetWorld()->GetSubsystem<UOsuSchedulerSubsystem>()->SchedulePeriodic(
+		CheckAndUpdateWidgetVisibleJob, TEXT("InteractableWidgetCheck"), 0.1f,
+		FSimpleDelegate::CreateUObject(this, &APressableButton::CheckAndUpdateWidgetVisible_Implementation));
 }
 
 void APressableButton::CheckAndUpdateWidgetVisible_Implementation()
@@ -132,6 +152,6 @@ void APressableButton::CheckAndUpdateWidgetVisible_Implementation()
 	{
 		ToggleOutline_Implementation(false);
 		PlayerCharacter->FocusActor = nullptr;
-		GetWorldTimerManager().ClearTimer(CheckAndUpdateWidgetVisibleTimer);
+		GetWorld()->GetSubsystem<UOsuSchedulerSubsystem>()->Cancel(CheckAndUpdateWidgetVisibleJob);
 	}
 }
@@ -2,12 +2,14 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "OsuLatentTask.h"
+#include "OsuSchedulerSubsystem.h"
 #include "PlayerCharacter.h"
 #include "Transporter.h"
 #include "GameFramework/Actor.h"
 #include "Components/StaticMeshComponent.h"
-#include "Components/BillboardComponent.h"
 #include "Interface/InteractableInterface.h"
+#include "Interface/SaveableInterface.h"
 #include "PressableButton.generated.h"
 
 
@@ -15,7 +17,7 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE(FPressableButtonOnActivated);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FPressableButtonOnDeactivated);
 
 UCLASS()
-class THEPATHOFOSU_API APressableButton : public AActor, public IInteractableInterface
+class THEPATHOFOSU_API APressableButton : public AActor, public IInteractableInterface, public ISaveableInterface
 {
 	GENERATED_BODY()
 	
@@ -26,8 +28,6 @@ protected:
 	virtual void BeginPlay() override;
 
 public:	
-	virtual void Tick(float DeltaTime) override;
-
 	void Interact_Implementation(APlayerCharacter* InteractCharacter) override;
 	void ToggleOutline_Implementation(bool bValue) override;
 	bool IsEnable_Implementation() override;
@@ -35,6 +35,8 @@ public:
 	void CheckAndUpdateWidgetVisible_Implementation() override;
 	void SetupOutline_Implementation() override;;
 	bool IsInteractiveHUDVisible_Implementation() override;
+	FInteractionPrompt GetInteractionPrompt_Implementation() override;
+	void SerializeState(FArchive& Ar) override;
 
 	void Reset();
 	
@@ -46,12 +48,20 @@ public:
 	UPROPERTY(BlueprintReadWrite, VisibleAnywhere)
 	UStaticMeshComponent* MeshOutline;
 
+	// Drawn on MeshOutline while the player camera has no outline post process material
+	UPROPERTY(EditAnywhere)
+	UMaterialInterface* OutlineMaterial;
+
 	UPROPERTY(BlueprintReadWrite, VisibleAnywhere)
 	bool IsActivated;
 
 	UPROPERTY(EditAnywhere)
 	bool IsToggleable = false;
 
+	// Seconds a toggleable button stays pressed before popping back up
+	UPROPERTY(EditAnywhere, meta = (EditCondition = "IsToggleable"))
+	float ResetDelay = 3.0f;
+
 	UPROPERTY(BlueprintAssignable)
 	FPressableButtonOnActivated OnActivated;
 	
@@ -61,15 +71,18 @@ public:
 	UPROPERTY(BlueprintReadWrite, VisibleAnywhere)
 	UTransporter* Transporter;
 
-	UPROPERTY(BlueprintReadWrite, VisibleAnywhere)
-	UBillboardComponent* InteractionHUD;
+	UPROPERTY(EditAnywhere, Category = "Interaction")
+	FInteractionPrompt InteractionPrompt;
+
+	UPROPERTY(BlueprintReadOnly, VisibleAnywhere)
+	bool IsHighlighted = false;
 
-	UPROPERTY(EditAnywhere)
-	UMaterialInterface* OutlineMaterial;
-	
 	UPROPERTY(EditAnywhere)
 	USoundBase* PressSound;
 	
 private:
-	FTimerHandle CheckAndUpdateWidgetVisibleTimer;
+	FOsuJobHandle CheckAndUpdateWidgetVisibleJob;
+	FOsuLatentTask ResetTask;
+	void ScheduleReset();
+	FOsuLatentTask ResetAfterDelay();
 };
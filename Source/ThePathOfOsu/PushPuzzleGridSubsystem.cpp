@@ -0,0 +1,259 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "PushPuzzleGridSubsystem.h"
+
+#include "OsuTraceServiceSubsystem.h"
+#include "PushableActor.h"
+
+void UPushPuzzleGridSubsystem::RegisterBlock(APushableActor* Block, float BlockSize, float StepSize)
+{
+	if (!Block || StepSize <= 0.0f)
+	{
+		UE_LOG(LogTemp, Error, TEXT("RegisterBlock: invalid block or step size"));
+		return;
+	}
+
+	const FVector MinCorner = Block->GetActorLocation() - FVector(BlockSize / 2.0f, BlockSize / 2.0f, 0.0f);
+	if (CellSize <= 0.0f)
+	{
+		CellSize = StepSize;
+		GridOrigin = MinCorner;
+	}
+	else if (!FMath::IsNearlyEqual(CellSize, StepSize))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("RegisterBlock: %s pushes %.1f per step, the grid uses %.1f"),
+		       *Block->GetName(), StepSize, CellSize);
+	}
+
+	// A block off the grid is snapped to the nearest cell, which is not where it really stands
+	const FVector GridOffset = (MinCorner - GridOrigin) / CellSize;
+	const FVector Misalignment = (GridOffset - FVector(FMath::RoundToDouble(GridOffset.X),
+	                                                   FMath::RoundToDouble(GridOffset.Y),
+	                                                   FMath::RoundToDouble(GridOffset.Z))) * CellSize;
+	if (!Misalignment.IsNearlyZero(CellSize * 0.05f))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("RegisterBlock: %s is off the push grid by %s"), *Block->GetName(),
+		       *Misalignment.ToCompactString());
+	}
+	const float BlockCellCount = BlockSize / CellSize;
+	if (!FMath::IsNearlyEqual(BlockCellCount, FMath::RoundToFloat(BlockCellCount), 0.05f))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("RegisterBlock: %s is %.1f wide, not a multiple of the %.1f grid cell"),
+		       *Block->GetName(), BlockSize, CellSize);
+	}
+
+	FBlockCells BlockCells;
+	BlockCells.Size = FMath::Max(1, FMath::RoundToInt(BlockSize / CellSize));
+	BlockCells.MinCell = GetMinCell(Block->GetActorLocation(), BlockCells.Size);
+	// Blocks are not level geometry, cells baked before this block registered have to be traced again
+	StaticCells.Reset();
+	OccupyCells(Block, BlockCells);
+	Blocks.Add(Block, BlockCells);
+	RefreshBakeQueryParams();
+}
+
+void UPushPuzzleGridSubsystem::UnregisterBlock(APushableActor* Block)
+{
+	FBlockCells BlockCells;
+	if (Blocks.RemoveAndCopyValue(Block, BlockCells))
+	{
+		ReleaseCells(Block, BlockCells);
+		RefreshBakeQueryParams();
+	}
+}
+
+void UPushPuzzleGridSubsystem::SetBlockLocation(APushableActor* Block, const FVector& Location)
+{
+	FBlockCells* BlockCells = Blocks.Find(Block);
+	if (!BlockCells)
+	{
+		return;
+	}
+	ReleaseCells(Block, *BlockCells);
+	BlockCells->MinCell = GetMinCell(Location, BlockCells->Size);
+	OccupyCells(Block, *BlockCells);
+}
+
+bool UPushPuzzleGridSubsystem::CanMoveBlock(const APushableActor* Block, const FIntPoint& Direction)
+{
+	const FBlockCells* BlockCells = Blocks.Find(Block);
+	if (!BlockCells || Direction.IsZero())
+	{
+		return false;
+	}
+
+	const int32 Size = BlockCells->Size;
+	const FIntVector& MinCell = BlockCells->MinCell;
+	for (int32 X = 0; X < Size; X++)
+	{
+		for (int32 Y = 0; Y < Size; Y++)
+		{
+			const FIntVector Above = MinCell + FIntVector(X, Y, Size);
+			if (IsOccupiedByOtherBlock(Above, Block))
+			{
+				return false;
+			}
+
+			// Only the row the block moves into is new, the rest of its destination is already its own
+			const bool IsFrontCell = (Direction.X > 0 && X == Size - 1) || (Direction.X < 0 && X == 0)
+				|| (Direction.Y > 0 && Y == Size - 1) || (Direction.Y < 0 && Y == 0);
+			if (!IsFrontCell)
+			{
+				continue;
+			}
+			const FIntVector Front = MinCell + FIntVector(X + Direction.X, Y + Direction.Y, 0);
+			const FIntVector BelowFront = Front - FIntVector(0, 0, 1);
+			if (!IsOccupiedByOtherBlock(BelowFront, Block) && !HasFloor(Front))
+			{
+				return false;
+			}
+			for (int32 Z = 0; Z < Size; Z++)
+			{
+				const FIntVector Cell = Front + FIntVector(0, 0, Z);
+				if (IsOccupiedByOtherBlock(Cell, Block) || IsBlockedByLevelGeometry(Cell))
+				{
+					return false;
+				}
+			}
+		}
+	}
+	return true;
+}
+
+bool UPushPuzzleGridSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+FIntVector UPushPuzzleGridSubsystem::GetMinCell(const FVector& BlockLocation, int32 BlockCellCount) const
+{
+	// The block's origin is the center of its bottom face
+	const float HalfSize = CellSize * BlockCellCount / 2.0f;
+	const FVector Offset = (BlockLocation - FVector(HalfSize, HalfSize, 0.0f) - GridOrigin) / CellSize;
+	return FIntVector(FMath::RoundToInt(Offset.X), FMath::RoundToInt(Offset.Y), FMath::RoundToInt(Offset.Z));
+}
+
+FVector UPushPuzzleGridSubsystem::GetCellCenter(const FIntVector& Cell) const
+{
+	return GridOrigin + (FVector(Cell) + FVector(0.5f)) * CellSize;
+}
+
+void UPushPuzzleGridSubsystem::OccupyCells(APushableActor* Block, const FBlockCells& BlockCells)
+{
+	for (int32 X = 0; X < BlockCells.Size; X++)
+	{
+		for (int32 Y = 0; Y < BlockCells.Size; Y++)
+		{
+			for (int32 Z = 0; Z < BlockCells.Size; Z++)
+			{
+				OccupiedCells.Add(BlockCells.MinCell + FIntVector(X, Y, Z), Block);
+			}
+		}
+	}
+}
+
+void UPushPuzzleGridSubsystem::ReleaseCells(const APushableActor* Block, const FBlockCells& BlockCells)
+{
+	for (int32 X = 0; X < BlockCells.Size; X++)
+	{
+		for (int32 Y = 0; Y < BlockCells.Size; Y++)
+		{
+			for (int32 Z = 0; Z < BlockCells.Size; Z++)
+			{
+				const FIntVector Cell = BlockCells.MinCell + FIntVector(X, Y, Z);
+				const TWeakObjectPtr<APushableActor>* Occupant = OccupiedCells.Find(Cell);
+				if (Occupant && Occupant->Get() == Block)
+				{
+					OccupiedCells.Remove(Cell);
+				}
+			}
+		}
+	}
+}
+
+bool UPushPuzzleGridSubsystem::IsOccupiedByOtherBlock(const FIntVector& Cell, const APushableActor* Block) const
+{
+	const TWeakObjectPtr<APushableActor>* Occupant = OccupiedCells.Find(Cell);
+	return Occupant && Occupant->IsValid() && Occupant->Get() != Block;
+}
+
+namespace
+{
+	// Object type queries report every component of the type, overlap-only volumes included. Only what would
+	// stop a moving block counts
+	bool BlocksPushedBlock(const UPrimitiveComponent* Component)
+	{
+		return Component && Component->GetCollisionResponseToChannel(ECC_WorldDynamic) == ECR_Block;
+	}
+}
+
+bool UPushPuzzleGridSubsystem::IsBlockedByLevelGeometry(const FIntVector& Cell)
+{
+	uint8& StaticCell = StaticCells.FindOrAdd(Cell);
+	if (!(StaticCell & static_cast<uint8>(EStaticCell::BlockedTraced)))
+	{
+		StaticCell |= static_cast<uint8>(EStaticCell::BlockedTraced);
+		bool IsBlocked = false;
+		GetWorld()->GetSubsystem<UOsuTraceServiceSubsystem>()->OverlapMultiByObjectType(
+			EOsuTraceLatency::Immediate, GetCellCenter(Cell), FCollisionObjectQueryParams(ECC_WorldStatic),
+			FCollisionShape::MakeBox(FVector(CellSize * 0.45f)), BakeQueryParams,
+			FOsuOverlapResultDelegate::CreateLambda([&IsBlocked](const TArray<FOverlapResult>& Overlaps)
+			{
+				IsBlocked = Overlaps.ContainsByPredicate([](const FOverlapResult& Overlap)
+				{
+					return BlocksPushedBlock(Overlap.GetComponent());
+				});
+			}));
+		StaticCell |= IsBlocked ? static_cast<uint8>(EStaticCell::Blocked) : 0;
+	}
+	return StaticCell & static_cast<uint8>(EStaticCell::Blocked);
+}
+
+bool UPushPuzzleGridSubsystem::HasFloor(const FIntVector& Cell)
+{
+	uint8& StaticCell = StaticCells.FindOrAdd(Cell);
+	if (!(StaticCell & static_cast<uint8>(EStaticCell::FloorTraced))
+		|| StaticCell & static_cast<uint8>(EStaticCell::MovableFloor))
+	{
+		TraceFloor(Cell, StaticCell);
+	}
+	return StaticCell & static_cast<uint8>(EStaticCell::Floored);
+}
+
+void UPushPuzzleGridSubsystem::TraceFloor(const FIntVector& Cell, uint8& StaticCell)
+{
+	const FVector Center = GetCellCenter(Cell);
+	const FVector FloorTraceStart = Center - FVector(0.0f, 0.0f, CellSize * 0.4f);
+	const FVector FloorTraceEnd = Center - FVector(0.0f, 0.0f, CellSize);
+	FCollisionObjectQueryParams FloorObjects(ECC_WorldStatic);
+	FloorObjects.AddObjectTypesToQuery(ECC_WorldDynamic);
+	GetWorld()->GetSubsystem<UOsuTraceServiceSubsystem>()->LineTraceMultiByObjectType(
+		FloorHits, FloorTraceStart, FloorTraceEnd, FloorObjects, BakeQueryParams);
+
+	// A lift found here once keeps the cell re-traced, even after it moved away
+	StaticCell |= static_cast<uint8>(EStaticCell::FloorTraced);
+	StaticCell &= ~static_cast<uint8>(EStaticCell::Floored);
+	for (const FHitResult& Hit : FloorHits)
+	{
+		const UPrimitiveComponent* Component = Hit.GetComponent();
+		if (BlocksPushedBlock(Component))
+		{
+			StaticCell |= static_cast<uint8>(EStaticCell::Floored);
+			if (Component->Mobility != EComponentMobility::Static)
+			{
+				StaticCell |= static_cast<uint8>(EStaticCell::MovableFloor);
+			}
+			break;
+		}
+	}
+}
+
+void UPushPuzzleGridSubsystem::RefreshBakeQueryParams()
+{
+	BakeQueryParams = FCollisionQueryParams(SCENE_QUERY_STAT(PushPuzzleGridBake));
+	for (const TPair<TObjectKey<APushableActor>, FBlockCells>& Block : Blocks)
+	{
+		BakeQueryParams.AddIgnoredActor(Block.Key.ResolveObjectPtr());
+	}
+}
@@ -0,0 +1,78 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "PushPuzzleGridSubsystem.generated.h"
+
+class APushableActor;
+
+/**
+ * Occupancy grid of the pushable block puzzles. Cells are one push step wide, a block covers a cube of cells.
+ * Whether a cell is blocked by static level geometry and whether it has a floor are each traced once, the first
+ * time they are asked for. Only a cell whose floor was found on a movable object, such as a lift, is traced again
+ * on every ask. Which cells the blocks cover is kept up to date as they move. Pushes are checked against the grid,
+ * only pawns and movable objects still need a query.
+ */
+UCLASS()
+class THEPATHOFOSU_API UPushPuzzleGridSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// The first block sets the cell size and grid origin, the others are reported when they do not line up with it
+	void RegisterBlock(APushableActor* Block, float BlockSize, float StepSize);
+	void UnregisterBlock(APushableActor* Block);
+
+	// Moves the cells the block covers, to its destination as soon as a push starts so no other block can take it
+	void SetBlockLocation(APushableActor* Block, const FVector& Location);
+
+	// Floor under, free level geometry and no block in the cells entered by one step along Direction,
+	// and no block stacked on top
+	bool CanMoveBlock(const APushableActor* Block, const FIntPoint& Direction);
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	enum class EStaticCell : uint8
+	{
+		BlockedTraced = 1 << 0,
+		Blocked = 1 << 1,
+		FloorTraced = 1 << 2,
+		Floored = 1 << 3,
+		MovableFloor = 1 << 4,
+	};
+
+	struct FBlockCells
+	{
+		FIntVector MinCell;
+		// Cells along each side
+		int32 Size;
+	};
+
+	FIntVector GetMinCell(const FVector& BlockLocation, int32 BlockCellCount) const;
+	FVector GetCellCenter(const FIntVector& Cell) const;
+
+	void OccupyCells(APushableActor* Block, const FBlockCells& BlockCells);
+	void ReleaseCells(const APushableActor* Block, const FBlockCells& BlockCells);
+	bool IsOccupiedByOtherBlock(const FIntVector& Cell, const APushableActor* Block) const;
+
+	// Traced on first use, blocks are left out so only level geometry is baked
+	bool IsBlockedByLevelGeometry(const FIntVector& Cell);
+	bool HasFloor(const FIntVector& Cell);
+	void TraceFloor(const FIntVector& Cell, uint8& StaticCell);
+	void RefreshBakeQueryParams();
+
+	float CellSize = 0.0f;
+	FVector GridOrigin;
+
+	TMap<TObjectKey<APushableActor>, FBlockCells> Blocks;
+	TMap<FIntVector, TWeakObjectPtr<APushableActor>> OccupiedCells;
+	TMap<FIntVector, uint8> StaticCells;
+
+	// Ignores every block, rebuilt when one registers or leaves
+	FCollisionQueryParams BakeQueryParams;
+	TArray<FHitResult> FloorHits;
+};
@@ -3,7 +3,9 @@
 
 #include "PushableActor.h"
 
+#include "OsuTraceServiceSubsystem.h"
 #include "PlayerCharacter.h"
+#include "PushPuzzleGridSubsystem.h"
 #include "GameFramework/PawnMovementComponent.h"
 #include "Kismet/KismetMathLibrary.h"
 
@@ -27,6 +29,21 @@ void APushableActor::BeginPlay()
 	SetupTimeline();
 	BoxSize = Mesh->GetRelativeLocation().Z * 2.0f;
 	TravelDistance = BoxSize / 2.0f;
+	if (UPushPuzzleGridSubsystem* PuzzleGrid = GetWorld()->GetSubsystem<UPushPuzzleGridSubsystem>())
+	{
+		PuzzleGrid->RegisterBlock(this, BoxSize, TravelDistance);
+	}
+}
+
+void APushableActor::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UPushPuzzleGridSubsystem* PuzzleGrid = GetWorld()->GetSubsystem<UPushPuzzleGridSubsystem>())
+	{
+		PuzzleGrid->UnregisterBlock(this);
+	}
+	// The push waits on the timeline, which stops ticking with this actor and would never wake it
+	PushTask.Cancel();
+	Super::EndPlay(EndPlayReason);
 }
 
 void APushableActor::SetupTimeline()
@@ -37,8 +54,6 @@ void APushableActor::SetupTimeline()
 		TimelineProgress.BindUFunction(this, FName("TimelineProgress"));
 		CurveTimeline.AddInterpFloat(CurveFloat, TimelineProgress);
 		CurveTimeline.SetLooping(false);
-		TimelineFinishedEvent.BindUFunction(this, FName("TimelineFinished"));
-		CurveTimeline.SetTimelineFinishedFunc(TimelineFinishedEvent);
 	}
 }
 
@@ -48,9 +63,35 @@ void APushableActor::Tick(float DeltaTime)
 	CurveTimeline.TickTimeline(DeltaTime);
 }
 
+void APushableActor::SerializeState(FArchive& Ar)
+{
+	// A box caught mid push is saved on the cell it started from
+	FVector Location = IsBeingPushed ? PushingStartLocation : GetActorLocation();
+	Ar << Location;
+	if (Ar.IsLoading())
+	{
+		if (IsBeingPushed)
+		{
+			CurveTimeline.Stop();
+			StopPushing(true);
+		}
+		SetActorLocation(Location);
+		if (UPushPuzzleGridSubsystem* PuzzleGrid = GetWorld()->GetSubsystem<UPushPuzzleGridSubsystem>())
+		{
+			PuzzleGrid->SetBlockLocation(this, Location);
+		}
+	}
+}
+
 void APushableActor::OnHit(UPrimitiveComponent* HitComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp,
                            FVector NormalImpulse, const FHitResult& Hit)
 {
+	// Fires on every contact while the player leans on the block, a step already under way decides for itself
+	// whether to continue once it finishes
+	if (CurveTimeline.IsPlaying() || !Cast<APlayerCharacter>(OtherActor))
+	{
+		return;
+	}
 	FVector PushingActorForwardVector = OtherActor->GetActorForwardVector();
 	PushingDirection = FVector(UKismetMathLibrary::Round(PushingActorForwardVector.X),
 	                           UKismetMathLibrary::Round(PushingActorForwardVector.Y), 0.0f);
@@ -99,82 +140,82 @@ bool APushableActor::IsPushingDiagonal(FVector PushingActorForwardVector, FVecto
 
 bool APushableActor::CanPush(AActor* PushingActor)
 {
-	FVector PushingActorLocation = PushingActor->GetActorLocation();
-	FVector PushingActorForwardVector = PushingActor->GetActorForwardVector();
-	FVector PushingActorTraceEndLocation = PushingActorLocation + PushingActorForwardVector * 100.0f;
-	FHitResult PushingActorTraceHitResult;
-	FCollisionQueryParams PushingActorTraceCollisionParams;
-	PushingActorTraceCollisionParams.AddIgnoredActor(PushingActor);
-	GetWorld()->LineTraceSingleByChannel(PushingActorTraceHitResult, PushingActorLocation, PushingActorTraceEndLocation,
-	                                     ECC_Visibility,
-	                                     PushingActorTraceCollisionParams);
-	bool IsPushingActorFacingToThisActor = PushingActorTraceHitResult.bBlockingHit &&
-		PushingActorTraceHitResult.GetActor() == this;
-
-	FHitResult SelfTraceHitResult;
-	TArray<AActor*> IgnoredActors;
-	IgnoredActors.Add(this);
-	IgnoredActors.Add(PushingPlayerCharacter);
-	FBoxSphereBounds BoxSphereBounds3d = Mesh->GetStaticMesh()->GetBounds();
-	FVector BoxExtent = BoxSphereBounds3d.BoxExtent;
-	FVector HalfSize = Mesh->GetRelativeScale3D() * BoxExtent * 0.9f;
-	FVector ZOffset = FVector(0.0f, 0.0f, BoxSize / 2);
-	FVector SelfTraceStartLocation = GetActorLocation() + ZOffset;
-	FVector SelfTraceEndLocation = GetActorLocation() + PushingDirection * TravelDistance + ZOffset;
-	UKismetSystemLibrary::BoxTraceSingle(GetWorld(), SelfTraceStartLocation, SelfTraceEndLocation, HalfSize,
-	                                     FRotator::ZeroRotator,
-	                                     UEngineTypes::ConvertToTraceType(ECC_Visibility), false, IgnoredActors,
-	                                     EDrawDebugTrace::None, SelfTraceHitResult, true, FLinearColor::Red,
-	                                     FLinearColor::Green, 5.0f);
-	bool IsPathClear = !SelfTraceHitResult.bBlockingHit;
-
-	FCollisionQueryParams ForwardDownTraceCollisionParams;
-	PushingActorTraceCollisionParams.AddIgnoredActor(this);
-	FHitResult ForwardDownTraceHitResult;
-	FVector ForwardDownTraceStartLocation = GetActorLocation() + PushingDirection * (BoxSize / 2.0f) * 1.5f + ZOffset;
-	FVector ForwardDownTraceEndLocation = ForwardDownTraceStartLocation + FVector(0.0f, 0.0f, -BoxSize);
-	GetWorld()->LineTraceSingleByChannel(ForwardDownTraceHitResult, ForwardDownTraceStartLocation,
-	                                     ForwardDownTraceEndLocation, ECC_Visibility, ForwardDownTraceCollisionParams);
-	bool HasGroundForward = ForwardDownTraceHitResult.bBlockingHit;
-
-
-	FCollisionQueryParams UpTraceCollisionParams;
-	UpTraceCollisionParams.AddIgnoredActor(this);
-	FHitResult UpTraceHitResult;
-	FVector UpTraceStartLocation = GetActorLocation() + FVector(0.0f, 0.0f, BoxSize);;
-	FVector UpTraceEndLocation = GetActorLocation() + FVector(0.0f, 0.0f, BoxSize * 2.0f);
-	GetWorld()->LineTraceSingleByChannel(UpTraceHitResult, UpTraceStartLocation, UpTraceEndLocation, ECC_Visibility,
-	                                     UpTraceCollisionParams);
-	bool IsAboveClear = !UpTraceHitResult.bBlockingHit;
-
 	UPawnMovementComponent* MovementComponent = PushingPlayerCharacter->GetMovementComponent();
 	if (!MovementComponent)
 	{
 		UE_LOG(LogTemp, Error, TEXT("MovementComponent is null!"));
 		return false;
 	}
+	if (MovementComponent->IsFalling())
+	{
+		return false;
+	}
 
-	bool IsPushingActorFalling = MovementComponent->IsFalling();
+	// OnHit already checked the pusher faces the block head on, it only has to stand behind it
+	const FVector PushingActorToThisActor = GetActorLocation() - PushingActor->GetActorLocation();
+	if (FVector::DotProduct(PushingActorToThisActor, PushingDirection) <= 0.0f)
+	{
+		return false;
+	}
 
+	UPushPuzzleGridSubsystem* PuzzleGrid = GetWorld()->GetSubsystem<UPushPuzzleGridSubsystem>();
+	const FIntPoint GridDirection(FMath::RoundToInt(PushingDirection.X), FMath::RoundToInt(PushingDirection.Y));
+	if (!PuzzleGrid || !PuzzleGrid->CanMoveBlock(this, GridDirection))
+	{
+		return false;
+	}
+	return !IsBlockedByDynamicObstacle(PushingActor);
+}
 
-	// GEngine->AddOnScreenDebugMessage(-1, 15.0f, FColor::White,
-	//                                  FString::Printf(
-	// 	                                 TEXT("IsPushingActorFacingToThisActor: %d"), IsPushingActorFacingToThisActor));
-	// GEngine->AddOnScreenDebugMessage(-1, 15.0f, FColor::White, FString::Printf(TEXT("IsPathClear: %d"), IsPathClear));
-	// GEngine->AddOnScreenDebugMessage(-1, 15.0f, FColor::White,
-	//                                  FString::Printf(TEXT("HasGroundForward: %d"), HasGroundForward));
-	// GEngine->AddOnScreenDebugMessage(-1, 15.0f, FColor::White, FString::Printf(TEXT("IsAboveClear: %d"), IsAboveClear));
-	// GEngine->AddOnScreenDebugMessage(-1, 15.0f, FColor::White,
-	//                                  FString::Printf(TEXT("IsPushingActorFalling: %d"), IsPushingActorFalling));
+bool APushableActor::IsBlockedByDynamicObstacle(const AActor* PushingActor) const
+{
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(PushableDynamicObstacle));
+	QueryParams.AddIgnoredActor(this);
+	QueryParams.AddIgnoredActor(PushingActor);
+
+	const FVector HalfSize = Mesh->GetRelativeScale3D() * Mesh->GetStaticMesh()->GetBounds().BoxExtent * 0.9f;
+	const FVector Destination = GetActorLocation() + PushingDirection * TravelDistance
+		+ FVector(0.0f, 0.0f, BoxSize / 2.0f);
+	// Queried as the moving block would collide, so pawns and physics bodies stop it but checkpoint volumes,
+	// collectables and other overlap-only triggers do not
+	return GetWorld()->GetSubsystem<UOsuTraceServiceSubsystem>()->OverlapBlockingTestByChannel(
+		Destination, ECC_WorldDynamic, FCollisionShape::MakeBox(HalfSize), QueryParams);
+}
 
+void APushableActor::Push()
+{
+	PushTask.Cancel();
+	PushTask = PushSequence();
+}
 
-	return IsPushingActorFacingToThisActor && IsPathClear && HasGroundForward && IsAboveClear && !IsPushingActorFalling;
+FOsuLatentTask APushableActor::PushSequence()
+{
+	do
+	{
+		StartPushStep();
+		co_await FOsuLatentTimelineFinished{CurveTimeline};
+		if (!PushingPlayerCharacter)
+		{
+			UE_LOG(LogTemp, Error, TEXT("PushSequence PushingPlayerCharacter is null!, %s"), *GetName());
+			GEngine->AddOnScreenDebugMessage(-1, 15.0f, FColor::Red,
+			                                 FString::Printf(
+				                                 TEXT("PushSequence PushingPlayerCharacter is null!, %s"),
+				                                 *GetName()));
+			co_return;
+		}
+	}
+	while (PushingPlayerCharacter->IsMoveInputBeingPressed() && CanPush(PushingPlayerCharacter));
+	StopPushing(false);
 }
 
-void APushableActor::Push()
+void APushableActor::StartPushStep()
 {
 	IsBeingPushed = true;
 	PushingStartLocation = GetActorLocation();
+	if (UPushPuzzleGridSubsystem* PuzzleGrid = GetWorld()->GetSubsystem<UPushPuzzleGridSubsystem>())
+	{
+		PuzzleGrid->SetBlockLocation(this, PushingStartLocation + PushingDirection * TravelDistance);
+	}
 	CurveTimeline.PlayFromStart();
 }
 
@@ -186,6 +227,10 @@ void APushableActor::StopPushing(bool IsInterrupt)
 		return;
 	}
 
+	if (IsInterrupt)
+	{
+		PushTask.Cancel();
+	}
 	IsBeingPushed = false;
 	PushingPlayerCharacter->OnBeginPush.RemoveDynamic(this, &APushableActor::Push);
 	PushingPlayerCharacter->EndPush();
@@ -214,23 +259,3 @@ void APushableActor::TimelineProgress(float Value)
 	FVector TargetLocation = PushingStartLocation + PushingDirection * TravelDistance * Value;
 	SetActorRelativeLocation(TargetLocation);
 }
-
-void APushableActor::TimelineFinished()
-{
-	if (!PushingPlayerCharacter)
-	{
-		UE_LOG(LogTemp, Error, TEXT("TimelineFinished PushingPlayerCharacter is null!, %s"), *GetName());
-		GEngine->AddOnScreenDebugMessage(-1, 15.0f, FColor::Red,
-		                                 FString::Printf(
-			                                 TEXT("TimelineFinished PushingPlayerCharacter is null!, %s"), *GetName()));
-		return;
-	}
-	if (PushingPlayerCharacter->IsMoveInputBeingPressed() && CanPush(PushingPlayerCharacter))
-	{
-		Push();
-	}
-	else
-	{
-		StopPushing(false);
-	}
-}
@@ -3,9 +3,11 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "OsuLatentTask.h"
 #include "PlayerCharacter.h"
 #include "Components/TimelineComponent.h"
 #include "GameFramework/Actor.h"
+#include "Interface/SaveableInterface.h"
 #include "PushableActor.generated.h"
 
 class UCurveFloat;
@@ -13,7 +15,7 @@ class UCurveFloat;
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FPushableActorOnPushFinished);
 
 UCLASS()
-class THEPATHOFOSU_API APushableActor : public AActor
+class THEPATHOFOSU_API APushableActor : public AActor, public ISaveableInterface
 {
 	GENERATED_BODY()
 
@@ -24,6 +26,7 @@ public:
 protected:
 	
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	
 	UFUNCTION()
 	void OnHit(UPrimitiveComponent* HitComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit);
@@ -56,10 +59,9 @@ protected:
 
 	FVector PushingStartLocation;
 
-	FOnTimelineEvent TimelineFinishedEvent;
-
 public:
 	virtual void Tick(float DeltaTime) override;
+	virtual void SerializeState(FArchive& Ar) override;
 	
 	UPROPERTY(BlueprintReadWrite, VisibleAnywhere)
 	USceneComponent* RootComp;
@@ -70,9 +72,6 @@ public:
 	UFUNCTION()
 	void TimelineProgress(float Value);
 
-	UFUNCTION()
-	void TimelineFinished();
-
 	UPROPERTY(BlueprintReadOnly, VisibleAnywhere)
 	bool IsBeingPushed;
 
@@ -82,6 +81,14 @@ public:
 private:
 	bool IsPushingDiagonal(FVector PushingActorForwardVector, FVector HitNormal, double StraightDirectionTolerance = 0.95f);
 
+	// Level geometry and other blocks are checked on the puzzle grid, this queries what the grid does not track
+	bool IsBlockedByDynamicObstacle(const AActor* PushingActor) const;
+
+	// Moves one grid step per timeline run, for as long as the player keeps pushing
+	FOsuLatentTask PushSequence();
+	void StartPushStep();
+	FOsuLatentTask PushTask;
+
 	float BoxSize;
 	
 	
@@ -0,0 +1,43 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "StreamingPreloadSource.h"
+
+#include "Components/WorldPartitionStreamingSourceComponent.h"
+
+
+AStreamingPreloadSource::AStreamingPreloadSource()
+{
+	PrimaryActorTick.bCanEverTick = false;
+
+	RootComp = CreateDefaultSubobject<USceneComponent>(TEXT("RootComp"));
+	SetRootComponent(RootComp);
+	StreamingSource = CreateDefaultSubobject<UWorldPartitionStreamingSourceComponent>(TEXT("StreamingSource"));
+	StreamingSource->Priority = EStreamingSourcePriority::High;
+	StreamingSource->DisableStreamingSource();
+}
+
+void AStreamingPreloadSource::Activate(const FVector& Location, float Duration)
+{
+	SetActorLocation(Location);
+	StreamingSource->EnableStreamingSource();
+	GetWorld()->GetSubsystem<UOsuSchedulerSubsystem>()->ScheduleOnce(
+		ExpireJob, TEXT("StreamingPreloadExpire"), Duration,
+		FSimpleDelegate::CreateUObject(this, &AStreamingPreloadSource::Deactivate));
+}
+
+void AStreamingPreloadSource::Deactivate()
+{
+	GetWorld()->GetSubsystem<UOsuSchedulerSubsystem>()->Cancel(ExpireJob);
+	StreamingSource->DisableStreamingSource();
+}
+
+bool AStreamingPreloadSource::IsActive() const
+{
+	return StreamingSource->IsStreamingSourceEnabled();
+}
+
+bool AStreamingPreloadSource::IsStreamingCompleted() const
+{
+	return StreamingSource->IsStreamingCompleted();
+}
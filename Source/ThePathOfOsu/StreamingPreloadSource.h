@@ -0,0 +1,35 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OsuSchedulerSubsystem.h"
+#include "GameFramework/Actor.h"
+#include "StreamingPreloadSource.generated.h"
+
+class UWorldPartitionStreamingSourceComponent;
+
+// High priority World Partition streaming source, pooled and moved around by UStreamingPreloadSubsystem
+UCLASS(NotPlaceable, Transient)
+class THEPATHOFOSU_API AStreamingPreloadSource : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	AStreamingPreloadSource();
+
+	void Activate(const FVector& Location, float Duration);
+	void Deactivate();
+
+	bool IsActive() const;
+	bool IsStreamingCompleted() const;
+
+private:
+	UPROPERTY(VisibleAnywhere)
+	USceneComponent* RootComp;
+
+	UPROPERTY(VisibleAnywhere)
+	UWorldPartitionStreamingSourceComponent* StreamingSource;
+
+	FOsuJobHandle ExpireJob;
+};
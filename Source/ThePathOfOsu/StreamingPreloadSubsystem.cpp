@@ -0,0 +1,64 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "StreamingPreloadSubsystem.h"
+
+#include "StreamingPreloadSource.h"
+
+void UStreamingPreloadSubsystem::RequestPreload(const FVector& Location, float Duration)
+{
+	UWorld* World = GetWorld();
+	if (!World || !World->GetWorldPartition() || Duration <= 0.0f)
+	{
+		return;
+	}
+
+	AStreamingPreloadSource* Source = FindActiveSource(Location);
+	if (!Source)
+	{
+		AStreamingPreloadSource** InactiveSource = Sources.FindByPredicate([](const AStreamingPreloadSource* Candidate)
+		{
+			return IsValid(Candidate) && !Candidate->IsActive();
+		});
+		Source = InactiveSource ? *InactiveSource : nullptr;
+	}
+	if (!Source)
+	{
+		FActorSpawnParameters SpawnParameters;
+		SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		SpawnParameters.ObjectFlags |= RF_Transient;
+		Source = World->SpawnActor<AStreamingPreloadSource>(Location, FRotator::ZeroRotator, SpawnParameters);
+		if (!Source)
+		{
+			UE_LOG(LogTemp, Error, TEXT("Failed to spawn StreamingPreloadSource"));
+			return;
+		}
+		Sources.Add(Source);
+	}
+	Source->Activate(Location, Duration);
+}
+
+bool UStreamingPreloadSubsystem::IsPreloadCompleted(const FVector& Location) const
+{
+	const AStreamingPreloadSource* Source = FindActiveSource(Location);
+	return !Source || Source->IsStreamingCompleted();
+}
+
+bool UStreamingPreloadSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+AStreamingPreloadSource* UStreamingPreloadSubsystem::FindActiveSource(const FVector& Location) const
+{
+	const float MergeDistanceSquared = FMath::Square(MergeDistance);
+	for (AStreamingPreloadSource* Source : Sources)
+	{
+		if (IsValid(Source) && Source->IsActive()
+			&& FVector::DistSquared(Source->GetActorLocation(), Location) <= MergeDistanceSquared)
+		{
+			return Source;
+		}
+	}
+	return nullptr;
+}
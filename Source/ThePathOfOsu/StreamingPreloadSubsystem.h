@@ -0,0 +1,39 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "StreamingPreloadSubsystem.generated.h"
+
+class AStreamingPreloadSource;
+
+/**
+ * Streams World Partition cells in ahead of the player, e.g. at a lift's destination as soon as it starts moving.
+ * Each request enables a pooled high priority streaming source at the location for a limited time.
+ * Does nothing on maps without World Partition.
+ */
+UCLASS()
+class THEPATHOFOSU_API UStreamingPreloadSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// A request near an active preload restarts that one instead of adding another source
+	UFUNCTION(BlueprintCallable, Category = "Streaming")
+	void RequestPreload(const FVector& Location, float Duration = 10.0f);
+
+	UFUNCTION(BlueprintPure, Category = "Streaming")
+	bool IsPreloadCompleted(const FVector& Location) const;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	static constexpr float MergeDistance = 1000.0f;
+
+	AStreamingPreloadSource* FindActiveSource(const FVector& Location) const;
+
+	UPROPERTY()
+	TArray<AStreamingPreloadSource*> Sources;
+};
@@ -2,6 +2,7 @@
 
 #include "ThePathOfOsuGameMode.h"
 #include "ThePathOfOsuCharacter.h"
+#include "OsuHUD.h"
 #include "UObject/ConstructorHelpers.h"
 
 AThePathOfOsuGameMode::AThePathOfOsuGameMode()
@@ -13,4 +14,5 @@ AThePathOfOsuGameMode::AThePathOfOsuGameMode()
 	{
 		DefaultPawnClass = PlayerPawnBPClass.Class;
 	}
+	HUDClass = AOsuHUD::StaticClass();
 }
@@ -1,10 +1,12 @@
 #include "Transporter.h"
 
-#include "PressableButton.h"
+#include "KinematicMoverSubsystem.h"
+#include "OsuEventBusSubsystem.h"
+#include "StreamingPreloadSubsystem.h"
 
 UTransporter::UTransporter()
 {
-	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bCanEverTick = false;
 
 	MoveTime = 3.0f;
 	ArePointsSet = false;
@@ -21,88 +23,157 @@ void UTransporter::BeginPlay()
 		ForwardTriggerActor = GetOwner();
 	}
 
-	if (!ForwardTriggerActor)
+	if (!ForwardTriggerActor && !IsDrivenByLogicGraph)
 	{
 		GEngine->AddOnScreenDebugMessage(-1, 15.0f, FColor::Red,
 		                                 FString::Printf(TEXT("TriggerActor is null! %s"), *GetOwner()->GetName()));
 		return;
 	}
-	if (APressableButton* PressableButton = Cast<APressableButton>(ForwardTriggerActor))
+	// Any actor publishing logic signals can trigger the move, not only buttons
+	UOsuEventBusSubsystem* EventBus = GetWorld()->GetSubsystem<UOsuEventBusSubsystem>();
+	if (!EventBus)
 	{
-		PressableButton->OnActivated.AddDynamic(this, &UTransporter::OnButtonActivated);
-		PressableButton->OnDeactivated.AddDynamic(this, &UTransporter::OnButtonDeactivated);
+		return;
 	}
-	else
+	if (ForwardTriggerActor)
 	{
-		GEngine->AddOnScreenDebugMessage(-1, 15.0f, FColor::Red,
-		                                 FString::Printf(TEXT("TriggerActor is not a PressableButton!")));
-		return;
+		ForwardTriggerHandle = EventBus->Subscribe(this, &UTransporter::OnTriggerSignal, ForwardTriggerActor);
 	}
-
 	if (BackwardTriggerActor)
 	{
-		if (APressableButton* PressableButton = Cast<APressableButton>(BackwardTriggerActor))
-		{
-			PressableButton->OnActivated.AddDynamic(this, &UTransporter::OnBackwardButtonActivated);
-			PressableButton->OnDeactivated.AddDynamic(this, &UTransporter::OnButtonDeactivated);
-		}
-		else
-		{
-			GEngine->AddOnScreenDebugMessage(-1, 15.0f, FColor::Red,
-			                                 FString::Printf(TEXT("TriggerActor is not a PressableButton!")));
-			return;
-		}
+		BackwardTriggerHandle = EventBus->Subscribe(this, &UTransporter::OnTriggerSignal, BackwardTriggerActor);
 	}
 }
 
+void UTransporter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UOsuEventBusSubsystem* EventBus = GetWorld()->GetSubsystem<UOsuEventBusSubsystem>())
+	{
+		EventBus->Unsubscribe<FLogicSignalEvent>(ForwardTriggerHandle);
+		EventBus->Unsubscribe<FLogicSignalEvent>(BackwardTriggerHandle);
+	}
+	Super::EndPlay(EndPlayReason);
+}
 
-void UTransporter::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+void UTransporter::OnTriggerSignal(const FLogicSignalEvent& Event)
 {
-	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
-	AActor* MyOwner = GetOwner();
-	if (MyOwner && ArePointsSet)
+	if (!Event.Value)
 	{
-		FVector CurrentLocation = MyOwner->GetActorLocation();
-		FVector TargetLocation;
-		if (IsGoingBackward)
-		{
-			TargetLocation = IsTriggered ? StartPoint : EndPoint;
-		}
-		else
+		if (StopsOnTriggerRelease)
 		{
-			TargetLocation = IsTriggered ? EndPoint : StartPoint;
-		}
-		if (IsTriggered && !CurrentLocation.Equals(TargetLocation))
-		{
-			FVector NewLocation = FMath::VInterpConstantTo(CurrentLocation, TargetLocation, DeltaTime, Speed);
-			MyOwner->SetActorLocation(NewLocation);
+			OnButtonDeactivated();
 		}
 	}
+	else if (BackwardTriggerActor && Event.Source == BackwardTriggerActor)
+	{
+		OnBackwardButtonActivated();
+	}
+	else
+	{
+		OnButtonActivated();
+	}
 }
 
+
 void UTransporter::OnButtonActivated()
 {
 	IsGoingBackward = false;
 	IsTriggered = true;
+	MoveOwnerTo(EndPoint);
+	PreloadDestination(EndPoint);
 }
 
 void UTransporter::OnBackwardButtonActivated()
 {
 	IsGoingBackward = true;
 	IsTriggered = true;
+	MoveOwnerTo(StartPoint);
+	PreloadDestination(StartPoint);
+}
+
+void UTransporter::MoveOwnerTo(const FVector& Destination)
+{
+	USceneComponent* OwnerRoot = GetOwner()->GetRootComponent();
+	if (!ArePointsSet || !OwnerRoot)
+	{
+		return;
+	}
+	const float Distance = FVector::Distance(OwnerRoot->GetComponentLocation(), Destination);
+	if (FMath::IsNearlyZero(Distance))
+	{
+		return;
+	}
+	// The mover works in relative space, the points are in world space
+	const USceneComponent* AttachParent = OwnerRoot->GetAttachParent();
+	const FVector RelativeDestination = AttachParent
+		                                    ? AttachParent->GetComponentTransform().InverseTransformPosition(Destination)
+		                                    : Destination;
+	GetWorld()->GetSubsystem<UKinematicMoverSubsystem>()->StartMove(
+		OwnerRoot, RelativeDestination, OwnerRoot->GetRelativeRotation(), Distance / Speed, Easing);
+}
+
+void UTransporter::StopOwner()
+{
+	if (UKinematicMoverSubsystem* KinematicMover = GetWorld()->GetSubsystem<UKinematicMoverSubsystem>())
+	{
+		KinematicMover->StopMove(GetOwner()->GetRootComponent());
+	}
+}
+
+void UTransporter::PreloadDestination(const FVector& Destination) const
+{
+	if (!PreloadsDestination || !ArePointsSet)
+	{
+		return;
+	}
+	if (UStreamingPreloadSubsystem* StreamingPreload = GetWorld()->GetSubsystem<UStreamingPreloadSubsystem>())
+	{
+		StreamingPreload->RequestPreload(Destination, PreloadDuration);
+	}
 }
 
 void UTransporter::OnButtonDeactivated()
 {
 	IsTriggered = false;
+	StopOwner();
+}
+
+void UTransporter::ReceiveLogicSignal(bool Value)
+{
+	if (Value)
+	{
+		OnButtonActivated();
+	}
+	else
+	{
+		OnBackwardButtonActivated();
+	}
 }
 
 void UTransporter::Reset()
 {
 	IsTriggered = false;
+	StopOwner();
 	GetOwner()->SetActorLocation(StartPoint);
 }
 
+void UTransporter::SerializeState(FArchive& Ar)
+{
+	Ar << IsTriggered;
+	Ar << IsGoingBackward;
+	FVector OwnerLocation = GetOwner()->GetActorLocation();
+	Ar << OwnerLocation;
+	if (Ar.IsLoading())
+	{
+		StopOwner();
+		GetOwner()->SetActorLocation(OwnerLocation);
+		if (IsTriggered)
+		{
+			MoveOwnerTo(IsGoingBackward ? StartPoint : EndPoint);
+		}
+	}
+}
+
 void UTransporter::SetPoints(FVector ToSetStartPoint, FVector ToSetEndPoint)
 {
 	if (ToSetStartPoint.Equals(ToSetEndPoint))
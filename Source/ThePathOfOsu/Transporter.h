@@ -3,12 +3,17 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "OsuGameplayEvents.h"
 #include "Components/ActorComponent.h"
+#include "Interface/LogicSignalReceiver.h"
+#include "Interface/SaveableInterface.h"
+#include "Kismet/KismetMathLibrary.h"
 #include "Transporter.generated.h"
 
 
 UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
-class THEPATHOFOSU_API UTransporter : public UActorComponent
+class THEPATHOFOSU_API UTransporter : public UActorComponent, public ISaveableInterface,
+                                      public ILogicSignalReceiver
 {
 	GENERATED_BODY()
 
@@ -17,10 +22,9 @@ public:
 
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 public:	
-	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
-
 	UFUNCTION()
 	void OnButtonActivated();
 	
@@ -32,6 +36,11 @@ public:
 
 	void Reset();
 
+	virtual void SerializeState(FArchive& Ar) override;
+
+	// Driven by an ALevelLogicGraph sink, on goes to the end point and off back to the start point
+	virtual void ReceiveLogicSignal(bool Value) override;
+
 	FVector StartPoint;
 	FVector EndPoint;
 	bool ArePointsSet;
@@ -45,6 +54,25 @@ public:
 	AActor* BackwardTriggerActor;
 	UPROPERTY(VisibleAnywhere)
 	bool IsTriggered;
+
+	// Stops the move where it is once a trigger switches off again, such as a toggleable button popping back up
+	UPROPERTY(EditAnywhere)
+	bool StopsOnTriggerRelease = false;
+
+	// Moved by an ALevelLogicGraph sink instead of trigger actors
+	UPROPERTY(EditAnywhere)
+	bool IsDrivenByLogicGraph = false;
+
+	// Applied to each leg of the move, a move resumed after its button was released eases again from there
+	UPROPERTY(EditAnywhere)
+	TEnumAsByte<EEasingFunc::Type> Easing = EEasingFunc::Linear;
+
+	// Streams in the destination as soon as the move starts, off for short moves like a button press
+	UPROPERTY(EditAnywhere, Category = "Streaming")
+	bool PreloadsDestination = true;
+
+	UPROPERTY(EditAnywhere, Category = "Streaming", meta = (EditCondition = "PreloadsDestination"))
+	float PreloadDuration = 15.0f;
 	
 	bool IsGoingBackward = false;
 
@@ -53,5 +81,17 @@ public:
 
 private:
 	float Speed;
+
+	// The owner is moved by UKinematicMoverSubsystem, at Speed from wherever it currently is
+	void MoveOwnerTo(const FVector& Destination);
+	void StopOwner();
+
+	void PreloadDestination(const FVector& Destination) const;
+
+	// The trigger actors publish on UOsuEventBusSubsystem, filtered by source so only their own signals arrive
+	void OnTriggerSignal(const FLogicSignalEvent& Event);
+
+	FDelegateHandle ForwardTriggerHandle;
+	FDelegateHandle BackwardTriggerHandle;
 		
 };
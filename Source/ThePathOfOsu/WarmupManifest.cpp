@@ -0,0 +1,27 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "WarmupManifest.h"
+
+#include "NiagaraSystem.h"
+#include "OsuAssetLoader.h"
+
+void UWarmupManifest::GetAssetPaths(TArray<FSoftObjectPath>& OutPaths) const
+{
+	for (const TSoftObjectPtr<UNiagaraSystem>& NiagaraSystem : NiagaraSystems)
+	{
+		FOsuAssetLoader::AddPath(OutPaths, NiagaraSystem);
+	}
+	for (const TSoftClassPtr<AActor>& EffectActorClass : EffectActorClasses)
+	{
+		FOsuAssetLoader::AddPath(OutPaths, EffectActorClass);
+	}
+	for (const TSoftObjectPtr<USoundBase>& Sound : Sounds)
+	{
+		FOsuAssetLoader::AddPath(OutPaths, Sound);
+	}
+	for (const TSoftObjectPtr<UAnimMontage>& Montage : Montages)
+	{
+		FOsuAssetLoader::AddPath(OutPaths, Montage);
+	}
+}
@@ -0,0 +1,37 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "WarmupManifest.generated.h"
+
+class UNiagaraSystem;
+
+/**
+ * Gameplay assets whose first use would hitch, primed by UOsuWarmupSubsystem while the main menu is shown
+ */
+UCLASS()
+class THEPATHOFOSU_API UWarmupManifest : public UPrimaryDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	// Spawned once out of sight so their scripts and render resources are initialized
+	UPROPERTY(EditAnywhere, Category = "Warmup")
+	TArray<TSoftObjectPtr<UNiagaraSystem>> NiagaraSystems;
+
+	// Effect actors such as the punch hit effect, spawned once out of sight
+	UPROPERTY(EditAnywhere, Category = "Warmup")
+	TArray<TSoftClassPtr<AActor>> EffectActorClasses;
+
+	// Short sound effects, fully decompressed ahead of time. Waves of a sound cue are found through its nodes
+	UPROPERTY(EditAnywhere, Category = "Warmup")
+	TArray<TSoftObjectPtr<USoundBase>> Sounds;
+
+	// Kept loaded so their first play does not load them synchronously
+	UPROPERTY(EditAnywhere, Category = "Warmup")
+	TArray<TSoftObjectPtr<UAnimMontage>> Montages;
+
+	void GetAssetPaths(TArray<FSoftObjectPath>& OutPaths) const;
+};
@@ -4,6 +4,7 @@
 #include "WeaponSystemComponent.h"
 #include "OxCharacter.h"
 #include "PlayerCharacter.h"
+#include "OsuAssetLoader.h"
 
 
 UWeaponSystemComponent::UWeaponSystemComponent()
@@ -25,14 +26,9 @@ void UWeaponSystemComponent::BeginPlay()
 	}
 	Rifle->SetOwner(OwnerCharacter);
 	Pistol->SetOwner(OwnerCharacter);
-	GetWorld()->GetTimerManager().SetTimer(RifleFireTimerHandle, this, &UWeaponSystemComponent::CheckRifleFire,
-	                                       RifleFireRate, true);
-	APlayerCharacter* PlayerCharacter = Cast<APlayerCharacter>(OwnerCharacter);
-	if (PlayerCharacter)
-	{
-		PlayerCharacter->OnPlayerAddItem.AddDynamic(this, &UWeaponSystemComponent::OnPlayerAddItem);
-	}
-	
+	GetWorld()->GetSubsystem<UOsuSchedulerSubsystem>()->SchedulePeriodic(
+		RifleFireJob, TEXT("RifleFire"), RifleFireRate,
+		FSimpleDelegate::CreateUObject(this, &UWeaponSystemComponent::CheckRifleFire));
 	OwnerCharacter->PistolChildActorComponent->SetVisibility(false);
 	OwnerCharacter->RifleChildActorComponent->SetVisibility(false);
 }
@@ -52,8 +48,11 @@ void UWeaponSystemComponent::TryFire()
 		IsRifleFiring = true;
 		break;
 	case EAnimationState::Pistol:
-		Pistol->Shoot();
-		PlayFireMontage();
+		if (OwnerCharacter->TryConsumeStamina(PistolShotStaminaCost))
+		{
+			Pistol->Shoot();
+			PlayFireMontage();
+		}
 		break;
 	default: ;
 	}
@@ -77,10 +76,10 @@ void UWeaponSystemComponent::PlayFireMontage()
 	switch (OwnerCharacter->GetCurrentAnimationState())
 	{
 	case EAnimationState::Rifle:
-		OwnerCharacter->PlayMontage(RifleFireMontage);
+		OwnerCharacter->PlayMontage(FOsuAssetLoader::Get(RifleFireMontage, this));
 		break;
 	case EAnimationState::Pistol:
-		OwnerCharacter->PlayMontage(PistolFireMontage);
+		OwnerCharacter->PlayMontage(FOsuAssetLoader::Get(PistolFireMontage, this));
 		break;
 	default: ;
 	}
@@ -115,6 +114,7 @@ void UWeaponSystemComponent::EquipRifle()
 		}
 	}
 	if (OwnerCharacter->GetCurrentAnimationState() == EAnimationState::Rifle) return;
+	OwnerCharacter->RequestAssetBundle(EOsuAssetBundle::Rifle);
 	if (OwnerCharacter->GetCurrentAnimationState() == EAnimationState::Pistol)
 	{
 		UnequipPistol();
@@ -146,6 +146,7 @@ void UWeaponSystemComponent::EquipPistol()
 		}
 	}
 	if (OwnerCharacter->GetCurrentAnimationState() == EAnimationState::Pistol) return;
+	OwnerCharacter->RequestAssetBundle(EOsuAssetBundle::Pistol);
 	if (OwnerCharacter->GetCurrentAnimationState() == EAnimationState::Rifle)
 	{
 		UnequipRifle();
@@ -170,7 +171,8 @@ void UWeaponSystemComponent::UnequipPistol()
 
 void UWeaponSystemComponent::CheckRifleFire()
 {
-	if (IsRifleFiring && OwnerCharacter->GetCurrentAnimationState() == EAnimationState::Rifle)
+	if (IsRifleFiring && OwnerCharacter->GetCurrentAnimationState() == EAnimationState::Rifle
+		&& OwnerCharacter->TryConsumeStamina(RifleShotStaminaCost))
 	{
 		Rifle->Shoot();
 		PlayFireMontage();
@@ -197,16 +199,38 @@ void UWeaponSystemComponent::EndSprint()
 	}
 }
 
-void UWeaponSystemComponent::OnPlayerAddItem(UItem* Item)
+void UWeaponSystemComponent::AcquireRifle()
 {
-	if (Item->ItemName.EqualTo(FText::FromString("Rifle")))
+	EquipRifle();
+	if (Rifle)
 	{
-		EquipRifle();
 		Rifle->PlayPickUpSound();
 	}
-	
-	if (Item->ItemName.EqualTo(FText::FromString("Pistol")))
+}
+
+void UWeaponSystemComponent::AcquirePistol()
+{
+	EquipPistol();
+}
+
+void UWeaponSystemComponent::GetAssetBundlePaths(EOsuAssetBundle Bundle, TArray<FSoftObjectPath>& OutPaths) const
+{
+	switch (Bundle)
 	{
-		EquipPistol();
+	case EOsuAssetBundle::Rifle:
+		FOsuAssetLoader::AddPath(OutPaths, RifleFireMontage);
+		if (Rifle)
+		{
+			Rifle->AddAssetBundlePaths(OutPaths);
+		}
+		break;
+	case EOsuAssetBundle::Pistol:
+		FOsuAssetLoader::AddPath(OutPaths, PistolFireMontage);
+		if (Pistol)
+		{
+			Pistol->AddAssetBundlePaths(OutPaths);
+		}
+		break;
+	default: ;
 	}
 }
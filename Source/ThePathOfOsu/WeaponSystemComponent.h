@@ -3,9 +3,10 @@
 #pragma once
 
 #include "CoreMinimal.h"
-#include "Item.h"
 #include "Pistol.h"
 #include "Rifle.h"
+#include "OsuSchedulerSubsystem.h"
+#include "OsuType.h"
 #include "Components/ActorComponent.h"
 #include "WeaponSystemComponent.generated.h"
 
@@ -23,10 +24,10 @@ protected:
 	virtual void BeginPlay() override;
 
 	UPROPERTY(EditDefaultsOnly, Category = "Animation")
-	UAnimMontage* PistolFireMontage;
+	TSoftObjectPtr<UAnimMontage> PistolFireMontage;
 	
 	UPROPERTY(EditDefaultsOnly, Category = "Animation")
-	UAnimMontage* RifleFireMontage;
+	TSoftObjectPtr<UAnimMontage> RifleFireMontage;
 	
 public:
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType,
@@ -55,8 +56,12 @@ public:
 	void StartSprint();
 	void EndSprint();
 
-	UFUNCTION()
-	void OnPlayerAddItem(UItem* Item);
+	// Called by the inventory when a weapon item is first picked up
+	void AcquireRifle();
+	void AcquirePistol();
+
+	// Fire montage of the owner plus the effects of the gun
+	void GetAssetBundlePaths(EOsuAssetBundle Bundle, TArray<FSoftObjectPath>& OutPaths) const;
 	
 private:
 	AOxCharacter* OwnerCharacter;
@@ -79,11 +84,18 @@ private:
 	APistol* Pistol;
 	ARifle* Rifle;
 
-	FTimerHandle RifleFireTimerHandle;
+	FOsuJobHandle RifleFireJob;
 	void CheckRifleFire();
 
 	bool IsRifleFiring = false;
 
 	UPROPERTY(EditAnywhere)
 	float RifleFireRate = 0.1f;
+
+	// Spent per shot, a shot is skipped when the owner cannot pay it
+	UPROPERTY(EditAnywhere, Category = "Stamina")
+	float PistolShotStaminaCost = 5.0f;
+	// Spent every RifleFireRate, kept under the owner's stamina regen so holding the trigger never runs dry
+	UPROPERTY(EditAnywhere, Category = "Stamina")
+	float RifleShotStaminaCost = 0.5f;
 };